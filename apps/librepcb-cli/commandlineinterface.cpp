@@ -56,8 +56,10 @@
 #include <librepcb/core/project/projectattributelookup.h>
 #include <librepcb/core/project/projectloader.h>
 #include <librepcb/core/project/schematic/schematicpainter.h>
+#include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/utils/toolbox.h>
 
+#include <QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -127,6 +129,12 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
          "settings. If not set, the settings from the boards will be used "
          "instead."),
       tr("file"));
+  QCommandLineOption drcJobsOption(
+      "drc-jobs",
+      tr("Number of threads to use for the design rule check. The checks of "
+         "all selected boards run in parallel and share these threads. "
+         "Defaults to 0, which uses one thread per CPU core."),
+      tr("count"));
   QCommandLineOption runSpecificJobOption(
       "run-job",
       tr("Run a particular output job. Can be given multiple times to run "
@@ -250,6 +258,13 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
       "check",
       tr("Run the library element check, print all non-approved messages and "
          "report failure (exit code = 1) if there are non-approved messages."));
+  QCommandLineOption libJobsOption(
+      "jobs",
+      tr("Number of library elements to process in parallel with '%1'. "
+         "Defaults to 1, pass 0 to use one job per CPU core. The console "
+         "output is the same for any number of jobs.")
+          .arg("--all"),
+      tr("count"));
   QCommandLineOption libMinifyStepOption(
       "minify-step",
       tr("Minify the STEP models of all packages. Only works in conjunction "
@@ -309,6 +324,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     parser.addOption(ercOption);
     parser.addOption(drcOption);
     parser.addOption(drcSettingsOption);
+    parser.addOption(drcJobsOption);
     parser.addOption(runSpecificJobOption);
     parser.addOption(runAllJobsOption);
     parser.addOption(customJobsOption);
@@ -338,6 +354,7 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
     positionalArgNames.append("library");
     parser.addOption(libAllOption);
     parser.addOption(libCheckOption);
+    parser.addOption(libJobsOption);
     parser.addOption(libMinifyStepOption);
     parser.addOption(libSaveOption);
     parser.addOption(libStrictOption);
@@ -423,41 +440,69 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
   // Execute command
   bool cmdSuccess = false;
   if (command == "open-project") {
-    cmdSuccess = openProject(
-        positionalArgs.value(1),  // project filepath
-        parser.isSet(ercOption),  // run ERC
-        parser.isSet(drcOption),  // run DRC
-        parser.value(drcSettingsOption),  // DRC settings
-        parser.values(runSpecificJobOption),  // run specific output jobs
-        parser.isSet(runAllJobsOption),  // run all output jobs
-        parser.value(customJobsOption).trimmed(),  // custom jobs file path
-        parser.value(customOutDirOption).trimmed(),  // custom jobs outdir
-        parser.values(exportSchematicsOption),  // export schematics
-        parser.values(exportBomOption),  // export generic BOM
-        parser.values(exportBoardBomOption),  // export board BOM
-        parser.value(bomAttributesOption),  // BOM attributes
-        parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
-        parser.value(pcbFabricationSettingsOption),  // PCB fab. settings
-        parser.values(exportPnpTopOption),  // export PnP top
-        parser.values(exportPnpBottomOption),  // export PnP bottom
-        parser.values(exportNetlistOption),  // export netlist
-        parser.values(boardOption),  // board names
-        parser.values(boardIndexOption),  // board indices
-        parser.isSet(removeOtherBoardsOption),  // remove other boards
-        parser.values(assemblyVariantOption),  // assembly variant names
-        parser.values(assemblyVariantIndexOption),  // assembly variant indices
-        parser.value(setDefaultAssemblyVariantOption),  // set default AV
-        parser.isSet(saveOption),  // save project
-        parser.isSet(prjStrictOption)  // strict mode
-    );
+    bool drcJobsValid = true;
+    int drcJobs = 0;
+    if (parser.isSet(drcJobsOption)) {
+      drcJobs = parser.value(drcJobsOption).toInt(&drcJobsValid);
+    }
+    if ((!drcJobsValid) || (drcJobs < 0)) {
+      printErr(tr("Invalid number of jobs: '%1'")
+                   .arg(parser.value(drcJobsOption)));
+    } else {
+      if (drcJobs == 0) {
+        drcJobs = std::max(QThread::idealThreadCount(), 1);
+      }
+      cmdSuccess = openProject(
+          positionalArgs.value(1),  // project filepath
+          parser.isSet(ercOption),  // run ERC
+          parser.isSet(drcOption),  // run DRC
+          parser.value(drcSettingsOption),  // DRC settings
+          drcJobs,  // number of DRC threads
+          parser.values(runSpecificJobOption),  // run specific output jobs
+          parser.isSet(runAllJobsOption),  // run all output jobs
+          parser.value(customJobsOption).trimmed(),  // custom jobs file path
+          parser.value(customOutDirOption).trimmed(),  // custom jobs outdir
+          parser.values(exportSchematicsOption),  // export schematics
+          parser.values(exportBomOption),  // export generic BOM
+          parser.values(exportBoardBomOption),  // export board BOM
+          parser.value(bomAttributesOption),  // BOM attributes
+          parser.isSet(exportPcbFabricationDataOption),  // export fab. data
+          parser.value(pcbFabricationSettingsOption),  // PCB fab. settings
+          parser.values(exportPnpTopOption),  // export PnP top
+          parser.values(exportPnpBottomOption),  // export PnP bottom
+          parser.values(exportNetlistOption),  // export netlist
+          parser.values(boardOption),  // board names
+          parser.values(boardIndexOption),  // board indices
+          parser.isSet(removeOtherBoardsOption),  // remove other boards
+          parser.values(assemblyVariantOption),  // assembly variant names
+          parser.values(assemblyVariantIndexOption),  // assembly variant idx
+          parser.value(setDefaultAssemblyVariantOption),  // set default AV
+          parser.isSet(saveOption),  // save project
+          parser.isSet(prjStrictOption)  // strict mode
+      );
+    }
   } else if (command == "open-library") {
-    cmdSuccess = openLibrary(positionalArgs.value(1),  // library directory
-                             parser.isSet(libAllOption),  // all elements
-                             parser.isSet(libCheckOption),  // run check
-                             parser.isSet(libMinifyStepOption),  // minify STEP
-                             parser.isSet(libSaveOption),  // save
-                             parser.isSet(libStrictOption)  // strict mode
-    );
+    bool jobsValid = true;
+    int jobs = 1;
+    if (parser.isSet(libJobsOption)) {
+      jobs = parser.value(libJobsOption).toInt(&jobsValid);
+    }
+    if ((!jobsValid) || (jobs < 0)) {
+      printErr(tr("Invalid number of jobs: '%1'")
+                   .arg(parser.value(libJobsOption)));
+    } else {
+      if (jobs == 0) {
+        jobs = std::max(QThread::idealThreadCount(), 1);
+      }
+      cmdSuccess = openLibrary(positionalArgs.value(1),  // library directory
+                               parser.isSet(libAllOption),  // all elements
+                               parser.isSet(libCheckOption),  // run check
+                               parser.isSet(libMinifyStepOption),  // minify
+                               parser.isSet(libSaveOption),  // save
+                               parser.isSet(libStrictOption),  // strict mode
+                               jobs  // number of parallel jobs
+      );
+    }
   } else if (command == "open-step") {
     cmdSuccess = openStep(positionalArgs.value(1),  // STEP file path
                           parser.isSet(stepMinifyOption),  // minify
@@ -482,8 +527,8 @@ int CommandLineInterface::execute(const QStringList& args) noexcept {
 
 bool CommandLineInterface::openProject(
     const QString& projectFile, bool runErc, bool runDrc,
-    const QString& drcSettingsPath, const QStringList& runJobs, bool runAllJobs,
-    const QString& customJobsPath, const QString& customOutDir,
+    const QString& drcSettingsPath, int drcJobs, const QStringList& runJobs,
+    bool runAllJobs, const QString& customJobsPath, const QString& customOutDir,
     const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
     const QStringList& exportBoardBomFiles, const QString& bomAttributes,
     bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
@@ -634,14 +679,35 @@ bool CommandLineInterface::openProject(
       boards = project->getBoards();
     }
 
-    // Build planes, if needed.
+    // Limit the threads used by the plane rebuilds and the DRC of all boards.
+    // The limit is also reverted if leaving this scope early.
+    const int defaultThreadCount =
+        QThreadPool::globalInstance()->maxThreadCount();
+    auto restoreThreadCount = [defaultThreadCount]() {
+      QThreadPool::globalInstance()->setMaxThreadCount(defaultThreadCount);
+    };
+    auto threadCountGuard = scopeGuard(restoreThreadCount);
+    if (runDrc) {
+      QThreadPool::globalInstance()->setMaxThreadCount(drcJobs);
+    }
+
+    // Build planes, if needed. The boards are independent of each other, so
+    // all of them are built in parallel.
     if (runDrc || exportPcbFabricationData || (!runJobs.isEmpty()) ||
         runAllJobs) {
+      std::vector<std::unique_ptr<BoardPlaneFragmentsBuilder>> builders;
       foreach (Board* board, boards) {
         qInfo().nospace().noquote() << "Rebuilding all planes of board '"
                                     << *board->getName() << "'...";
-        BoardPlaneFragmentsBuilder builder;
-        builder.runAndApply(*board);  // can throw
+        auto builder = std::make_unique<BoardPlaneFragmentsBuilder>();
+        if (builder->start(*board)) {
+          builders.push_back(std::move(builder));
+        }
+      }
+      for (auto& builder : builders) {
+        BoardPlaneFragmentsBuilder::Result result = builder->waitForFinished();
+        result.throwOnError();  // can throw
+        result.applyToBoard();
       }
     } else {
       qInfo() << "No need to rebuild planes, thus skipped.";
@@ -676,9 +742,10 @@ bool CommandLineInterface::openProject(
     // ERC
     if (runErc) {
       print(tr("Run ERC..."));
-      ElectricalRuleCheck erc(*project);
+      ElectricalRuleCheck erc;
+      erc.start(*project);
       int approvedMsgCount = 0;
-      const RuleCheckMessageList messages = erc.runChecks();
+      const RuleCheckMessageList messages = erc.waitForFinished();
       const QStringList nonApproved = prepareRuleCheckMessages(
           messages, project->getErcMessageApprovals(), approvedMsgCount);
       print("  " % tr("Approved messages: %1").arg(approvedMsgCount));
@@ -708,13 +775,34 @@ bool CommandLineInterface::openProject(
           boardsToCheck.clear();  // avoid exporting any boards
         }
       }
-      foreach (Board* board, boardsToCheck) {
+      // Start the checks of all boards at once, they share the thread pool.
+      std::vector<std::unique_ptr<BoardDesignRuleCheck>> checks;
+      QVector<QElapsedTimer> timers(boardsToCheck.count());
+      QVector<qint64> durations(boardsToCheck.count(), 0);
+      for (int i = 0; i < boardsToCheck.count(); ++i) {
+        Board* board = boardsToCheck.at(i);
+        auto drc = std::make_unique<BoardDesignRuleCheck>();
+        QObject::connect(
+            drc.get(), &BoardDesignRuleCheck::finished, drc.get(),
+            [&timers, &durations, i]() {
+              durations[i] = timers.at(i).elapsed();
+            },
+            Qt::DirectConnection);
+        timers[i].start();
+        drc->start(*board,
+                   customSettings ? *customSettings : board->getDrcSettings(),
+                   false);
+        checks.push_back(std::move(drc));
+      }
+      // Print the results in board order.
+      for (int i = 0; i < boardsToCheck.count(); ++i) {
+        Board* board = boardsToCheck.at(i);
         print("  " % tr("Board '%1':").arg(*board->getName()));
-        BoardDesignRuleCheck drc;
-        drc.start(*board,
-                  customSettings ? *customSettings : board->getDrcSettings(),
-                  false);
-        const BoardDesignRuleCheck::Result result = drc.waitForFinished();
+        const BoardDesignRuleCheck::Result result =
+            checks.at(i)->waitForFinished();
+        qDebug().nospace().noquote()
+            << "DRC of board '" << *board->getName() << "' took "
+            << durations.at(i) << " ms.";
         for (const QString& msg : result.errors) {
           printErr("FATAL ERROR: " % msg);
           success = false;
@@ -731,6 +819,8 @@ bool CommandLineInterface::openProject(
         }
       }
     }
+    restoreThreadCount();
+    threadCountGuard.dismiss();
 
     // Run output jobs.
     if ((!runJobs.isEmpty()) || runAllJobs) {
@@ -1054,7 +1144,8 @@ bool CommandLineInterface::openProject(
 
 bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
                                        bool runCheck, bool minifyStepFiles,
-                                       bool save, bool strict) const noexcept {
+                                       bool save, bool strict,
+                                       int jobs) const noexcept {
   try {
     bool success = true;
 
@@ -1062,32 +1153,31 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
     FilePath libFp(QFileInfo(libDir).absoluteFilePath());
     print(tr("Open library '%1'...").arg(prettyPath(libFp, libDir)));
 
+    // Check only once whether saving is allowed, not for every element.
+    if (save && failIfFileFormatUnstable()) {
+      save = false;
+      success = false;
+    }
+
     std::shared_ptr<TransactionalFileSystem> libFs =
         TransactionalFileSystem::open(libFp, save);  // can throw
     std::unique_ptr<Library> lib =
         Library::open(std::unique_ptr<TransactionalDirectory>(
             new TransactionalDirectory(libFs)));  // can throw
+    ElementOutput libOut;
     processLibraryElement(libDir, *libFs, *lib, runCheck, minifyStepFiles, save,
-                          strict,
-                          success);  // can throw
+                          strict, libOut);  // can throw
+    libOut.flush();
+    success = success && libOut.success;
 
     // Open all component categories
     if (all) {
       QStringList elements = lib->searchForElements<ComponentCategory>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 component categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<ComponentCategory> element =
-            ComponentCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<ComponentCategory>(
+          libDir, libFp, elements, runCheck, minifyStepFiles, save, strict,
+          jobs, success);  // can throw
     }
 
     // Open all package categories
@@ -1095,18 +1185,9 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
       QStringList elements = lib->searchForElements<PackageCategory>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 package categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<PackageCategory> element =
-            PackageCategory::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<PackageCategory>(
+          libDir, libFp, elements, runCheck, minifyStepFiles, save, strict,
+          jobs, success);  // can throw
     }
 
     // Open all symbols
@@ -1114,18 +1195,9 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
       QStringList elements = lib->searchForElements<Symbol>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 symbols...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Symbol> element =
-            Symbol::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<Symbol>(libDir, libFp, elements, runCheck,
+                                     minifyStepFiles, save, strict, jobs,
+                                     success);  // can throw
     }
 
     // Open all packages
@@ -1133,18 +1205,9 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
       QStringList elements = lib->searchForElements<Package>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 packages...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Package> element =
-            Package::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<Package>(libDir, libFp, elements, runCheck,
+                                      minifyStepFiles, save, strict, jobs,
+                                      success);  // can throw
     }
 
     // Open all components
@@ -1152,18 +1215,9 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
       QStringList elements = lib->searchForElements<Component>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 components...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Component> element =
-            Component::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<Component>(libDir, libFp, elements, runCheck,
+                                        minifyStepFiles, save, strict, jobs,
+                                        success);  // can throw
     }
 
     // Open all devices
@@ -1171,18 +1225,9 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
       QStringList elements = lib->searchForElements<Device>();
       elements.sort();  // For deterministic console output.
       print(tr("Process %1 devices...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo().noquote() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        std::unique_ptr<Device> element =
-            Device::open(std::unique_ptr<TransactionalDirectory>(
-                new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
-                              save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<Device>(libDir, libFp, elements, runCheck,
+                                     minifyStepFiles, save, strict, jobs,
+                                     success);  // can throw
     }
 
     return success;
@@ -1192,18 +1237,56 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
   }
 }
 
+template <typename ElementType>
+void CommandLineInterface::processLibraryElements(
+    const QString& libDir, const FilePath& libFp, const QStringList& elements,
+    bool runCheck, bool minifyStepFiles, bool save, bool strict, int jobs,
+    bool& success) const {
+  // Process the elements on a dedicated thread pool, but print the output
+  // strictly in the order of the passed elements to keep it deterministic.
+  QThreadPool pool;
+  pool.setMaxThreadCount(jobs);
+  QVector<QFuture<ElementOutput>> futures;
+  futures.reserve(elements.count());
+  foreach (const QString& dir, elements) {
+    futures.append(QtConcurrent::run(&pool, [=, this]() {
+      ElementOutput out;
+      const FilePath fp = libFp.getPathTo(dir);
+      out.info(tr("Open '%1'...").arg(prettyPath(fp, libDir)));
+      std::shared_ptr<TransactionalFileSystem> fs =
+          TransactionalFileSystem::open(fp, save);  // can throw
+      std::unique_ptr<ElementType> element =
+          ElementType::open(std::unique_ptr<TransactionalDirectory>(
+              new TransactionalDirectory(fs)));  // can throw
+      processLibraryElement(libDir, *fs, *element, runCheck, minifyStepFiles,
+                            save, strict, out);  // can throw
+      return out;
+    }));
+  }
+  try {
+    for (const QFuture<ElementOutput>& future : futures) {
+      const ElementOutput out = future.result();  // can throw
+      out.flush();
+      success = success && out.success;
+    }
+  } catch (...) {
+    pool.clear();  // Abort as early as possible, like in sequential mode.
+    throw;
+  }
+}
+
 void CommandLineInterface::processLibraryElement(
     const QString& libDir, TransactionalFileSystem& fs,
     LibraryBaseElement& element, bool runCheck, bool minifyStepFiles, bool save,
-    bool strict, bool& success) const {
+    bool strict, ElementOutput& out) const {
   // Helper function to print an error header to console only once, if
   // there is at least one error.
   bool errorHeaderPrinted = false;
-  auto printErrorHeaderOnce = [&errorHeaderPrinted, &element]() {
+  auto printErrorHeaderOnce = [&errorHeaderPrinted, &element, &out]() {
     if (!errorHeaderPrinted) {
-      printErr(QString("  - %1 (%2):")
-                   .arg(*element.getNames().getDefaultValue(),
-                        element.getUuid().toStr()));
+      out.printErr(QString("  - %1 (%2):")
+                       .arg(*element.getNames().getDefaultValue(),
+                            element.getUuid().toStr()));
       errorHeaderPrinted = true;
     }
   };
@@ -1218,24 +1301,24 @@ void CommandLineInterface::processLibraryElement(
     foreach (const QString& file, fs.getFiles()) {
       if (file.endsWith(".step")) {
         const QString fp = prettyPath(fs.getAbsPath(file), libDir);
-        qInfo().noquote() << tr("Minify STEP model '%1'...").arg(fp);
+        out.info(tr("Minify STEP model '%1'...").arg(fp));
         try {
           const QByteArray content = fs.read(file);  // can throw
           const QByteArray minified =
               OccModel::minifyStep(content);  // can throw
           if (minified != content) {
-            print(tr("  - Minified '%1' from %2 to %3 bytes")
-                      .arg(fp)
-                      .arg(content.size())
-                      .arg(minified.size()));
+            out.print(tr("  - Minified '%1' from %2 to %3 bytes")
+                          .arg(fp)
+                          .arg(content.size())
+                          .arg(minified.size()));
             OccModel::loadStep(minified);  // throws if STEP is invalid
             fs.write(file, minified);
           }
         } catch (const Exception& e) {
           printErrorHeaderOnce();
-          printErr(QString("    - Failed to minify STEP model '%1': %2")
-                       .arg(fp, e.getMsg()));
-          success = false;
+          out.printErr(QString("    - Failed to minify STEP model '%1': %2")
+                           .arg(fp, e.getMsg()));
+          out.success = false;
         }
       }
     }
@@ -1243,8 +1326,8 @@ void CommandLineInterface::processLibraryElement(
 
   // Check for non-canonical files (strict mode)
   if (strict) {
-    qInfo().noquote() << tr("Check '%1' for non-canonical files...")
-                             .arg(prettyPath(fs.getPath(), libDir));
+    out.info(tr("Check '%1' for non-canonical files...")
+                 .arg(prettyPath(fs.getPath(), libDir)));
 
     QStringList paths = fs.checkForModifications();  // can throw
     if (!paths.isEmpty()) {
@@ -1252,41 +1335,34 @@ void CommandLineInterface::processLibraryElement(
       std::sort(paths.begin(), paths.end());
       printErrorHeaderOnce();
       foreach (const QString& path, paths) {
-        printErr(QString("    - Non-canonical file: '%1'")
-                     .arg(prettyPath(fs.getAbsPath(path), libDir)));
+        out.printErr(QString("    - Non-canonical file: '%1'")
+                         .arg(prettyPath(fs.getAbsPath(path), libDir)));
       }
-      success = false;
+      out.success = false;
     }
   }
 
   // Run library element check, if needed.
   if (runCheck) {
-    qInfo().noquote() << tr("Check '%1' for non-approved messages...")
-                             .arg(prettyPath(fs.getPath(), libDir));
+    out.info(tr("Check '%1' for non-approved messages...")
+                 .arg(prettyPath(fs.getPath(), libDir)));
     int approvedMsgCount = 0;
     const RuleCheckMessageList messages = element.runChecks();
     const QStringList nonApproved = prepareRuleCheckMessages(
         messages, element.getMessageApprovals(), approvedMsgCount);
-    qInfo().noquote() << "  " %
-            tr("Approved messages: %1").arg(approvedMsgCount);
-    qInfo().noquote() << "  " %
-            tr("Non-approved messages: %1").arg(nonApproved.count());
+    out.info("  " % tr("Approved messages: %1").arg(approvedMsgCount));
+    out.info("  " % tr("Non-approved messages: %1").arg(nonApproved.count()));
     foreach (const QString& msg, nonApproved) {
       printErrorHeaderOnce();
-      printErr("    - " % msg);
-      success = false;
+      out.printErr("    - " % msg);
+      out.success = false;
     }
   }
 
   // Save element to file system, if needed
   if (save) {
-    qInfo().noquote()
-        << tr("Save '%1'...").arg(prettyPath(fs.getPath(), libDir));
-    if (failIfFileFormatUnstable()) {
-      success = false;
-    } else {
-      fs.save();  // can throw
-    }
+    out.info(tr("Save '%1'...").arg(prettyPath(fs.getPath(), libDir)));
+    fs.save();  // can throw
   }
 
   // Do not propagate changes in the transactional file system to the
@@ -1388,8 +1464,10 @@ QStringList CommandLineInterface::prepareRuleCheckMessages(
       Qt::CaseInsensitive, false);
   approvedMsgCount = 0;
   QStringList printedMessages;
+  const QSet<RuleCheckMessage::ApprovalKey> approvalKeys =
+      RuleCheckMessage::calcApprovalKeys(approvals);
   foreach (const auto& msg, messages) {
-    if (approvals.contains(msg->getApproval())) {
+    if (approvalKeys.contains(msg->getApprovalKey())) {
       ++approvedMsgCount;
     } else {
       printedMessages.append(QString("[%1] %2").arg(
@@ -1429,6 +1507,22 @@ bool CommandLineInterface::failIfFileFormatUnstable() noexcept {
   }
 }
 
+void CommandLineInterface::ElementOutput::flush() const noexcept {
+  for (const auto& line : lines) {
+    switch (line.first) {
+      case Stream::Info:
+        qInfo().noquote() << line.second;
+        break;
+      case Stream::Out:
+        CommandLineInterface::print(line.second);
+        break;
+      case Stream::Err:
+        CommandLineInterface::printErr(line.second);
+        break;
+    }
+  }
+}
+
 void CommandLineInterface::print(const QString& str) noexcept {
   QTextStream s(stdout);
   s << str << '\n';
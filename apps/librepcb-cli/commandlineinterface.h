@@ -57,10 +57,34 @@ public:
   // General Methods
   int execute(const QStringList& args) noexcept;
 
+private:  // Types
+  /**
+   * @brief Buffered console output of a processed library element
+   *
+   * Library elements may be processed in parallel, thus their output is
+   * collected and printed afterwards in the order of the elements.
+   */
+  struct ElementOutput {
+    enum class Stream { Info, Out, Err };
+    QVector<std::pair<Stream, QString>> lines;
+    bool success = true;
+
+    void info(const QString& str) noexcept {
+      lines.append(std::make_pair(Stream::Info, str));
+    }
+    void print(const QString& str) noexcept {
+      lines.append(std::make_pair(Stream::Out, str));
+    }
+    void printErr(const QString& str) noexcept {
+      lines.append(std::make_pair(Stream::Err, str));
+    }
+    void flush() const noexcept;
+  };
+
 private:  // Methods
   bool openProject(
       const QString& projectFile, bool runErc, bool runDrc,
-      const QString& drcSettingsPath, const QStringList& runJobs,
+      const QString& drcSettingsPath, int drcJobs, const QStringList& runJobs,
       bool runAllJobs, const QString& customJobsPath,
       const QString& customOutDir, const QStringList& exportSchematicsFiles,
       const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
@@ -73,11 +97,17 @@ private:  // Methods
       const QStringList& avNames, const QStringList& avIndices,
       const QString& setDefaultAv, bool save, bool strict) const noexcept;
   bool openLibrary(const QString& libDir, bool all, bool runCheck,
-                   bool minifyStepFiles, bool save, bool strict) const noexcept;
+                   bool minifyStepFiles, bool save, bool strict,
+                   int jobs) const noexcept;
+  template <typename ElementType>
+  void processLibraryElements(const QString& libDir, const FilePath& libFp,
+                              const QStringList& elements, bool runCheck,
+                              bool minifyStepFiles, bool save, bool strict,
+                              int jobs, bool& success) const;
   void processLibraryElement(const QString& libDir, TransactionalFileSystem& fs,
                              LibraryBaseElement& element, bool runCheck,
                              bool minifyStepFiles, bool save, bool strict,
-                             bool& success) const;
+                             ElementOutput& out) const;
   bool openStep(const QString& filePath, bool minify, bool tesselate,
                 const QString& saveTo) const noexcept;
   static QStringList prepareRuleCheckMessages(
@@ -25,10 +25,16 @@
 #include "../exceptions.h"
 #include "../fileio/filepath.h"
 #include "../fileio/fileutils.h"
+#include "../utils/scopeguard.h"
 #include "../utils/toolbox.h"
 #include "../utils/transform.h"
 #include "librepcb_build_env.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
 // clang-format off
 #if USE_OPENCASCADE
 #include <APIHeaderSection_MakeHeader.hxx>
@@ -78,6 +84,11 @@ namespace librepcb {
 
 bool OccModel::sOutputVerbosityConfigured = false;
 
+// Tesselation parameters. When modifying them, make sure to keep
+// OccModel::getTesselationId() up to date!
+static const qreal sTesselationDeflection = 0.01;
+static const qreal sTesselationDeflectionAngleDeg = 20;
+
 /*******************************************************************************
  *  Data
  ******************************************************************************/
@@ -86,6 +97,10 @@ struct OccModel::Data {
 #if USE_OPENCASCADE
   Handle(TDocStd_Document) doc;
   TDF_Label assemblyLabel;
+
+  /// Models already added to this assembly, with the label of their shape.
+  /// Used to share the shape between all instances of the same model.
+  QVector<std::pair<Handle(TDocStd_Document), TDF_Label>> addedModels = {};
 #else
   int dummy;
 #endif
@@ -97,6 +112,47 @@ struct OccModel::Data {
 
 #if USE_OPENCASCADE
 
+/**
+ * @brief Get the mutex protecting the OpenCascade application
+ *
+ * The OpenCascade application is a global singleton which keeps track of all
+ * its documents in a non-thread-safe way, but models are loaded and released
+ * from multiple threads concurrently. Thus every document creation and
+ * closing has to be done with this mutex locked.
+ */
+static QMutex& getApplicationMutex() noexcept {
+  static QMutex mutex;
+  return mutex;
+}
+
+/**
+ * @brief Create a new XCAF document
+ *
+ * Must be closed with #closeDocument() when no longer needed.
+ */
+static Handle(TDocStd_Document) newDocument() {
+  QMutexLocker lock(&getApplicationMutex());
+  Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
+  Handle(TDocStd_Document) doc;
+  app->NewDocument("MDTV-XCAF", doc);
+  return doc;
+}
+
+/**
+ * @brief Close a document created with #newDocument()
+ */
+static void closeDocument(const Handle(TDocStd_Document) & doc) noexcept {
+  QMutexLocker lock(&getApplicationMutex());
+  try {
+    if ((!doc.IsNull()) && doc->IsOpened()) {
+      doc->Close();
+    }
+  } catch (const Standard_Failure& e) {
+    qWarning() << "Failed to close OpenCascade document:"
+               << e.GetMessageString();
+  }
+}
+
 static bool tryGetColor(Handle(XCAFDoc_ColorTool) colorTool,
                         const TopoDS_Shape& shape, Quantity_Color& color) {
   return colorTool->GetColor(shape, XCAFDoc_ColorSurf, color) ||
@@ -117,8 +173,9 @@ static bool tesselateFace(Handle(XCAFDoc_ColorTool) colorTool,
                           QMap<OccModel::Color, QVector<QVector3D>>& result) {
   if (face.IsNull()) return false;
 
-  const Standard_Real deflectionAngle = 20. * 3.141 / 180.;
-  const Standard_Real deflection = 0.01;
+  const Standard_Real deflectionAngle =
+      sTesselationDeflectionAngleDeg * 3.141 / 180.;
+  const Standard_Real deflection = sTesselationDeflection;
 
   TopLoc_Location loc;
   Handle(Poly_Triangulation) triangulation =
@@ -297,6 +354,50 @@ static TopoDS_Face pathToFace(const Path& path, const Length& z) {
 
 #endif
 
+/**
+ * @brief Key for the duplicate elimination of STEP data entities
+ *
+ * Refers to the normalized text of an entity (with reference numbers
+ * removed) and to its references, already mapped to the class of identical
+ * entities they point to. Unique entities (which must never be merged) get
+ * their index assigned, mergeable entities get -1.
+ */
+struct StepEntityKey {
+  std::string_view text;
+  const qint64* refs;
+  int refCount;
+  int unique;
+
+  bool operator==(const StepEntityKey& rhs) const noexcept {
+    return (text == rhs.text) && (refCount == rhs.refCount) &&
+        (unique == rhs.unique) &&
+        std::equal(refs, refs + refCount, rhs.refs);
+  }
+  friend size_t qHash(const StepEntityKey& key, size_t seed = 0) noexcept {
+    seed = qHashBits(key.text.data(), key.text.size(), seed);
+    seed = qHashBits(key.refs, key.refCount * sizeof(qint64), seed);
+    return qHashMulti(seed, key.unique);
+  }
+};
+
+static bool isStepWhitespace(char c) noexcept {
+  return (c == ' ') || (c == '\t') || (c == '\n') || (c == '\v') ||
+      (c == '\f') || (c == '\r');
+}
+
+static bool isStepDigit(char c) noexcept {
+  return (c >= '0') && (c <= '9');
+}
+
+static void trimStepRange(const char*& begin, const char*& end) noexcept {
+  while ((begin < end) && isStepWhitespace(*begin)) {
+    ++begin;
+  }
+  while ((end > begin) && isStepWhitespace(*(end - 1))) {
+    --end;
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -306,6 +407,9 @@ OccModel::OccModel(std::unique_ptr<Data> data) : mImpl(std::move(data)) {
 }
 
 OccModel::~OccModel() noexcept {
+#if USE_OPENCASCADE
+  closeDocument(mImpl->doc);
+#endif
 }
 
 /*******************************************************************************
@@ -328,67 +432,82 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
     TopExp_Explorer assemblyExplorer;
     TopExp_Explorer modelExplorer;
 
-    TDF_Label newLabel = assemblyShapeTool->NewShape();
+    // Copy the model shapes only once and share them between all instances
+    // of the same model, which keeps the assembly (and the STEP file) small.
     TCollection_ExtendedString newName(cleanString(name).toStdString().c_str());
-    TDataStd_Name::Set(newLabel, newName);
-
-    TDF_LabelSequence modelShapes;
-    modelShapeTool->GetFreeShapes(modelShapes);
-    for (int i = 1; i <= modelShapes.Length(); ++i) {
-      TopoDS_Shape shape = modelShapeTool->GetShape(modelShapes.Value(i));
-      if (shape.IsNull()) continue;
-      TDF_Label shapeLabel = assemblyShapeTool->AddShape(shape, Standard_False);
-      const QString shapeName = QString("%1:%2").arg(cleanString(name)).arg(i);
-      TDataStd_Name::Set(shapeLabel, shapeName.toStdString().c_str());
-      // ATTENTION: Until LibrePCB 1.1.0 we passed shape.Location() instead of
-      // TopLoc_Location(), but this caused wrong placement in rare cases.
-      // Although TopLoc_Location() sounds wrong(?), it fixes the issue without
-      // observing any negative consequences so far. If any issues are observed
-      // in future, we might have to reconsider this change.
-      // See details in https://github.com/LibrePCB/LibrePCB/issues/1387.
-      TDF_Label cmpLabel = assemblyShapeTool->AddComponent(newLabel, shapeLabel,
-                                                           TopLoc_Location());
-
-      // Copy face colors.
-      modelExplorer.Init(shape, TopAbs_FACE);
-      assemblyExplorer.Init(assemblyShapeTool->GetShape(cmpLabel), TopAbs_FACE);
-      while (modelExplorer.More() && assemblyExplorer.More()) {
-        Quantity_Color color;
-        TDF_Label label;
-        if (modelShapeTool->FindShape(modelExplorer.Current(), label)) {
-          if (tryGetColor(assemblyColorTool, label, color)) {
+    TDF_Label newLabel;
+    for (const auto& pair : mImpl->addedModels) {
+      if (pair.first == model.mImpl->doc) {
+        newLabel = pair.second;
+        break;
+      }
+    }
+    if (newLabel.IsNull()) {
+      newLabel = assemblyShapeTool->NewShape();
+      TDataStd_Name::Set(newLabel, newName);
+
+      TDF_LabelSequence modelShapes;
+      modelShapeTool->GetFreeShapes(modelShapes);
+      for (int i = 1; i <= modelShapes.Length(); ++i) {
+        TopoDS_Shape shape = modelShapeTool->GetShape(modelShapes.Value(i));
+        if (shape.IsNull()) continue;
+        TDF_Label shapeLabel =
+            assemblyShapeTool->AddShape(shape, Standard_False);
+        const QString shapeName =
+            QString("%1:%2").arg(cleanString(name)).arg(i);
+        TDataStd_Name::Set(shapeLabel, shapeName.toStdString().c_str());
+        // ATTENTION: Until LibrePCB 1.1.0 we passed shape.Location() instead
+        // of TopLoc_Location(), but this caused wrong placement in rare cases.
+        // Although TopLoc_Location() sounds wrong(?), it fixes the issue
+        // without observing any negative consequences so far. If any issues
+        // are observed in future, we might have to reconsider this change.
+        // See details in https://github.com/LibrePCB/LibrePCB/issues/1387.
+        TDF_Label cmpLabel = assemblyShapeTool->AddComponent(
+            newLabel, shapeLabel, TopLoc_Location());
+
+        // Copy face colors.
+        modelExplorer.Init(shape, TopAbs_FACE);
+        assemblyExplorer.Init(assemblyShapeTool->GetShape(cmpLabel),
+                              TopAbs_FACE);
+        while (modelExplorer.More() && assemblyExplorer.More()) {
+          Quantity_Color color;
+          TDF_Label label;
+          if (modelShapeTool->FindShape(modelExplorer.Current(), label)) {
+            if (tryGetColor(assemblyColorTool, label, color)) {
+              modelColorTool->SetColor(assemblyExplorer.Current(), color,
+                                       XCAFDoc_ColorSurf);
+            }
+          } else if (tryGetColor(assemblyColorTool, modelExplorer.Current(),
+                                 color)) {
             modelColorTool->SetColor(assemblyExplorer.Current(), color,
                                      XCAFDoc_ColorSurf);
           }
-        } else if (tryGetColor(assemblyColorTool, modelExplorer.Current(),
-                               color)) {
-          modelColorTool->SetColor(assemblyExplorer.Current(), color,
-                                   XCAFDoc_ColorSurf);
+          modelExplorer.Next();
+          assemblyExplorer.Next();
         }
-        modelExplorer.Next();
-        assemblyExplorer.Next();
-      }
 
-      // Copy solid colors.
-      modelExplorer.Init(shape, TopAbs_SOLID, TopAbs_FACE);
-      assemblyExplorer.Init(assemblyShapeTool->GetShape(cmpLabel), TopAbs_SOLID,
-                            TopAbs_FACE);
-      while (modelExplorer.More() && assemblyExplorer.More()) {
-        Quantity_Color color;
-        TDF_Label label;
-        if (modelShapeTool->FindShape(modelExplorer.Current(), label)) {
-          if (tryGetColor(assemblyColorTool, label, color)) {
+        // Copy solid colors.
+        modelExplorer.Init(shape, TopAbs_SOLID, TopAbs_FACE);
+        assemblyExplorer.Init(assemblyShapeTool->GetShape(cmpLabel),
+                              TopAbs_SOLID, TopAbs_FACE);
+        while (modelExplorer.More() && assemblyExplorer.More()) {
+          Quantity_Color color;
+          TDF_Label label;
+          if (modelShapeTool->FindShape(modelExplorer.Current(), label)) {
+            if (tryGetColor(assemblyColorTool, label, color)) {
+              modelColorTool->SetColor(assemblyExplorer.Current(), color,
+                                       XCAFDoc_ColorSurf);
+            }
+          } else if (tryGetColor(assemblyColorTool, modelExplorer.Current(),
+                                 color)) {
             modelColorTool->SetColor(assemblyExplorer.Current(), color,
                                      XCAFDoc_ColorSurf);
           }
-        } else if (tryGetColor(assemblyColorTool, modelExplorer.Current(),
-                               color)) {
-          modelColorTool->SetColor(assemblyExplorer.Current(), color,
-                                   XCAFDoc_ColorSurf);
+          modelExplorer.Next();
+          assemblyExplorer.Next();
         }
-        modelExplorer.Next();
-        assemblyExplorer.Next();
       }
+      mImpl->addedModels.append(std::make_pair(model.mImpl->doc, newLabel));
     }
 
     gp_Trsf t, tTmp;
@@ -414,8 +533,9 @@ void OccModel::addToAssembly(const OccModel& model, const Point3D& pos,
     tTmp.SetRotation(gp_Ax1(gp_Pnt(0, 0, 0), gp_Dir(1, 0, 0)),
                      std::get<0>(rot).toRad());
     t *= tTmp;
-    assemblyShapeTool->AddComponent(mImpl->assemblyLabel, newLabel,
-                                    TopLoc_Location(t));
+    TDF_Label instanceLabel = assemblyShapeTool->AddComponent(
+        mImpl->assemblyLabel, newLabel, TopLoc_Location(t));
+    TDataStd_Name::Set(instanceLabel, newName);
 
 #if OCC_VERSION_HEX >= 0x070200
     assemblyShapeTool->UpdateAssemblies();
@@ -500,6 +620,12 @@ bool OccModel::isAvailable() noexcept {
   return (USE_OPENCASCADE != 0);
 }
 
+QByteArray OccModel::getTesselationId() noexcept {
+  return getOccVersionString().toUtf8() % ";deflection=" %
+      QByteArray::number(sTesselationDeflection) % ";angle=" %
+      QByteArray::number(sTesselationDeflectionAngleDeg);
+}
+
 QString OccModel::getOccVersionString() noexcept {
   QString s = OCC_EDITION_NAME;
 #if USE_OPENCASCADE
@@ -528,9 +654,7 @@ std::unique_ptr<OccModel> OccModel::createAssembly(const QString& name) {
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
     TDF_Label label = shapeTool->NewShape();
@@ -562,9 +686,7 @@ std::unique_ptr<OccModel> OccModel::createBoard(const librepcb::Path& outline,
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
     Handle(XCAFDoc_ShapeTool) shapeTool =
         XCAFDoc_DocumentTool::ShapeTool(doc->Main());
 
@@ -638,9 +760,8 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
   try {
     initOpenCascade();
 
-    Handle(XCAFApp_Application) app = XCAFApp_Application::GetApplication();
-    Handle(TDocStd_Document) doc;
-    app->NewDocument("MDTV-XCAF", doc);
+    Handle(TDocStd_Document) doc = newDocument();
+    auto docSg = scopeGuard([&doc]() { closeDocument(doc); });
     STEPCAFControl_Reader stepReader;
     stepReader.SetColorMode(Standard_True);
     stepReader.SetNameMode(Standard_False);
@@ -661,11 +782,11 @@ std::unique_ptr<OccModel> OccModel::loadStep(const QByteArray content) {
     }
 
     if (!stepReader.Transfer(doc)) {
-      doc->Close();
       throw RuntimeError(__FILE__, __LINE__, "Failed to transfer STEP model.");
     }
     result.reset(
         new OccModel(std::unique_ptr<Data>(new Data{doc, TDF_Label()})));
+    docSg.dismiss();  // Now owned by the model.
   } catch (const Standard_Failure& e) {
     qCritical() << "OpenCascade error:" << e.GetMessageString();
     throw RuntimeError(
@@ -683,125 +804,273 @@ QByteArray OccModel::minifyStep(const QByteArray& content) {
   QElapsedTimer timer;
   timer.start();
 
-  // Split linhes and clean whitespaces.
-  QStringList lines;
-  foreach (QString line, content.split('\n')) {
-    const QString trimmed = line.trimmed();
-    if (!trimmed.startsWith('*')) {
-      line = trimmed;
+  // Split lines and clean whitespaces. Header and footer lines are kept,
+  // multi-line data items are unwrapped into a single buffer.
+  enum class Section { Header, Data, Footer };
+  Section section = Section::Header;
+  QByteArray header;
+  QByteArray footer;
+  QByteArray data;
+  data.reserve(content.size());
+  const char* const contentEnd = content.constData() + content.size();
+  for (const char* pos = content.constData(); pos < contentEnd;) {
+    const char* lineEnd = static_cast<const char*>(
+        std::memchr(pos, '\n', contentEnd - pos));
+    if (!lineEnd) {
+      lineEnd = contentEnd;
+    }
+    const char* begin = pos;
+    const char* end = lineEnd;
+    trimStepRange(begin, end);
+    if ((begin < end) && (*begin == '*')) {
+      begin = pos;  // Keep untrimmed.
+      end = lineEnd;
+    }
+    pos = (lineEnd < contentEnd) ? (lineEnd + 1) : contentEnd;
+    QByteArray line = QByteArray::fromRawData(begin, end - begin);
+    if (line.contains('\r')) {
+      line.replace("\r", "");
     }
-    line.replace("\r", "");
     while (line.endsWith(" ;")) {
       line.chop(2);
       line.append(';');
     }
-    if (!line.isEmpty()) {
-      lines.append(line);
+    if (line.isEmpty()) {
+      continue;
+    }
+    if ((section == Section::Data) && (line == "ENDSEC;")) {
+      section = Section::Footer;
+    }
+    if (section == Section::Header) {
+      header += line + '\n';
+      if (line == "DATA;") {
+        section = Section::Data;
+      }
+    } else if (section == Section::Data) {
+      data += line;
+    } else {
+      footer += line + '\n';
     }
   }
-
-  // Split header, data and footer.
-  const int dataStart = lines.indexOf("DATA;");
-  if (dataStart < 0) {
+  if (section == Section::Header) {
     throw RuntimeError(__FILE__, __LINE__, "STEP data section not found.");
-  }
-  const int dataEnd = lines.indexOf("ENDSEC;", dataStart + 1);
-  if (dataEnd < 0) {
+  } else if (section == Section::Data) {
     throw RuntimeError(__FILE__, __LINE__, "STEP data section end not found.");
   }
-  const QStringList headerLines = lines.mid(0, dataStart + 1);
-  const QStringList footerLines = lines.mid(dataEnd);
-
-  // Unwrap multi-line data items and replace "-0." by "0." to allow
-  // eliminating more duplicates.
-  QRegularExpression re("\\-0\\.([^0-9])");
-  const QStringList dataLines =
-      lines.mid(dataStart + 1, dataEnd - dataStart - 1)
-          .join("")
-          .replace(re, "0.\\1")
-          .split(';', Qt::SkipEmptyParts);
-
-  // Parse data into key-value structure.
-  // Note: The last item of the QList<int> is not part of the data, but only
-  // used internally to make particular entries unique.
-  typedef std::pair<QStringList, QList<int>> Value;
-  QMap<int, Value> data;
-  re = QRegularExpression("#([0-9]+)");
-  foreach (const QString& line, dataLines) {
-    const int equalPos = line.indexOf("=");
-    bool ok = false;
-    const int id = line.mid(1, equalPos - 1).trimmed().toInt(&ok);
-    if (!ok) {
+
+  // Tokenize the data section into entities. The text of each entity is
+  // normalized (reference numbers removed, "-0." replaced by "0." to allow
+  // eliminating more duplicates) and stored in a single buffer, the
+  // references are stored separately.
+  struct Entity {
+    int id;
+    qsizetype textBegin;
+    qsizetype textEnd;
+    int refsBegin;
+    int refsEnd;
+    bool unique;
+  };
+  QVector<Entity> entities;
+  QByteArray texts;
+  texts.reserve(data.size());
+  QVector<int> refIds;
+  QHash<int, int> indexOfId;
+  const char* const dataEnd = data.constData() + data.size();
+  for (const char* pos = data.constData(); pos < dataEnd;) {
+    // Find end of entity, respecting quoted strings.
+    const char* end = pos;
+    bool quoted = false;
+    while ((end < dataEnd) && (quoted || (*end != ';'))) {
+      quoted = (*end == '\'') ? (!quoted) : quoted;
+      ++end;
+    }
+    const char* begin = pos;
+    pos = (end < dataEnd) ? (end + 1) : dataEnd;
+    if (begin == end) {
+      continue;
+    }
+
+    // Parse ID.
+    const char* equal =
+        static_cast<const char*>(std::memchr(begin, '=', end - begin));
+    const char* idBegin = begin + 1;
+    const char* idEnd = equal ? equal : end;
+    trimStepRange(idBegin, idEnd);
+    Entity entity{0, texts.size(), 0, int(refIds.count()), 0, false};
+    if ((!equal) || (idBegin >= idEnd) ||
+        (std::from_chars(idBegin, idEnd, entity.id).ptr != idEnd)) {
       throw RuntimeError(__FILE__, __LINE__,
                          "Failed to parse data section of STEP file.");
     }
-    const QString valueStr = line.mid(equalPos + 1).trimmed();
-    Value value;
-    int consumed = 0;
-    auto it = re.globalMatch(valueStr);
-    while (it.hasNext()) {
-      auto match = it.next();
-      value.first.append(
-          valueStr.mid(consumed, match.capturedStart(1) - consumed));
-      value.second.append(match.captured(1).toInt());
-      consumed = match.capturedEnd(1);
-    }
-    value.first.append(valueStr.mid(consumed));
+
+    // Parse value.
+    const char* valueBegin = equal + 1;
+    const char* valueEnd = end;
+    trimStepRange(valueBegin, valueEnd);
+    quoted = false;
+    for (const char* c = valueBegin; c < valueEnd;) {
+      if (*c == '\'') {
+        quoted = !quoted;
+      } else if ((!quoted) && (*c == '#')) {
+        const char* numberEnd = c + 1;
+        while ((numberEnd < valueEnd) && isStepDigit(*numberEnd)) {
+          ++numberEnd;
+        }
+        int refId = 0;
+        if ((numberEnd == c + 1) ||
+            (std::from_chars(c + 1, numberEnd, refId).ptr != numberEnd)) {
+          throw RuntimeError(__FILE__, __LINE__,
+                             "Failed to parse data section of STEP file.");
+        }
+        texts.append('#');
+        refIds.append(refId);
+        c = numberEnd;
+        continue;
+      } else if ((!quoted) && (*c == '-') && (valueEnd - c >= 3) &&
+                 (c[1] == '0') && (c[2] == '.') &&
+                 ((valueEnd - c == 3) || (!isStepDigit(c[3])))) {
+        ++c;  // Skip the sign of "-0.".
+        continue;
+      }
+      texts.append(*c);
+      ++c;
+    }
+    entity.textEnd = texts.size();
+    entity.refsEnd = refIds.count();
+
     // Important: It seems some entries must not be merged even if they are
     // identical. When merged, the STEP model won't be rendered anymore
-    // and FreeCAD displays a wrong shape object tree. We add a unique
-    // number to these entries to ensure they are left untouched.
+    // and FreeCAD displays a wrong shape object tree. We mark these entries
+    // as unique to ensure they are left untouched.
     // See also https://github.com/LibrePCB/LibrePCB/issues/1286.
-    if (valueStr.contains("PRODUCT_DEFINITION") ||
-        valueStr.contains("REPRESENTATION")) {
-      value.second.append(data.count() + 1);
-    } else {
-      value.second.append(0);
-    }
-    data.insert(id, value);
+    const std::string_view text(texts.constData() + entity.textBegin,
+                                entity.textEnd - entity.textBegin);
+    entity.unique = (text.find("PRODUCT_DEFINITION") != text.npos) ||
+        (text.find("REPRESENTATION") != text.npos);
+    indexOfId.insert(entity.id, entities.count());  // Last one wins.
+    entities.append(entity);
   }
 
-  // Eliminate duplicate data items.
-  QHash<Value, int> uniqueData;
-  QHash<int, int> idMap;
-  while (true) {
-    uniqueData.clear();
-    idMap.clear();
-    for (auto it = data.begin(); it != data.end(); it++) {
-      auto newIt = uniqueData.find(it.value());
-      if (newIt == uniqueData.end()) {
-        newIt = uniqueData.insert(it.value(), uniqueData.count() + 1);
-      }
-      idMap.insert(it.key(), newIt.value());
-    }
-    if (uniqueData.count() == data.count()) {
-      break;
-    }
-    data.clear();
-    for (auto it = uniqueData.begin(); it != uniqueData.end(); it++) {
-      data.insert(it.value(), it.key());
+  // Resolve references to entity indices (-1 for unknown IDs) and determine
+  // the order of entities by ascending ID.
+  QVector<int> refTargets;
+  refTargets.reserve(refIds.count());
+  for (int refId : refIds) {
+    refTargets.append(indexOfId.value(refId, -1));
+  }
+  QVector<int> order;
+  order.reserve(indexOfId.count());
+  for (int index : indexOfId) {
+    order.append(index);
+  }
+  std::sort(order.begin(), order.end(), [&entities](int a, int b) {
+    return entities.at(a).id < entities.at(b).id;
+  });
+
+  // Eliminate duplicate data items by hash-consing the entities bottom-up
+  // in a single depth-first pass: Once all referenced entities are
+  // classified, identical entities (same text and same referenced classes)
+  // end up in the same class. Back references of cyclic graphs are keyed by
+  // their target entity, thus such entities are only merged if they are
+  // textually identical.
+  QVector<qint64> keyRefs(refIds.count());
+  QVector<int> classes(entities.count(), -1);
+  QVector<char> states(entities.count(), 0);  // 1 = visiting, 2 = done
+  QVector<int> cursors(entities.count());
+  QHash<StepEntityKey, int> classOfKey;
+  classOfKey.reserve(entities.count());
+  QVector<int> stack;
+  for (int root : order) {
+    if (states.at(root) != 0) {
+      continue;
     }
-    for (auto& value : data) {
-      for (auto& id : value.second) {
-        id = idMap.value(id, id);
+    states[root] = 1;
+    cursors[root] = entities.at(root).refsBegin;
+    stack.append(root);
+    while (!stack.isEmpty()) {
+      const int index = stack.last();
+      const Entity& entity = entities.at(index);
+      int& cursor = cursors[index];
+      while ((cursor < entity.refsEnd) &&
+             ((refTargets.at(cursor) < 0) ||
+              (states.at(refTargets.at(cursor)) != 0))) {
+        ++cursor;
+      }
+      if (cursor < entity.refsEnd) {
+        const int child = refTargets.at(cursor);
+        states[child] = 1;
+        cursors[child] = entities.at(child).refsBegin;
+        stack.append(child);
+        continue;
+      }
+      for (int i = entity.refsBegin; i < entity.refsEnd; ++i) {
+        const int target = refTargets.at(i);
+        if (target < 0) {
+          keyRefs[i] = -1 - qint64(refIds.at(i));
+        } else if (classes.at(target) < 0) {
+          keyRefs[i] = -(qint64(1) << 32) - target;
+        } else {
+          keyRefs[i] = classes.at(target);
+        }
+      }
+      const StepEntityKey key{
+          std::string_view(texts.constData() + entity.textBegin,
+                           entity.textEnd - entity.textBegin),
+          keyRefs.constData() + entity.refsBegin,
+          entity.refsEnd - entity.refsBegin, entity.unique ? index : -1};
+      auto it = classOfKey.find(key);
+      if (it == classOfKey.end()) {
+        it = classOfKey.insert(key, classOfKey.count());
       }
+      classes[index] = it.value();
+      states[index] = 2;
+      stack.removeLast();
+    }
+  }
+
+  // Assign new IDs in order of the first occurrence of each class.
+  QVector<int> newIds(classOfKey.count(), 0);
+  QVector<int> representatives;
+  representatives.reserve(classOfKey.count());
+  for (int index : order) {
+    int& newId = newIds[classes.at(index)];
+    if (newId == 0) {
+      newId = representatives.count() + 1;
+      representatives.append(index);
     }
   }
 
   // Build new STEP file.
   QByteArray output;
-  output += headerLines.join('\n').toUtf8() + '\n';
-  for (auto it = data.begin(); it != data.end(); it++) {
-    output += QString("#%1=").arg(it.key()).toUtf8();
-    for (int i = 0; i < it.value().first.count(); ++i) {
-      output += it.value().first.at(i).toUtf8();
-      if (i < (it.value().second.count() - 1)) {  // Ignore unique ID.
-        output += QString::number(it.value().second.at(i)).toUtf8();
+  output.reserve(header.size() + texts.size() + footer.size());
+  output += header;
+  auto appendNumber = [&output](int value) {
+    char buffer[16];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output.append(buffer, result.ptr - buffer);
+  };
+  for (int index : representatives) {
+    const Entity& entity = entities.at(index);
+    output += '#';
+    appendNumber(newIds.at(classes.at(index)));
+    output += '=';
+    int ref = entity.refsBegin;
+    bool quoted = false;
+    for (qsizetype i = entity.textBegin; i < entity.textEnd; ++i) {
+      const char c = texts.at(i);
+      output += c;
+      if (c == '\'') {
+        quoted = !quoted;
+      } else if ((!quoted) && (c == '#')) {
+        const int target = refTargets.at(ref);
+        appendNumber((target >= 0) ? newIds.at(classes.at(target))
+                                   : refIds.at(ref));
+        ++ref;
       }
     }
     output += ";\n";
   }
-  output += footerLines.join('\n').toUtf8() + '\n';
+  output += footer;
   qDebug() << "Minified STEP file from" << (content.size() / 1024.0) << "kB to"
            << (output.size() / 1024.0) << "kB in" << timer.elapsed() << "ms.";
   return output;
@@ -72,6 +72,16 @@ public:
   // Static Methods
   static bool isAvailable() noexcept;
   static QString getOccVersionString() noexcept;
+
+  /**
+   * @brief Get an identifier of the tesselation algorithm and its parameters
+   *
+   * The identifier changes whenever ::tesselate() might return different
+   * results for the same model, thus it can be used for cache keys.
+   *
+   * @return Identifier (not meant to be human readable)
+   */
+  static QByteArray getTesselationId() noexcept;
   static void setVerboseOutput(bool verbose) noexcept;
   static std::unique_ptr<OccModel> createAssembly(const QString& name);
   static std::unique_ptr<OccModel> createBoard(const Path& outline,
@@ -108,7 +108,7 @@ public:
   // Constructors / Destructor
   explicit SceneData3D(std::shared_ptr<FileSystem> fs = nullptr,
                        bool autoBoardOutline = false) noexcept;
-  SceneData3D(const SceneData3D& other) = delete;
+  SceneData3D(const SceneData3D& other) = default;
   ~SceneData3D() noexcept;
 
   // Getters
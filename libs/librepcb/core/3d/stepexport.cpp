@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "stepexport.h"
 
+#include "../exceptions.h"
 #include "../fileio/filesystem.h"
 #include "../fileio/fileutils.h"
 #include "../types/pcbcolor.h"
@@ -142,38 +143,82 @@ QString StepExport::run(std::shared_ptr<SceneData3D> data, FilePath fp,
     }
     emit progressPercent(20);
 
-    // Add devices.
-    int deviceErrors = 0;
-    QString lastError;
+    // Load each distinct STEP model only once since usually many devices
+    // share the same model. The models are loaded in parallel on a local
+    // thread pool to limit the number of models being parsed at the same
+    // time. Loading is started in the order the models are needed, and each
+    // model is released after its last device has been added to the assembly.
+    emit progressStatus(tr("Loading models..."));
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
+    QHash<QString, QFuture<std::shared_ptr<OccModel>>> models;
+    QHash<QString, QString> modelErrors;
+    QHash<QString, int> modelUsages;
+    auto loadingSg = scopeGuard([&]() {
+      // On abort or error, skip loading the remaining models and wait until
+      // the running ones are finished, they must not outlive this method.
+      for (QFuture<std::shared_ptr<OccModel>>& future : models) {
+        future.cancel();
+      }
+      pool.waitForDone();
+    });
     if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
-      int i = 1;
       for (const auto& obj : data->getDevices()) {
+        if (modelUsages[obj.stepFile]++ > 0) {
+          continue;
+        }
         try {
-          emit progressStatus(tr("Exporting device %1/%2...")
-                                  .arg(i)
-                                  .arg(data->getDevices().count()));
           const QByteArray content = fs->readIfExists(obj.stepFile);
           if (!content.isEmpty()) {
-            Point3D pos = obj.stepPosition;
-            if (!obj.transform.getMirrored()) {
-              std::get<2>(pos) += *data->getThickness();
-            }
-            std::unique_ptr<OccModel> devModel = OccModel::loadStep(content);
-            model->addToAssembly(*devModel, pos, obj.stepRotation,
-                                 obj.transform, obj.name);
+            auto load = [content]() {
+              return std::shared_ptr<OccModel>(OccModel::loadStep(content));
+            };
+            models.insert(obj.stepFile, QtConcurrent::run(&pool, load));
           }
         } catch (const Exception& e) {
-          qCritical().noquote() << "Failed to export STEP model of " << obj.name
-                                << ": " << e.getMsg();
-          ++deviceErrors;
-          lastError = obj.name % ": " % e.getMsg();
+          modelErrors.insert(obj.stepFile, e.getMsg());
         }
-        emit progressPercent(20 + ((70 * i) / data->getDevices().count()));
         if (mAbort) return QString();
-        ++i;
       }
     }
 
+    // Add devices.
+    int deviceErrors = 0;
+    QString lastError;
+    int i = 1;
+    for (const auto& obj : data->getDevices()) {
+      try {
+        emit progressStatus(tr("Exporting device %1/%2...")
+                                .arg(i)
+                                .arg(data->getDevices().count()));
+        if (modelErrors.contains(obj.stepFile)) {
+          throw RuntimeError(__FILE__, __LINE__,
+                             modelErrors.value(obj.stepFile));
+        }
+        if (models.contains(obj.stepFile)) {
+          Point3D pos = obj.stepPosition;
+          if (!obj.transform.getMirrored()) {
+            std::get<2>(pos) += *data->getThickness();
+          }
+          std::shared_ptr<OccModel> devModel =
+              models.value(obj.stepFile).result();  // can throw
+          model->addToAssembly(*devModel, pos, obj.stepRotation,
+                               obj.transform, obj.name);
+        }
+      } catch (const Exception& e) {
+        qCritical().noquote() << "Failed to export STEP model of " << obj.name
+                              << ": " << e.getMsg();
+        ++deviceErrors;
+        lastError = obj.name % ": " % e.getMsg();
+      }
+      if (--modelUsages[obj.stepFile] == 0) {
+        models.remove(obj.stepFile);  // Not needed anymore.
+      }
+      emit progressPercent(20 + ((70 * i) / data->getDevices().count()));
+      if (mAbort) return QString();
+      ++i;
+    }
+
     // Save model to file.
     emit progressStatus(tr("Saving..."));
     model->saveAsStep(data->getProjectName(), fp);
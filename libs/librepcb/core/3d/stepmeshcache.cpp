@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "stepmeshcache.h"
+
+#include "../exceptions.h"
+#include "../fileio/fileutils.h"
+#include "occmodel.h"
+
+#include <QtCore>
+
+#include <cstring>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+static const char sMagic[] = "LPMESH01";
+static const quint32 sByteOrderMark = 0x01020304;
+
+static_assert(sizeof(QVector3D) == 3 * sizeof(float),
+              "QVector3D must be tightly packed.");
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+StepMeshCache::StepMeshCache(const FilePath& dir, qint64 maxSize) noexcept
+  : mDir(dir), mMaxSize(maxSize) {
+}
+
+StepMeshCache::~StepMeshCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+std::optional<StepMeshCache::Mesh> StepMeshCache::load(
+    const QString& key) const noexcept {
+  const FilePath fp = getFilePath(key);
+  if (!fp.isExistingFile()) {
+    return std::nullopt;
+  }
+  QFile file(fp.toStr());
+  if (!file.open(QIODevice::ReadOnly)) {
+    qWarning() << "Failed to open mesh cache file:" << file.errorString();
+    return std::nullopt;
+  }
+
+  // Read directly into the target buffers to avoid any intermediate copy.
+  auto read = [&file](void* dst, qint64 len) {
+    return (len >= 0) && (file.read(static_cast<char*>(dst), len) == len);
+  };
+
+  char magic[sizeof(sMagic) - 1];
+  quint32 byteOrderMark = 0;
+  quint32 colorCount = 0;
+  if ((!read(magic, sizeof(magic))) ||
+      (std::memcmp(magic, sMagic, sizeof(magic)) != 0) ||
+      (!read(&byteOrderMark, sizeof(byteOrderMark))) ||
+      (byteOrderMark != sByteOrderMark) ||
+      (!read(&colorCount, sizeof(colorCount)))) {
+    qWarning() << "Ignoring invalid mesh cache file:" << fp.toNative();
+    return std::nullopt;
+  }
+  QVector<std::pair<Color, quint64>> colors;
+  for (quint32 i = 0; i < colorCount; ++i) {
+    double rgb[3];
+    quint64 count = 0;
+    if ((!read(rgb, sizeof(rgb))) || (!read(&count, sizeof(count)))) {
+      qWarning() << "Ignoring invalid mesh cache file:" << fp.toNative();
+      return std::nullopt;
+    }
+    colors.append(
+        std::make_pair(std::make_tuple(rgb[0], rgb[1], rgb[2]), count));
+  }
+  Mesh mesh;
+  for (const auto& pair : colors) {
+    const qint64 remaining = file.size() - file.pos();
+    if (pair.second > quint64(remaining / sizeof(QVector3D))) {
+      qWarning() << "Ignoring invalid mesh cache file:" << fp.toNative();
+      return std::nullopt;
+    }
+    QVector<QVector3D> vertices(pair.second);
+    if (!read(vertices.data(), vertices.count() * sizeof(QVector3D))) {
+      qWarning() << "Failed to read mesh cache file:" << file.errorString();
+      return std::nullopt;
+    }
+    mesh.insert(pair.first, vertices);
+  }
+  if (!file.atEnd()) {
+    qWarning() << "Ignoring invalid mesh cache file:" << fp.toNative();
+    return std::nullopt;
+  }
+  file.close();
+  markAsUsed(fp);
+  return mesh;
+}
+
+void StepMeshCache::store(const QString& key, const Mesh& mesh) const noexcept {
+  if (!mDir.isValid()) {
+    return;
+  }
+  try {
+    qsizetype size = sizeof(sMagic) - 1 + 2 * sizeof(quint32) +
+        mesh.count() * (3 * sizeof(double) + sizeof(quint64));
+    for (const auto& vertices : mesh) {
+      size += vertices.count() * sizeof(QVector3D);
+    }
+    QByteArray content;
+    content.reserve(size);
+    auto write = [&content](const void* src, qsizetype len) {
+      content.append(static_cast<const char*>(src), len);
+    };
+    const quint32 colorCount = mesh.count();
+    write(sMagic, sizeof(sMagic) - 1);
+    write(&sByteOrderMark, sizeof(sByteOrderMark));
+    write(&colorCount, sizeof(colorCount));
+    for (auto it = mesh.begin(); it != mesh.end(); it++) {
+      const double rgb[3] = {std::get<0>(it.key()), std::get<1>(it.key()),
+                             std::get<2>(it.key())};
+      const quint64 count = it.value().count();
+      write(rgb, sizeof(rgb));
+      write(&count, sizeof(count));
+    }
+    for (const auto& vertices : mesh) {
+      write(vertices.constData(), vertices.count() * sizeof(QVector3D));
+    }
+    FileUtils::writeFile(getFilePath(key), content);  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Failed to write mesh cache file:" << e.getMsg();
+  }
+  prune();
+}
+
+void StepMeshCache::prune() const noexcept {
+  if (!mDir.isValid()) {
+    return;
+  }
+  // Files are sorted by modification time, most recently used first.
+  const QFileInfoList files =
+      QDir(mDir.toStr()).entryInfoList({"*.mesh"}, QDir::Files, QDir::Time);
+  qint64 totalSize = 0;
+  for (const QFileInfo& info : files) {
+    totalSize += info.size();
+    if ((totalSize > mMaxSize) && (!QFile::remove(info.absoluteFilePath()))) {
+      qWarning() << "Failed to remove mesh cache file:"
+                 << QDir::toNativeSeparators(info.absoluteFilePath());
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QString StepMeshCache::calcKey(const QByteArray& stepContent) noexcept {
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  hash.addData(OccModel::getTesselationId());
+  hash.addData(QByteArray(1, '\0'));
+  hash.addData(stepContent);
+  return QString::fromLatin1(hash.result().toHex());
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+FilePath StepMeshCache::getFilePath(const QString& key) const noexcept {
+  return mDir.isValid() ? mDir.getPathTo(key % ".mesh") : FilePath();
+}
+
+void StepMeshCache::markAsUsed(const FilePath& fp) noexcept {
+  // Opening for writing is required on some platforms to set the file time,
+  // but does not modify the content.
+  QFile file(fp.toStr());
+  if ((!file.open(QIODevice::ReadWrite)) ||
+      (!file.setFileTime(QDateTime::currentDateTime(),
+                         QFileDevice::FileModificationTime))) {
+    qWarning() << "Failed to update mesh cache file time:"
+               << file.errorString();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
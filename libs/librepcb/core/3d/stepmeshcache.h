@@ -0,0 +1,134 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_STEPMESHCACHE_H
+#define LIBREPCB_CORE_STEPMESHCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../fileio/filepath.h"
+
+#include <QtCore>
+#include <QtGui>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class StepMeshCache
+ ******************************************************************************/
+
+/**
+ * @brief On-disk cache of tesselated STEP models
+ *
+ * Stores the result of librepcb::OccModel::tesselate() in a compact binary
+ * file per model. Files are identified by a digest of the STEP content and
+ * the tesselation parameters (see #calcKey()), so a model which has already
+ * been tesselated once does not need to be loaded with OpenCascade anymore.
+ *
+ * File format (native byte order, checked when loading):
+ *   - Magic bytes `LPMESH01`, byte order mark (quint32), color count (quint32)
+ *   - For each color: red, green, blue (double each), vertex count (quint64)
+ *   - For each color: the vertices (3 floats each)
+ *
+ * Loading a file marks it as recently used (by updating its modification
+ * time). After storing a new file, the least recently used files are removed
+ * as long as the total size of the cache exceeds the configured maximum size.
+ * All methods are thread-safe.
+ */
+class StepMeshCache final {
+public:
+  // Types
+  typedef std::tuple<qreal, qreal, qreal> Color;
+  typedef QMap<Color, QVector<QVector3D>> Mesh;
+
+  // Constructors / Destructor
+  StepMeshCache() = delete;
+  StepMeshCache(const StepMeshCache& other) = delete;
+  explicit StepMeshCache(const FilePath& dir,
+                         qint64 maxSize = 256 * 1024 * 1024) noexcept;
+  ~StepMeshCache() noexcept;
+
+  // Getters
+  const FilePath& getDir() const noexcept { return mDir; }
+  qint64 getMaxSize() const noexcept { return mMaxSize; }
+
+  // General Methods
+
+  /**
+   * @brief Load a mesh from the cache
+   *
+   * @param key     Cache key as returned by #calcKey().
+   *
+   * @return The cached mesh, or `std::nullopt` if not cached (or invalid).
+   */
+  std::optional<Mesh> load(const QString& key) const noexcept;
+
+  /**
+   * @brief Store a mesh in the cache
+   *
+   * Errors are only logged since the cache is not essential.
+   *
+   * @param key     Cache key as returned by #calcKey().
+   * @param mesh    The mesh to store.
+   */
+  void store(const QString& key, const Mesh& mesh) const noexcept;
+
+  /**
+   * @brief Remove the least recently used files exceeding the maximum size
+   *
+   * Automatically called by #store(), errors are only logged.
+   */
+  void prune() const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Calculate the cache key of a STEP model
+   *
+   * @param stepContent   Content of the STEP file.
+   *
+   * @return Digest of the STEP content and the tesselation parameters.
+   */
+  static QString calcKey(const QByteArray& stepContent) noexcept;
+
+  // Operator Overloadings
+  StepMeshCache& operator=(const StepMeshCache& rhs) = delete;
+
+private:  // Methods
+  FilePath getFilePath(const QString& key) const noexcept;
+  static void markAsUsed(const FilePath& fp) noexcept;
+
+private:  // Data
+  const FilePath mDir;
+  const qint64 mMaxSize;  ///< Maximum total size of all files [bytes]
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
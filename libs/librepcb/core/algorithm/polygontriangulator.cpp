@@ -0,0 +1,746 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The triangulation algorithm in this file is derived from earcut
+ * (https://github.com/mapbox/earcut), which is licensed as follows:
+ *
+ * ISC License
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE
+ * OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "polygontriangulator.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Implementation Class
+ ******************************************************************************/
+
+/**
+ * @brief Ear clipping triangulator
+ *
+ * This is an implementation of the algorithm used by the "earcut" library
+ * (see license notice at the top of this file), adapted to Clipper paths.
+ * Every polygon is stored as a circular doubly linked list of vertices from
+ * which ears are clipped until only a triangle is left. If no ear can be
+ * found, the polygon is cleaned up and the algorithm is retried with
+ * increasingly aggressive strategies.
+ */
+class PolygonTriangulatorImpl final {
+public:
+  explicit PolygonTriangulatorImpl(ClipperLib::Path& triangles) noexcept
+    : mTriangles(triangles) {}
+  PolygonTriangulatorImpl(const PolygonTriangulatorImpl& other) = delete;
+  ~PolygonTriangulatorImpl() noexcept {}
+
+  void triangulate(const ClipperLib::Path& outline,
+                   const ClipperLib::Paths& holes) noexcept {
+    Node* outer = createRing(outline, true);
+    if ((!outer) || (outer->next == outer->prev)) {
+      return;
+    }
+    std::size_t vertexCount = outline.size();
+    if (!holes.empty()) {
+      for (const ClipperLib::Path& hole : holes) {
+        vertexCount += hole.size();
+      }
+      outer = eliminateHoles(holes, outer);
+    }
+
+    // For non-trivial polygons, speed up the ear tests with a z-order curve.
+    mInvSize = 0;
+    if (vertexCount > 80) {
+      double minX = std::numeric_limits<double>::max();
+      double minY = std::numeric_limits<double>::max();
+      double maxX = std::numeric_limits<double>::lowest();
+      double maxY = std::numeric_limits<double>::lowest();
+      for (const ClipperLib::IntPoint& p : outline) {
+        minX = std::min(minX, static_cast<double>(p.X));
+        minY = std::min(minY, static_cast<double>(p.Y));
+        maxX = std::max(maxX, static_cast<double>(p.X));
+        maxY = std::max(maxY, static_cast<double>(p.Y));
+      }
+      const double size = std::max(maxX - minX, maxY - minY);
+      mMinX = minX;
+      mMinY = minY;
+      mInvSize = (size > 0) ? (32767.0 / size) : 0;
+    }
+
+    clipEars(outer, 0);
+  }
+
+private:  // Types
+  struct Node {
+    int index;  ///< Index of the input vertex (shared by bridge copies)
+    ClipperLib::IntPoint pos;
+    double x;
+    double y;
+    Node* prev;
+    Node* next;
+    qint32 z;  ///< Z-order curve value
+    Node* prevZ;
+    Node* nextZ;
+    bool steiner;  ///< Whether this is a single-vertex hole
+  };
+
+private:  // Methods
+  Node* createNode(int index, const ClipperLib::IntPoint& pos) noexcept {
+    mNodes.push_back(Node{index, pos, static_cast<double>(pos.X),
+                          static_cast<double>(pos.Y), nullptr, nullptr, 0,
+                          nullptr, nullptr, false});
+    return &mNodes.back();
+  }
+
+  Node* insertNode(int index, const ClipperLib::IntPoint& pos,
+                   Node* last) noexcept {
+    Node* p = createNode(index, pos);
+    if (!last) {
+      p->prev = p;
+      p->next = p;
+    } else {
+      p->next = last->next;
+      p->prev = last;
+      last->next->prev = p;
+      last->next = p;
+    }
+    return p;
+  }
+
+  static void removeNode(Node* p) noexcept {
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+    if (p->prevZ) p->prevZ->nextZ = p->nextZ;
+    if (p->nextZ) p->nextZ->prevZ = p->prevZ;
+  }
+
+  /**
+   * @brief Create a circular linked list from a path
+   *
+   * The vertices are linked in the requested orientation, independent of
+   * the orientation of the passed path.
+   */
+  Node* createRing(const ClipperLib::Path& path, bool clockwise) noexcept {
+    const int count = static_cast<int>(path.size());
+    double sum = 0;
+    for (int i = 0, j = count - 1; i < count; j = i++) {
+      sum += (static_cast<double>(path[j].X) - path[i].X) *
+          (static_cast<double>(path[i].Y) + path[j].Y);
+    }
+    Node* last = nullptr;
+    if (clockwise == (sum > 0)) {
+      for (int i = 0; i < count; ++i) {
+        last = insertNode(mNextIndex + i, path[i], last);
+      }
+    } else {
+      for (int i = count - 1; i >= 0; --i) {
+        last = insertNode(mNextIndex + i, path[i], last);
+      }
+    }
+    mNextIndex += count;
+    if (last && equals(last, last->next)) {
+      removeNode(last);
+      last = last->next;
+    }
+    return last;
+  }
+
+  /**
+   * @brief Remove duplicate and collinear vertices
+   */
+  static Node* filterPoints(Node* start, Node* end = nullptr) noexcept {
+    if (!start) return start;
+    if (!end) end = start;
+    Node* p = start;
+    bool again;
+    do {
+      again = false;
+      if ((!p->steiner) &&
+          (equals(p, p->next) || (area(p->prev, p, p->next) == 0))) {
+        removeNode(p);
+        p = end = p->prev;
+        if (p == p->next) break;
+        again = true;
+      } else {
+        p = p->next;
+      }
+    } while (again || (p != end));
+    return end;
+  }
+
+  /**
+   * @brief Main ear clipping loop
+   *
+   * @param ear   Any vertex of the polygon to triangulate.
+   * @param pass  0 for the initial pass, 1 after removing degenerated
+   *              vertices, 2 after curing local self-intersections.
+   */
+  void clipEars(Node* ear, int pass) noexcept {
+    if (!ear) return;
+    if ((pass == 0) && (mInvSize > 0)) {
+      indexCurve(ear);
+    }
+
+    Node* stop = ear;
+    while (ear->prev != ear->next) {
+      Node* prev = ear->prev;
+      Node* next = ear->next;
+      if ((mInvSize > 0) ? isEarHashed(ear) : isEar(ear)) {
+        addTriangle(prev, ear, next);
+        removeNode(ear);
+        // Skipping the next vertex leads to less sliver triangles.
+        ear = next->next;
+        stop = next->next;
+        continue;
+      }
+      ear = next;
+      if (ear == stop) {
+        // No ears found anymore, try to make progress in other ways.
+        if (pass == 0) {
+          clipEars(filterPoints(ear), 1);
+        } else if (pass == 1) {
+          ear = cureLocalIntersections(filterPoints(ear));
+          clipEars(ear, 2);
+        } else if (pass == 2) {
+          splitPolygonAndClipEars(ear);
+        }
+        break;
+      }
+    }
+  }
+
+  void addTriangle(const Node* a, const Node* b, const Node* c) noexcept {
+    mTriangles.push_back(a->pos);
+    mTriangles.push_back(b->pos);
+    mTriangles.push_back(c->pos);
+  }
+
+  static bool isEar(const Node* ear) noexcept {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+    if (area(a, b, c) >= 0) return false;  // Reflex, can't be an ear.
+
+    // Make sure no other vertex is within the ear.
+    const double x0 = std::min({a->x, b->x, c->x});
+    const double y0 = std::min({a->y, b->y, c->y});
+    const double x1 = std::max({a->x, b->x, c->x});
+    const double y1 = std::max({a->y, b->y, c->y});
+    const Node* p = c->next;
+    while (p != a) {
+      if ((p->x >= x0) && (p->x <= x1) && (p->y >= y0) && (p->y <= y1) &&
+          pointInTriangle(a, b, c, p) && (area(p->prev, p, p->next) >= 0)) {
+        return false;
+      }
+      p = p->next;
+    }
+    return true;
+  }
+
+  bool isEarHashed(const Node* ear) const noexcept {
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+    if (area(a, b, c) >= 0) return false;  // Reflex, can't be an ear.
+
+    // Only vertices within the z-order range of the triangle's bounding box
+    // need to be checked.
+    const double x0 = std::min({a->x, b->x, c->x});
+    const double y0 = std::min({a->y, b->y, c->y});
+    const double x1 = std::max({a->x, b->x, c->x});
+    const double y1 = std::max({a->y, b->y, c->y});
+    const qint32 minZ = zOrder(x0, y0);
+    const qint32 maxZ = zOrder(x1, y1);
+    auto isInside = [&](const Node* p) {
+      return (p->x >= x0) && (p->x <= x1) && (p->y >= y0) && (p->y <= y1) &&
+          (p != a) && (p != c) && pointInTriangle(a, b, c, p) &&
+          (area(p->prev, p, p->next) >= 0);
+    };
+
+    // Look for points inside the triangle in both directions.
+    const Node* p = ear->prevZ;
+    const Node* n = ear->nextZ;
+    while (p && (p->z >= minZ) && n && (n->z <= maxZ)) {
+      if (isInside(p)) return false;
+      p = p->prevZ;
+      if (isInside(n)) return false;
+      n = n->nextZ;
+    }
+    while (p && (p->z >= minZ)) {
+      if (isInside(p)) return false;
+      p = p->prevZ;
+    }
+    while (n && (n->z <= maxZ)) {
+      if (isInside(n)) return false;
+      n = n->nextZ;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Clip triangles at small local self-intersections
+   */
+  Node* cureLocalIntersections(Node* start) noexcept {
+    Node* p = start;
+    do {
+      Node* a = p->prev;
+      Node* b = p->next->next;
+      if ((!equals(a, b)) && intersects(a, p, p->next, b) &&
+          locallyInside(a, b) && locallyInside(b, a)) {
+        addTriangle(a, p, b);
+        removeNode(p);
+        removeNode(p->next);
+        p = start = b;
+      }
+      p = p->next;
+    } while (p != start);
+    return filterPoints(p);
+  }
+
+  /**
+   * @brief Split the polygon along a valid diagonal and triangulate both
+   */
+  void splitPolygonAndClipEars(Node* start) noexcept {
+    Node* a = start;
+    do {
+      Node* b = a->next->next;
+      while (b != a->prev) {
+        if ((a->index != b->index) && isValidDiagonal(a, b)) {
+          Node* c = splitPolygon(a, b);
+          a = filterPoints(a, a->next);
+          c = filterPoints(c, c->next);
+          clipEars(a, 0);
+          clipEars(c, 0);
+          return;
+        }
+        b = b->next;
+      }
+      a = a->next;
+    } while (a != start);
+  }
+
+  /**
+   * @brief Link all holes into the outline through bridge edges
+   */
+  Node* eliminateHoles(const ClipperLib::Paths& holes, Node* outer) noexcept {
+    std::vector<Node*> queue;
+    queue.reserve(holes.size());
+    for (const ClipperLib::Path& hole : holes) {
+      if (Node* list = createRing(hole, false)) {
+        if (list == list->next) {
+          list->steiner = true;
+        }
+        queue.push_back(getLeftmost(list));
+      }
+    }
+    std::sort(queue.begin(), queue.end(),
+              [](const Node* a, const Node* b) { return a->x < b->x; });
+    for (Node* hole : queue) {
+      outer = eliminateHole(hole, outer);
+    }
+    return outer;
+  }
+
+  Node* eliminateHole(Node* hole, Node* outer) noexcept {
+    Node* bridge = findHoleBridge(hole, outer);
+    if (!bridge) {
+      return outer;
+    }
+    Node* bridgeReverse = splitPolygon(bridge, hole);
+    // Filter collinear points around the cuts.
+    filterPoints(bridgeReverse, bridgeReverse->next);
+    return filterPoints(bridge, bridge->next);
+  }
+
+  /**
+   * @brief Find a vertex of the outline which can be connected to a hole
+   *
+   * Uses David Eberly's algorithm: Cast a ray from the leftmost hole vertex
+   * to the left and pick the closest visible vertex of the hit segment.
+   */
+  static Node* findHoleBridge(const Node* hole, Node* outer) noexcept {
+    Node* p = outer;
+    const double hx = hole->x;
+    const double hy = hole->y;
+    double qx = std::numeric_limits<double>::lowest();
+    Node* m = nullptr;
+
+    // Find a segment intersected by a ray from the hole's leftmost point to
+    // the left. The segment's endpoint with lesser x will be the potential
+    // connection point.
+    do {
+      if ((hy <= p->y) && (hy >= p->next->y) && (p->next->y != p->y)) {
+        const double x = p->x +
+            (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+        if ((x <= hx) && (x > qx)) {
+          qx = x;
+          m = (p->x < p->next->x) ? p : p->next;
+          if (x == hx) {
+            // Hole touches outer segment, pick leftmost endpoint.
+            return m;
+          }
+        }
+      }
+      p = p->next;
+    } while (p != outer);
+    if (!m) {
+      return nullptr;
+    }
+
+    // Look for points inside the triangle of hole point, segment intersection
+    // and endpoint. If there are no points found, we have a valid connection.
+    // Otherwise choose the point of the minimum angle with the ray as
+    // connection point.
+    const Node* stop = m;
+    const double mx = m->x;
+    const double my = m->y;
+    double tanMin = std::numeric_limits<double>::infinity();
+    p = m;
+    do {
+      if ((hx >= p->x) && (p->x >= mx) && (hx != p->x) &&
+          pointInTriangle((hy < my) ? hx : qx, hy, mx, my,
+                          (hy < my) ? qx : hx, hy, p->x, p->y)) {
+        const double tan = std::abs(hy - p->y) / (hx - p->x);
+        if (locallyInside(p, hole) &&
+            ((tan < tanMin) ||
+             ((tan == tanMin) &&
+              ((p->x > m->x) ||
+               ((p->x == m->x) && sectorContainsSector(m, p)))))) {
+          m = p;
+          tanMin = tan;
+        }
+      }
+      p = p->next;
+    } while (p != stop);
+    return m;
+  }
+
+  static bool sectorContainsSector(const Node* m, const Node* p) noexcept {
+    return (area(m->prev, m, p->prev) < 0) && (area(p->next, m, m->next) < 0);
+  }
+
+  static Node* getLeftmost(Node* start) noexcept {
+    Node* p = start;
+    Node* leftmost = start;
+    do {
+      if ((p->x < leftmost->x) ||
+          ((p->x == leftmost->x) && (p->y < leftmost->y))) {
+        leftmost = p;
+      }
+      p = p->next;
+    } while (p != start);
+    return leftmost;
+  }
+
+  /**
+   * @brief Link the vertices in z-order and sort them
+   */
+  void indexCurve(Node* start) const noexcept {
+    Node* p = start;
+    do {
+      if (p->z == 0) {
+        p->z = zOrder(p->x, p->y);
+      }
+      p->prevZ = p->prev;
+      p->nextZ = p->next;
+      p = p->next;
+    } while (p != start);
+    p->prevZ->nextZ = nullptr;
+    p->prevZ = nullptr;
+    sortLinked(p);
+  }
+
+  /**
+   * @brief Merge sort of the z-order linked list (Simon Tatham's algorithm)
+   */
+  static Node* sortLinked(Node* list) noexcept {
+    int inSize = 1;
+    int numMerges;
+    do {
+      Node* p = list;
+      Node* tail = nullptr;
+      list = nullptr;
+      numMerges = 0;
+      while (p) {
+        ++numMerges;
+        Node* q = p;
+        int pSize = 0;
+        for (int i = 0; i < inSize; ++i) {
+          ++pSize;
+          q = q->nextZ;
+          if (!q) break;
+        }
+        int qSize = inSize;
+        while ((pSize > 0) || ((qSize > 0) && q)) {
+          Node* e;
+          if ((pSize != 0) && ((qSize == 0) || (!q) || (p->z <= q->z))) {
+            e = p;
+            p = p->nextZ;
+            --pSize;
+          } else {
+            e = q;
+            q = q->nextZ;
+            --qSize;
+          }
+          if (tail) {
+            tail->nextZ = e;
+          } else {
+            list = e;
+          }
+          e->prevZ = tail;
+          tail = e;
+        }
+        p = q;
+      }
+      tail->nextZ = nullptr;
+      inSize *= 2;
+    } while (numMerges > 1);
+    return list;
+  }
+
+  /**
+   * @brief Calculate the z-order curve value of a point
+   *
+   * The coordinates are mapped to 15 bit integers within the bounding box of
+   * the polygon and their bits are interleaved.
+   */
+  qint32 zOrder(double x, double y) const noexcept {
+    quint32 ix = static_cast<quint32>((x - mMinX) * mInvSize);
+    quint32 iy = static_cast<quint32>((y - mMinY) * mInvSize);
+    ix = (ix | (ix << 8)) & 0x00FF00FF;
+    ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+    ix = (ix | (ix << 2)) & 0x33333333;
+    ix = (ix | (ix << 1)) & 0x55555555;
+    iy = (iy | (iy << 8)) & 0x00FF00FF;
+    iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+    iy = (iy | (iy << 2)) & 0x33333333;
+    iy = (iy | (iy << 1)) & 0x55555555;
+    return static_cast<qint32>(ix | (iy << 1));
+  }
+
+  static bool pointInTriangle(double ax, double ay, double bx, double by,
+                              double cx, double cy, double px,
+                              double py) noexcept {
+    return ((cx - px) * (ay - py) >= (ax - px) * (cy - py)) &&
+        ((ax - px) * (by - py) >= (bx - px) * (ay - py)) &&
+        ((bx - px) * (cy - py) >= (cx - px) * (by - py));
+  }
+
+  static bool pointInTriangle(const Node* a, const Node* b, const Node* c,
+                              const Node* p) noexcept {
+    return pointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y);
+  }
+
+  /**
+   * @brief Check if a diagonal between two vertices is valid
+   *
+   * Valid means the diagonal lies within the polygon and does not intersect
+   * any polygon edge.
+   */
+  static bool isValidDiagonal(const Node* a, const Node* b) noexcept {
+    return (a->next->index != b->index) && (a->prev->index != b->index) &&
+        (!intersectsPolygon(a, b)) &&
+        ((locallyInside(a, b) && locallyInside(b, a) && middleInside(a, b) &&
+          ((area(a->prev, a, b->prev) != 0) || (area(a, b->prev, b) != 0))) ||
+         (equals(a, b) && (area(a->prev, a, a->next) > 0) &&
+          (area(b->prev, b, b->next) > 0)));
+  }
+
+  /**
+   * @brief Signed area of a triangle
+   */
+  static double area(const Node* p, const Node* q, const Node* r) noexcept {
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+  }
+
+  static bool equals(const Node* p1, const Node* p2) noexcept {
+    return (p1->x == p2->x) && (p1->y == p2->y);
+  }
+
+  static int sign(double value) noexcept {
+    return (value > 0) ? 1 : ((value < 0) ? -1 : 0);
+  }
+
+  /**
+   * @brief Check if the point q lies on the segment pr (assuming collinearity)
+   */
+  static bool onSegment(const Node* p, const Node* q, const Node* r) noexcept {
+    return (q->x <= std::max(p->x, r->x)) && (q->x >= std::min(p->x, r->x)) &&
+        (q->y <= std::max(p->y, r->y)) && (q->y >= std::min(p->y, r->y));
+  }
+
+  static bool intersects(const Node* p1, const Node* q1, const Node* p2,
+                         const Node* q2) noexcept {
+    const int o1 = sign(area(p1, q1, p2));
+    const int o2 = sign(area(p1, q1, q2));
+    const int o3 = sign(area(p2, q2, p1));
+    const int o4 = sign(area(p2, q2, q1));
+    if ((o1 != o2) && (o3 != o4)) return true;
+    if ((o1 == 0) && onSegment(p1, p2, q1)) return true;
+    if ((o2 == 0) && onSegment(p1, q2, q1)) return true;
+    if ((o3 == 0) && onSegment(p2, p1, q2)) return true;
+    if ((o4 == 0) && onSegment(p2, q1, q2)) return true;
+    return false;
+  }
+
+  static bool intersectsPolygon(const Node* a, const Node* b) noexcept {
+    const Node* p = a;
+    do {
+      if ((p->index != a->index) && (p->next->index != a->index) &&
+          (p->index != b->index) && (p->next->index != b->index) &&
+          intersects(p, p->next, a, b)) {
+        return true;
+      }
+      p = p->next;
+    } while (p != a);
+    return false;
+  }
+
+  static bool locallyInside(const Node* a, const Node* b) noexcept {
+    return (area(a->prev, a, a->next) < 0)
+        ? ((area(a, b, a->next) >= 0) && (area(a, a->prev, b) >= 0))
+        : ((area(a, b, a->prev) < 0) || (area(a, a->next, b) < 0));
+  }
+
+  static bool middleInside(const Node* a, const Node* b) noexcept {
+    const Node* p = a;
+    bool inside = false;
+    const double px = (a->x + b->x) / 2;
+    const double py = (a->y + b->y) / 2;
+    do {
+      if (((p->y > py) != (p->next->y > py)) && (p->next->y != p->y) &&
+          (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) +
+               p->x)) {
+        inside = !inside;
+      }
+      p = p->next;
+    } while (p != a);
+    return inside;
+  }
+
+  /**
+   * @brief Split a polygon into two by linking two vertices
+   *
+   * If the vertices belong to different rings (i.e. outline and hole), the
+   * rings are merged into one instead.
+   *
+   * @return The copy of vertex b within the second polygon.
+   */
+  Node* splitPolygon(Node* a, Node* b) noexcept {
+    Node* a2 = createNode(a->index, a->pos);
+    Node* b2 = createNode(b->index, b->pos);
+    Node* an = a->next;
+    Node* bp = b->prev;
+    a->next = b;
+    b->prev = a;
+    a2->next = an;
+    an->prev = a2;
+    b2->next = a2;
+    a2->prev = b2;
+    bp->next = b2;
+    b2->prev = bp;
+    return b2;
+  }
+
+private:  // Data
+  ClipperLib::Path& mTriangles;
+  std::deque<Node> mNodes;  ///< Deque to keep the node pointers stable
+  int mNextIndex = 0;
+  double mMinX = 0;
+  double mMinY = 0;
+  double mInvSize = 0;  ///< Zero if z-order hashing is disabled
+};
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ClipperLib::Path PolygonTriangulator::triangulate(
+    const ClipperLib::Path& outline, const ClipperLib::Paths& holes) {
+  ClipperLib::Path triangles;
+  PolygonTriangulatorImpl impl(triangles);
+  impl.triangulate(outline, holes);
+  return triangles;
+}
+
+ClipperLib::Path PolygonTriangulator::triangulate(
+    const ClipperLib::PolyNode& node) {
+  ClipperLib::Path triangles;
+  triangulateNode(node, triangles);
+  return triangles;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void PolygonTriangulator::triangulateNode(const ClipperLib::PolyNode& node,
+                                          ClipperLib::Path& triangles) {
+  if (!node.IsHole()) {
+    if ((!node.IsOpen()) && (!node.Contour.empty())) {
+      ClipperLib::Paths holes;
+      holes.reserve(node.Childs.size());
+      for (const ClipperLib::PolyNode* hole : node.Childs) {
+        holes.push_back(hole->Contour);
+      }
+      PolygonTriangulatorImpl impl(triangles);
+      impl.triangulate(node.Contour, holes);
+    }
+    for (const ClipperLib::PolyNode* hole : node.Childs) {
+      for (const ClipperLib::PolyNode* outline : hole->Childs) {
+        triangulateNode(*outline, triangles);
+      }
+    }
+  } else {
+    for (const ClipperLib::PolyNode* outline : node.Childs) {
+      triangulateNode(*outline, triangles);
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_POLYGONTRIANGULATOR_H
+#define LIBREPCB_CORE_POLYGONTRIANGULATOR_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class PolygonTriangulator
+ ******************************************************************************/
+
+/**
+ * @brief Triangulation of polygons with holes
+ *
+ * Splits simple polygons (with an arbitrary number of holes) into triangles
+ * by ear clipping. Holes are merged into the outline through bridge edges
+ * first, and for larger polygons the vertices are indexed along a z-order
+ * curve so the ear test only has to look at nearby vertices. This makes the
+ * triangulation fast enough for complete board layers with many thousands of
+ * vertices.
+ *
+ * The orientation of the input paths does not matter, and degenerated input
+ * (duplicate points, collinear points, touching holes) is handled gracefully.
+ * For self-intersecting input, the result is a best-effort triangulation.
+ */
+class PolygonTriangulator final {
+public:
+  // Disable instantiation
+  PolygonTriangulator() = delete;
+  ~PolygonTriangulator() = delete;
+
+  /**
+   * @brief Triangulate a polygon with holes
+   *
+   * @param outline   The outer contour of the polygon.
+   * @param holes     The holes within the outline.
+   *
+   * @return The vertices of all triangles, i.e. each 3 subsequent points
+   *         represent one triangle.
+   */
+  static ClipperLib::Path triangulate(const ClipperLib::Path& outline,
+                                      const ClipperLib::Paths& holes);
+
+  /**
+   * @brief Triangulate all polygons of a Clipper polygon tree
+   *
+   * @param node      The tree (or subtree) to triangulate. All outlines
+   *                  of the tree are triangulated together with their
+   *                  holes, including outlines nested within holes.
+   *
+   * @return The vertices of all triangles, i.e. each 3 subsequent points
+   *         represent one triangle.
+   */
+  static ClipperLib::Path triangulate(const ClipperLib::PolyNode& node);
+
+private:  // Methods
+  static void triangulateNode(const ClipperLib::PolyNode& node,
+                              ClipperLib::Path& triangles);
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
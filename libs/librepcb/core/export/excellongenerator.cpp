@@ -107,7 +107,7 @@ void ExcellonGenerator::generate() {
 }
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::writeFile(filepath, toByteArray());  // can throw
 }
 
 /*******************************************************************************
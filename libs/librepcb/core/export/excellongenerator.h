@@ -65,6 +65,7 @@ public:
 
   // Getters
   const QString& toStr() const noexcept { return mOutput; }
+  QByteArray toByteArray() const noexcept { return mOutput.toLatin1(); }
 
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia, bool plated,
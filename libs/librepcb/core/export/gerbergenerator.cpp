@@ -33,6 +33,9 @@
 
 #include <QtCore>
 
+#include <algorithm>
+#include <charconv>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -404,7 +407,7 @@ void GerberGenerator::saveToFile(const FilePath& filepath) const {
   // Note: Although we save it as UTF-8, usually it will still contain only
   // ASCII characters for maximum compatibility with legacy crappy readers.
   // Unicode is only required when exporting Gerber X3 assembly attributes.
-  FileUtils::writeFile(filepath, mOutput.toUtf8());  // can throw
+  FileUtils::writeFile(filepath, toByteArray());  // can throw
 }
 
 /*******************************************************************************
@@ -452,12 +455,14 @@ void GerberGenerator::setCurrentAttributes(
   if (componentRotation) {
     attributes.append(GerberAttribute::componentRotation(*componentRotation));
   }
-  mContent.append(mAttributeWriter->setAttributes(attributes));
+  mContent.append(mAttributeWriter->setAttributes(attributes).toUtf8());
 }
 
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    mContent.append('D');
+    appendNumber(mContent, number);
+    mContent.append("*\n");
     mCurrentApertureNumber = number;
   }
 }
@@ -483,22 +488,22 @@ void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos, "D02*\n");
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos, "D01*\n");
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
                                                     const Point& center,
                                                     const Point& end) noexcept {
   Point diff = center - start;
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
-                           diff.getX().toNmString(), diff.getY().toNmString()));
+  appendCoordinates(end, "I");
+  appendNumber(mContent, diff.getX().toNm());
+  mContent.append('J');
+  appendNumber(mContent, diff.getY().toNm());
+  mContent.append("D01*\n");
 }
 
 void GerberGenerator::interpolateBetween(const Vertex& from,
@@ -520,8 +525,18 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendCoordinates(pos, "D03*\n");
+}
+
+void GerberGenerator::appendCoordinates(const Point& pos,
+                                        const char* suffix) noexcept {
+  // Note: This is called for every single coordinate, thus it is implemented
+  // without any temporary strings for performance reasons.
+  mContent.append('X');
+  appendNumber(mContent, pos.getX().toNm());
+  mContent.append('Y');
+  appendNumber(mContent, pos.getY().toNm());
+  mContent.append(suffix);
 }
 
 void GerberGenerator::printHeader() noexcept {
@@ -529,7 +544,7 @@ void GerberGenerator::printHeader() noexcept {
 
   // Add file attributes.
   foreach (const GerberAttribute& a, mFileAttributes) {
-    mOutput.append(a.toGerberString());
+    mOutput.append(a.toGerberString().toUtf8());
   }
 
   // coordinate format specification:
@@ -555,11 +570,12 @@ void GerberGenerator::printHeader() noexcept {
 
 void GerberGenerator::printApertureList() noexcept {
   mOutput.append("G04 --- APERTURE LIST BEGIN --- *\n");
-  mOutput.append(mApertureList->generateString());
+  mOutput.append(mApertureList->generateString().toUtf8());
   mOutput.append("G04 --- APERTURE LIST END --- *\n");
 }
 
 void GerberGenerator::printContent() noexcept {
+  mOutput.reserve(mOutput.size() + mContent.size() + 1024);
   mOutput.append("G04 --- BOARD BEGIN --- *\n");
   mOutput.append(mContent);
   mOutput.append("G04 --- BOARD END --- *\n");
@@ -567,8 +583,9 @@ void GerberGenerator::printContent() noexcept {
 
 void GerberGenerator::printFooter() noexcept {
   // MD5 checksum over content
-  mOutput.append(
-      GerberAttribute::fileMd5(calcOutputMd5Checksum()).toGerberString());
+  mOutput.append(GerberAttribute::fileMd5(calcOutputMd5Checksum())
+                     .toGerberString()
+                     .toUtf8());
 
   // end of file
   mOutput.append("M02*\n");
@@ -577,9 +594,26 @@ void GerberGenerator::printFooter() noexcept {
 QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
   // according to the RS-274C standard, linebreaks are not included in the
   // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  const char* begin = mOutput.constData();
+  const char* const end = begin + mOutput.size();
+  while (begin < end) {
+    const char* lineEnd = std::find(begin, end, '\n');
+    hash.addData(begin, lineEnd - begin);
+    begin = lineEnd + 1;
+  }
+  return QString(hash.result().toHex());
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+void GerberGenerator::appendNumber(QByteArray& out, qint64 number) noexcept {
+  char buffer[24];
+  const std::to_chars_result res =
+      std::to_chars(buffer, buffer + sizeof(buffer), number);
+  out.append(buffer, res.ptr - buffer);
 }
 
 /*******************************************************************************
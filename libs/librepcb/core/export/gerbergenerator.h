@@ -67,7 +67,8 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const noexcept { return QString::fromUtf8(mOutput); }
+  const QByteArray& toByteArray() const noexcept { return mOutput; }
 
   // Plot Methods
   void setFileFunctionOutlines(bool plated) noexcept;
@@ -157,18 +158,22 @@ private:
                                      const Point& end) noexcept;
   void interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void flashAtPosition(const Point& pos) noexcept;
+  void appendCoordinates(const Point& pos, const char* suffix) noexcept;
   void printHeader() noexcept;
   void printApertureList() noexcept;
   void printContent() noexcept;
   void printFooter() noexcept;
   QString calcOutputMd5Checksum() const noexcept;
 
+  // Static Methods
+  static void appendNumber(QByteArray& out, qint64 number) noexcept;
+
   // Metadata
   QVector<GerberAttribute> mFileAttributes;
 
-  // Gerber Data
-  QString mOutput;
-  QString mContent;
+  // Gerber Data (UTF-8 encoded)
+  QByteArray mOutput;
+  QByteArray mContent;
   QScopedPointer<GerberAttributeWriter> mAttributeWriter;
   QScopedPointer<GerberApertureList> mApertureList;
   int mCurrentApertureNumber;
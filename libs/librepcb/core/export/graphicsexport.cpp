@@ -185,204 +185,98 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
       throw RuntimeError(__FILE__, __LINE__, tr("No pages to export/print."));
     }
 
-    // Export all pages.
-    QPainter painter;
-    for (int index = 0; index < args.pages.count(); ++index) {
-      const qreal percentPerPage = qreal(80) / args.pages.count();
-      emit progress(20 + std::ceil(percentPerPage * index), index + 1,
-                    args.pages.count());
-      const Page& page = args.pages.at(index);
-      if (mAbort) {
-        break;
-      }
-
-      // Determine source bounding rect.
-      QRectF sourceRectPx = calcSourceRect(*page.first, *page.second);
-      QTransform sourceTransform = getSourceTransformation(*page.second);
-      QRectF sourceRectTransformedPx = sourceTransform.mapRect(sourceRectPx);
+    // Determine DPI of the paged paint device, if any.
+    std::optional<int> deviceDpi;
+    if (printer) {
+      deviceDpi = printer->resolution();
+    } else if (pdfWriter) {
+      deviceDpi = pdfWriter->resolution();
+    }
 
-      // Determine output page size.
-      QPageSize pageSize;
-      if (page.second->getPageSize() && page.second->getPageSize()->isValid()) {
-        // Fixed page size is specified.
-        pageSize = *page.second->getPageSize();
-      } else {
-        // Derive page size from source size.
-        Length width = Length::fromPx(sourceRectTransformedPx.width()) +
-            *page.second->getMarginLeft() + *page.second->getMarginRight();
-        Length height = Length::fromPx(sourceRectTransformedPx.height()) +
-            *page.second->getMarginTop() + *page.second->getMarginBottom();
-        pageSize =
-            QPageSize(QSizeF(width.toMm(), height.toMm()),
-                      QPageSize::Millimeter, "Custom", QPageSize::ExactMatch);
-      }
-      if (pagedPaintDevice && (!pagedPaintDevice->setPageSize(pageSize))) {
-        qCritical().nospace()
-            << "Failed to set page size for graphics export to "
-            << pageSize.name() << ".";
-      }
+    // Process all pages in parallel since they are independent of each
+    // other. Only painting on a paged paint device (printer or PDF) needs to
+    // be done sequentially, thus in that case the workers only calculate the
+    // page layouts (which is expensive too). The results are then handled in
+    // the original page order.
+    QThreadPool pool;
+    QList<QFuture<PageOutput>> futures;
+    for (int index = 0; index < args.pages.count(); ++index) {
+      futures.append(QtConcurrent::run(&pool, &GraphicsExport::processPage,
+                                       this, args, index, outputFilePathTmpl,
+                                       deviceDpi));
+    }
 
-      // Determine output page orientation.
-      QPageLayout::Orientation pageOrientation;
-      switch (page.second->getOrientation()) {
-        case GraphicsExportSettings::Orientation::Landscape:
-          pageOrientation = QPageLayout::Landscape;
-          break;
-        case GraphicsExportSettings::Orientation::Portrait:
-          pageOrientation = QPageLayout::Portrait;
-          break;
-        case GraphicsExportSettings::Orientation::Auto:
-        default:
-          pageOrientation = getOrientation(sourceRectTransformedPx.size());
+    // Export all pages.
+    QPainter painter;
+    try {
+      for (int index = 0; index < args.pages.count(); ++index) {
+        const qreal percentPerPage = qreal(80) / args.pages.count();
+        emit progress(20 + std::ceil(percentPerPage * index), index + 1,
+                      args.pages.count());
+        const PageOutput output = futures.at(index).result();  // can throw
+        const Page& page = args.pages.at(index);
+        const PageLayout& layout = output.layout;
+        if (mAbort) {
           break;
-      }
-      if (pagedPaintDevice) {
-        QPageLayout::Orientation orientation = pageOrientation;
-        if (getOrientation(pageSize.sizePoints()) == QPageLayout::Landscape) {
-          // QPagedPaintDevice orientation seems to be swapped if page size is
-          // landscape (e.g. the Ledger/Tabloid page size).
-          if (orientation == QPageLayout::Landscape) {
-            orientation = QPageLayout::Portrait;
-          } else {
-            orientation = QPageLayout::Landscape;
-          }
-        }
-        if (!pagedPaintDevice->setPageOrientation(orientation)) {
-          qCritical() << "Failed to set page orientation for graphics export!";
-        }
-      }
-
-      // Determine DPI.
-      int dpi;
-      if (printer) {
-        dpi = printer->resolution();
-      } else if (pdfWriter) {
-        dpi = pdfWriter->resolution();
-      } else {
-        dpi = page.second->getPixmapDpi();
-      }
-      const qreal pxScale = static_cast<qreal>(dpi) / Length(25400000).toPx();
-
-      // Calculate page margins in output device pixels.
-      const QMarginsF pageMarginsPx(
-          page.second->getMarginLeft()->toInch() * dpi,
-          page.second->getMarginTop()->toInch() * dpi,
-          page.second->getMarginRight()->toInch() * dpi,
-          page.second->getMarginBottom()->toInch() * dpi);
-
-      // Determine output page rect.
-      QRect pageRectPx = pageSize.rectPixels(dpi);
-      if (getOrientation(pageRectPx.size()) != pageOrientation) {
-        pageRectPx.setSize(pageRectPx.size().transposed());
-      }
-      const QRectF pageContentRectPx = pageRectPx - pageMarginsPx;
-
-      // Calculate final scale factor.
-      const qreal scale = page.second->getScale()
-          ? pxScale
-          : qMin(pageContentRectPx.width() / sourceRectTransformedPx.width(),
-                 pageContentRectPx.height() / sourceRectTransformedPx.height());
-
-      // Determine output file path.
-      const FilePath outputFilePath = (!outputFilePathTmpl.isEmpty())
-          ? FilePath(outputFilePathTmpl.arg(index + 1))
-          : args.filePath;
-
-      // Last chance to abort before exporting.
-      emit progress(20 + std::ceil(percentPerPage * (index + qreal(0.5))),
-                    index + 1, args.pages.count());
-      if (mAbort) {
-        break;
-      }
-
-      // Prepare painter.
-      bool beginSuccess = false;
-      QScopedPointer<QSvgGenerator> svgGenerator;
-      QScopedPointer<QImage> image;
-      std::shared_ptr<QPicture> picture;
-      if (pagedPaintDevice) {
-        qDebug().nospace() << "Export page " << (index + 1) << " to "
-                           << args.printerName % args.filePath.toStr() << "...";
-        if (index == 0) {
-          beginSuccess = painter.begin(pagedPaintDevice);
-        } else {
-          beginSuccess = pagedPaintDevice->newPage();
         }
-      } else if (fileExt == "svg") {
-        qDebug().nospace() << "Export page " << (index + 1) << " as SVG to "
-                           << outputFilePath.toStr() << "...";
-        svgGenerator.reset(new QSvgGenerator());
-        svgGenerator->setTitle(mDocumentName);
-        svgGenerator->setFileName(outputFilePath.toStr());
-        svgGenerator->setSize(pageRectPx.size());
-        svgGenerator->setViewBox(pageRectPx);
-        svgGenerator->setResolution(dpi);
-        beginSuccess = painter.begin(svgGenerator.data());
-        result.writtenFiles.append(outputFilePath);
-        emit savingFile(outputFilePath);
-      } else if (!args.preview) {
-        QString target =
-            outputFilePath.isValid() ? outputFilePath.toStr() : "clipboard";
-        qDebug().nospace() << "Export page " << (index + 1) << " as pixmap to "
-                           << target << "...";
-        image.reset(
-            new QImage(pageRectPx.size(), QImage::Format_ARGB32_Premultiplied));
-        image->fill(Qt::transparent);
-        beginSuccess = painter.begin(image.data());
-        painter.setRenderHints(QPainter::Antialiasing |
-                               QPainter::SmoothPixmapTransform);
-      } else {
-        qDebug().nospace() << "Generate preview of page " << index + 1 << "...";
-        picture = std::make_shared<QPicture>();
-        beginSuccess = painter.begin(picture.get());
-        painter.setRenderHints(QPainter::Antialiasing |
-                               QPainter::SmoothPixmapTransform);
-      }
-      if (!beginSuccess) {
-        throw RuntimeError(
-            __FILE__, __LINE__,
-            "Failed to start printing - invalid printer or output file?");
-      }
 
-      // Perform the export.
-      painter.save();
-      if (page.second->getBackgroundColor().alpha() > 0) {
-        painter.fillRect(pageRectPx, page.second->getBackgroundColor());
-      }
-      painter.translate(pageContentRectPx.center().x(),
-                        pageContentRectPx.center().y());
-      painter.setTransform(sourceTransform, true);
-      painter.scale(scale, scale);
-      painter.translate(-sourceRectPx.center().x(), -sourceRectPx.center().y());
-      page.first->paint(painter, *page.second);
-      painter.restore();
-
-      // Finish painting of current page.
-      if ((!pagedPaintDevice) && (!painter.end())) {
-        throw RuntimeError(__FILE__, __LINE__, "Failed to finish painting.");
-      }
-      if (image && outputFilePath.isValid()) {
-        emit savingFile(outputFilePath);
-        if (!image->save(outputFilePath.toStr())) {
-          throw RuntimeError(
-              __FILE__, __LINE__,
-              tr("Failed to export image \"%1\". Check file permissions and "
-                 "make sure to use a supported image file extension.")
-                  .arg(outputFilePath.toNative()));
+        if (pagedPaintDevice) {
+          if (!pagedPaintDevice->setPageSize(layout.pageSize)) {
+            qCritical().nospace()
+                << "Failed to set page size for graphics export to "
+                << layout.pageSize.name() << ".";
+          }
+          QPageLayout::Orientation orientation = layout.pageOrientation;
+          if (getOrientation(layout.pageSize.sizePoints()) ==
+              QPageLayout::Landscape) {
+            // QPagedPaintDevice orientation seems to be swapped if page size
+            // is landscape (e.g. the Ledger/Tabloid page size).
+            if (orientation == QPageLayout::Landscape) {
+              orientation = QPageLayout::Portrait;
+            } else {
+              orientation = QPageLayout::Landscape;
+            }
+          }
+          if (!pagedPaintDevice->setPageOrientation(orientation)) {
+            qCritical()
+                << "Failed to set page orientation for graphics export!";
+          }
+          qDebug().nospace() << "Export page " << (index + 1) << " to "
+                             << args.printerName % args.filePath.toStr()
+                             << "...";
+          bool beginSuccess = false;
+          if (index == 0) {
+            beginSuccess = painter.begin(pagedPaintDevice);
+          } else {
+            beginSuccess = pagedPaintDevice->newPage();
+          }
+          if (!beginSuccess) {
+            throw RuntimeError(
+                __FILE__, __LINE__,
+                "Failed to start printing - invalid printer or output file?");
+          }
+          paintPage(painter, page, layout);
+        } else if (output.filePath.isValid()) {
+          result.writtenFiles.append(output.filePath);
+          emit savingFile(output.filePath);
+        } else if (output.picture) {
+          emit previewReady(index, layout.pageRectPx.size(),
+                            layout.pageContentRectPx, output.picture);
+        } else if (!output.image.isNull()) {
+          // Copy to clipboard must be performed in the main thread since
+          // QClipboard is not thread-safe. This is done by a queued
+          // signal-slot connection.
+          emit imageCopiedToClipboard(output.image, QClipboard::Clipboard);
         }
-        result.writtenFiles.append(outputFilePath);
-      } else if (image) {
-        // Copy to clipboard must be performed in the main thread since
-        // QClipboard is not thread-safe. This is done by a queued signal-slot
-        // connection.
-        emit imageCopiedToClipboard(*image, QClipboard::Clipboard);
-      }
-      if (picture) {
-        emit previewReady(index, pageRectPx.size(), pageContentRectPx, picture);
+        emit progress(20 + std::ceil(percentPerPage * (index + 1)), index + 1,
+                      args.pages.count());
       }
-      emit progress(20 + std::ceil(percentPerPage * (index + 1)), index + 1,
-                    args.pages.count());
+    } catch (...) {
+      pool.clear();
+      throw;
     }
+    pool.clear();
+    pool.waitForDone();
 
     // Finish export.
     if ((pagedPaintDevice) && (!painter.end())) {
@@ -420,6 +314,173 @@ GraphicsExport::Result GraphicsExport::run(RunArgs args) noexcept {
   }
 }
 
+GraphicsExport::PageOutput GraphicsExport::processPage(
+    const RunArgs& args, int index, const QString& outputFilePathTmpl,
+    const std::optional<int>& deviceDpi) const {
+  // Note: This method is called from worker threads, thus be careful with
+  //       calling other methods to only call thread-safe methods!
+
+  PageOutput output;
+  if (mAbort) {
+    return output;
+  }
+
+  const Page& page = args.pages.at(index);
+  output.layout = calcPageLayout(page, deviceDpi);
+  if (deviceDpi) {
+    return output;  // Painting is done sequentially by run().
+  }
+
+  // Determine output file path.
+  const QString fileExt = args.filePath.getSuffix().toLower();
+  const FilePath outputFilePath = (!outputFilePathTmpl.isEmpty())
+      ? FilePath(outputFilePathTmpl.arg(index + 1))
+      : args.filePath;
+
+  // Prepare painter.
+  const PageLayout& layout = output.layout;
+  QPainter painter;
+  bool beginSuccess = false;
+  QScopedPointer<QSvgGenerator> svgGenerator;
+  QImage image;
+  if (fileExt == "svg") {
+    qDebug().nospace() << "Export page " << (index + 1) << " as SVG to "
+                       << outputFilePath.toStr() << "...";
+    svgGenerator.reset(new QSvgGenerator());
+    svgGenerator->setTitle(mDocumentName);
+    svgGenerator->setFileName(outputFilePath.toStr());
+    svgGenerator->setSize(layout.pageRectPx.size());
+    svgGenerator->setViewBox(layout.pageRectPx);
+    svgGenerator->setResolution(layout.dpi);
+    beginSuccess = painter.begin(svgGenerator.data());
+    output.filePath = outputFilePath;
+  } else if (!args.preview) {
+    QString target =
+        outputFilePath.isValid() ? outputFilePath.toStr() : "clipboard";
+    qDebug().nospace() << "Export page " << (index + 1) << " as pixmap to "
+                       << target << "...";
+    image = QImage(layout.pageRectPx.size(),
+                   QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    beginSuccess = painter.begin(&image);
+    painter.setRenderHints(QPainter::Antialiasing |
+                           QPainter::SmoothPixmapTransform);
+  } else {
+    qDebug().nospace() << "Generate preview of page " << index + 1 << "...";
+    output.picture = std::make_shared<QPicture>();
+    beginSuccess = painter.begin(output.picture.get());
+    painter.setRenderHints(QPainter::Antialiasing |
+                           QPainter::SmoothPixmapTransform);
+  }
+  if (!beginSuccess) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        "Failed to start printing - invalid printer or output file?");
+  }
+
+  // Perform the export.
+  paintPage(painter, page, layout);
+  if (!painter.end()) {
+    throw RuntimeError(__FILE__, __LINE__, "Failed to finish painting.");
+  }
+  if ((!image.isNull()) && outputFilePath.isValid()) {
+    if (!image.save(outputFilePath.toStr())) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          tr("Failed to export image \"%1\". Check file permissions and "
+             "make sure to use a supported image file extension.")
+              .arg(outputFilePath.toNative()));
+    }
+    output.filePath = outputFilePath;
+  } else if (!image.isNull()) {
+    output.image = image;
+  }
+  return output;
+}
+
+GraphicsExport::PageLayout GraphicsExport::calcPageLayout(
+    const Page& page, const std::optional<int>& deviceDpi) noexcept {
+  PageLayout layout;
+
+  // Determine source bounding rect.
+  layout.sourceRectPx = calcSourceRect(*page.first, *page.second);
+  layout.sourceTransform = getSourceTransformation(*page.second);
+  const QRectF sourceRectTransformedPx =
+      layout.sourceTransform.mapRect(layout.sourceRectPx);
+
+  // Determine output page size.
+  if (page.second->getPageSize() && page.second->getPageSize()->isValid()) {
+    // Fixed page size is specified.
+    layout.pageSize = *page.second->getPageSize();
+  } else {
+    // Derive page size from source size.
+    Length width = Length::fromPx(sourceRectTransformedPx.width()) +
+        *page.second->getMarginLeft() + *page.second->getMarginRight();
+    Length height = Length::fromPx(sourceRectTransformedPx.height()) +
+        *page.second->getMarginTop() + *page.second->getMarginBottom();
+    layout.pageSize =
+        QPageSize(QSizeF(width.toMm(), height.toMm()), QPageSize::Millimeter,
+                  "Custom", QPageSize::ExactMatch);
+  }
+
+  // Determine output page orientation.
+  switch (page.second->getOrientation()) {
+    case GraphicsExportSettings::Orientation::Landscape:
+      layout.pageOrientation = QPageLayout::Landscape;
+      break;
+    case GraphicsExportSettings::Orientation::Portrait:
+      layout.pageOrientation = QPageLayout::Portrait;
+      break;
+    case GraphicsExportSettings::Orientation::Auto:
+    default:
+      layout.pageOrientation = getOrientation(sourceRectTransformedPx.size());
+      break;
+  }
+
+  // Determine DPI.
+  layout.dpi = deviceDpi ? (*deviceDpi) : page.second->getPixmapDpi();
+  const qreal pxScale =
+      static_cast<qreal>(layout.dpi) / Length(25400000).toPx();
+
+  // Calculate page margins in output device pixels.
+  const QMarginsF pageMarginsPx(
+      page.second->getMarginLeft()->toInch() * layout.dpi,
+      page.second->getMarginTop()->toInch() * layout.dpi,
+      page.second->getMarginRight()->toInch() * layout.dpi,
+      page.second->getMarginBottom()->toInch() * layout.dpi);
+
+  // Determine output page rect.
+  layout.pageRectPx = layout.pageSize.rectPixels(layout.dpi);
+  if (getOrientation(layout.pageRectPx.size()) != layout.pageOrientation) {
+    layout.pageRectPx.setSize(layout.pageRectPx.size().transposed());
+  }
+  layout.pageContentRectPx = layout.pageRectPx - pageMarginsPx;
+
+  // Calculate final scale factor.
+  layout.scale = page.second->getScale()
+      ? pxScale
+      : qMin(layout.pageContentRectPx.width() / sourceRectTransformedPx.width(),
+             layout.pageContentRectPx.height() /
+                 sourceRectTransformedPx.height());
+  return layout;
+}
+
+void GraphicsExport::paintPage(QPainter& painter, const Page& page,
+                               const PageLayout& layout) noexcept {
+  painter.save();
+  if (page.second->getBackgroundColor().alpha() > 0) {
+    painter.fillRect(layout.pageRectPx, page.second->getBackgroundColor());
+  }
+  painter.translate(layout.pageContentRectPx.center().x(),
+                    layout.pageContentRectPx.center().y());
+  painter.setTransform(layout.sourceTransform, true);
+  painter.scale(layout.scale, layout.scale);
+  painter.translate(-layout.sourceRectPx.center().x(),
+                    -layout.sourceRectPx.center().y());
+  page.first->paint(painter, *page.second);
+  painter.restore();
+}
+
 QTransform GraphicsExport::getSourceTransformation(
     const GraphicsExportSettings& settings) noexcept {
   QTransform t;
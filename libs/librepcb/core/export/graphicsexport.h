@@ -202,9 +202,32 @@ private:  // Types
     QPrinter::DuplexMode duplex;
     int copies;
   };
+  struct PageLayout {
+    QRectF sourceRectPx;
+    QTransform sourceTransform;
+    QPageSize pageSize;
+    QPageLayout::Orientation pageOrientation;
+    int dpi;
+    QRect pageRectPx;
+    QRectF pageContentRectPx;
+    qreal scale;
+  };
+  struct PageOutput {
+    PageLayout layout;
+    FilePath filePath;  ///< Written file (if any)
+    std::shared_ptr<QPicture> picture;  ///< Preview (if any)
+    QImage image;  ///< Image to copy into the clipboard (if any)
+  };
 
 private:  // Methods
   Result run(RunArgs args) noexcept;
+  PageOutput processPage(const RunArgs& args, int index,
+                         const QString& outputFilePathTmpl,
+                         const std::optional<int>& deviceDpi) const;
+  static PageLayout calcPageLayout(
+      const Page& page, const std::optional<int>& deviceDpi) noexcept;
+  static void paintPage(QPainter& painter, const Page& page,
+                        const PageLayout& layout) noexcept;
   static QTransform getSourceTransformation(
       const GraphicsExportSettings& settings) noexcept;
   static QRectF calcSourceRect(const GraphicsPagePainter& page,
@@ -43,7 +43,9 @@ OutputDirectoryWriter::OutputDirectoryWriter(const FilePath& dirPath) noexcept
     mIndexFilePath(dirPath.getPathTo(".librepcb-output")),
     mIndex(),
     mIndexLoaded(false),
-    mIndexModified(false) {
+    mIndexModified(false),
+    mWrittenFiles(),
+    mMutex() {
 }
 
 OutputDirectoryWriter::~OutputDirectoryWriter() noexcept {
@@ -57,6 +59,16 @@ OutputDirectoryWriter::~OutputDirectoryWriter() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QList<FilePath> OutputDirectoryWriter::getWrittenFiles(
+    const Uuid& job) const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mWrittenFiles.values(job);
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -106,6 +118,8 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
   const FilePath fp = mDirPath.getPathTo(relPath);
   emit aboutToWriteFile(fp);
 
+  QMutexLocker lock(&mMutex);
+
   if (!mIndexLoaded) {
     throw LogicError(__FILE__, __LINE__, "Output directory index not loaded.");
   }
@@ -133,18 +147,22 @@ FilePath OutputDirectoryWriter::beginWritingFile(const Uuid& job,
   return fp;
 }
 
-void OutputDirectoryWriter::removeObsoleteFiles(const Uuid& job) {
+QList<FilePath> OutputDirectoryWriter::removeObsoleteFiles(const Uuid& job) {
+  QMutexLocker lock(&mMutex);
+  QList<FilePath> removedFiles;
   const auto tmpIndex = mIndex;  // Avoid removing while iterating.
   for (auto it = tmpIndex.begin(); it != tmpIndex.end(); ++it) {
     if ((it.value() == job) &&
         (!mWrittenFiles.values(job).contains(it.key()))) {
       emit aboutToRemoveFile(it.key());
+      removedFiles.append(it.key());
       if (it.key().isExistingFile()) {
         FileUtils::removeFile(it.key());  // can throw
       }
       mIndex.remove(it.key());
     }
   }
+  return removedFiles;
 }
 
 QList<FilePath> OutputDirectoryWriter::findUnknownFiles(
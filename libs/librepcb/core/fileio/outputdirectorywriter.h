@@ -40,6 +40,11 @@ class Uuid;
 
 /**
  * @brief The OutputDirectoryWriter class
+ *
+ * The methods #beginWritingFile(), #removeObsoleteFiles() and
+ * #getWrittenFiles(const Uuid&) are thread-safe to allow running output jobs
+ * in parallel. All other methods must not be called while output jobs are
+ * running.
  */
 class OutputDirectoryWriter final : public QObject {
   Q_OBJECT
@@ -56,12 +61,13 @@ public:
   const QMultiHash<Uuid, FilePath>& getWrittenFiles() const noexcept {
     return mWrittenFiles;
   }
+  QList<FilePath> getWrittenFiles(const Uuid& job) const noexcept;
 
   // General Methods
   bool loadIndex();
   void storeIndex();
   FilePath beginWritingFile(const Uuid& job, const QString& relPath);
-  void removeObsoleteFiles(const Uuid& job);
+  QList<FilePath> removeObsoleteFiles(const Uuid& job);
   QList<FilePath> findUnknownFiles(const QSet<Uuid>& knownJobs) const;
   void removeUnknownFiles(const QList<FilePath>& files);
 
@@ -79,6 +85,7 @@ private:  // Data
   bool mIndexLoaded;
   bool mIndexModified;
   QMultiHash<Uuid, FilePath> mWrittenFiles;
+  mutable QMutex mMutex;  ///< Protects #mIndex and #mWrittenFiles
 };
 
 /*******************************************************************************
@@ -47,7 +47,10 @@ namespace fb = fontobene;
 
 StrokeFont::StrokeFont(const FilePath& fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
+  : QObject(nullptr),
+    mFilePath(fontFilePath),
+    mGlyphCache(10000),
+    mLayoutCache(100000) {
   // load the font in another thread because it takes some time to load it
   qDebug() << "Start loading stroke font " << mFilePath.toNative()
            << "in worker thread...";
@@ -89,6 +92,18 @@ QVector<Path> StrokeFont::stroke(const QString& text,
                                  Point& topRight) const noexcept {
   accessor();  // block until the font is loaded. TODO: abort instead of
                // waiting?
+
+  // Try to get the layout from the cache.
+  const LayoutKey key{text, *height, letterSpacing, lineSpacing, align};
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const LayoutData* data = mLayoutCache.object(key)) {
+      bottomLeft = data->bottomLeft;
+      topRight = data->topRight;
+      return data->paths;
+    }
+  }
+
   QVector<Path> paths;
   Length totalWidth;
   QVector<QPair<QVector<Path>, Length>> lines =
@@ -137,6 +152,14 @@ QVector<Path> StrokeFont::stroke(const QString& text,
     topRight.setY(totalHeight / 2);
   }
 
+  // Add the layout to the cache. The cost is the number of paths to limit
+  // the memory consumption rather than the number of texts.
+  {
+    QMutexLocker lock(&mCacheMutex);
+    mLayoutCache.insert(key, new LayoutData{paths, bottomLeft, topRight},
+                        paths.count() + 1);
+  }
+
   return paths;
 }
 
@@ -161,22 +184,19 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
   Length offset = 0;
   width = 0;  // same as offset, but without last letter spacing
   for (int i = 0; i < text.length(); ++i) {
-    Length glyphSpacing;
-    QVector<Path> glyphPaths = strokeGlyph(text.at(i), height, glyphSpacing);
-    if (!glyphPaths.isEmpty()) {
-      Point bottomLeft, topRight;
-      computeBoundingRect(glyphPaths, bottomLeft, topRight);
+    const GlyphData glyph = getGlyph(text.at(i), height);
+    if (!glyph.paths.isEmpty()) {
       Length shift =
-          (i == 0) ? -bottomLeft.getX() : 0;  // left-align first character
-      foreach (const Path& p, glyphPaths) {
+          (i == 0) ? -glyph.bottomLeft.getX() : 0;  // left-align first char
+      foreach (const Path& p, glyph.paths) {
         paths.append(p.translated(Point(offset + shift, Length(0))));
       }
-      width = offset + topRight.getX() +
+      width = offset + glyph.topRight.getX() +
           shift;  // do *not* count glyph spacing as width!
-      offset = width + glyphSpacing + letterSpacing;
-    } else if (glyphSpacing != 0) {
+      offset = width + glyph.spacing + letterSpacing;
+    } else if (glyph.spacing != 0) {
       // it's a whitespace-only glyph -> count additional glyph spacing as width
-      width = offset + glyphSpacing;
+      width = offset + glyph.spacing;
       offset = width + letterSpacing;
     }
   }
@@ -186,24 +206,42 @@ QVector<Path> StrokeFont::strokeLine(const QString& text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar& glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
+  const GlyphData data = getGlyph(glyph, height);
+  spacing = data.spacing;
+  return data.paths;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+StrokeFont::GlyphData StrokeFont::getGlyph(
+    const QChar& glyph, const PositiveLength& height) const noexcept {
+  QMutexLocker lock(&mCacheMutex);
+  const QPair<char16_t, qint64> key(glyph.unicode(), height->toNm());
+  if (const GlyphData* data = mGlyphCache.object(key)) {
+    return *data;
+  }
+
+  GlyphData data;
   try {
     qreal glyphSpacing = 0;
     QVector<fb::Polyline> polylines =
         accessor().getAllPolylinesOfGlyph(glyph.unicode(),
                                           &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
+    data.spacing = convertLength(height, glyphSpacing);
+    data.paths = polylines2paths(polylines, height);
+    if (!data.paths.isEmpty()) {
+      computeBoundingRect(data.paths, data.bottomLeft, data.topRight);
+    }
   } catch (const fb::Exception& e) {
     qWarning().nospace() << "Failed to load stroke font glyph " << glyph << ".";
-    spacing = 0;
-    return QVector<Path>();
+    data = GlyphData();
   }
+  mGlyphCache.insert(key, new GlyphData(data));
+  return data;
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
 void StrokeFont::fontLoaded() noexcept {
   accessor();  // trigger the message about loading succeeded or failed
 }
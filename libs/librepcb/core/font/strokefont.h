@@ -52,6 +52,11 @@ namespace librepcb {
 
 /**
  * @brief The StrokeFont class
+ *
+ * Stroked glyphs (per glyph and height) and the layout of whole texts are
+ * cached since the same texts are typically stroked over and over again
+ * (e.g. names and values of all devices on a board). All stroke methods are
+ * thread-safe.
  */
 class StrokeFont final : public QObject {
   Q_OBJECT
@@ -83,7 +88,41 @@ public:
   // Operator Overloadings
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
-private:
+private:  // Types
+  struct GlyphData {
+    QVector<Path> paths;
+    Length spacing;
+    Point bottomLeft;
+    Point topRight;
+  };
+  struct LayoutKey {
+    QString text;
+    Length height;
+    Length letterSpacing;
+    Length lineSpacing;
+    Alignment align;
+
+    bool operator==(const LayoutKey& rhs) const noexcept {
+      return (text == rhs.text) && (height == rhs.height) &&
+          (letterSpacing == rhs.letterSpacing) &&
+          (lineSpacing == rhs.lineSpacing) && (align == rhs.align);
+    }
+    friend std::size_t qHash(const LayoutKey& key,
+                             std::size_t seed = 0) noexcept {
+      return qHashMulti(seed, key.text, key.height, key.letterSpacing,
+                        key.lineSpacing,
+                        static_cast<int>(key.align.toQtAlign()));
+    }
+  };
+  struct LayoutData {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+  };
+
+private:  // Methods
+  GlyphData getGlyph(const QChar& glyph,
+                     const PositiveLength& height) const noexcept;
   void fontLoaded() noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
   static QVector<Path> polylines2paths(
@@ -105,6 +144,11 @@ private:  // Data
   mutable std::shared_ptr<fontobene::Font> mFont;
   mutable QScopedPointer<fontobene::GlyphListCache> mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+
+  // Caches
+  mutable QMutex mCacheMutex;
+  mutable QCache<QPair<char16_t, qint64>, GlyphData> mGlyphCache;
+  mutable QCache<LayoutKey, LayoutData> mLayoutCache;
 };
 
 /*******************************************************************************
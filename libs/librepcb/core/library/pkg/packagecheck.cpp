@@ -30,6 +30,8 @@
 
 #include <QtCore>
 
+#include <numeric>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -318,69 +320,107 @@ void PackageCheck::checkPadsPackagePadUuid(MsgList& msgs) const {
   }
 }
 
+static bool rectsOverlap(const QRectF& a, const QRectF& b) noexcept {
+  // In contrast to QRectF::intersects(), touching rects are considered as
+  // overlapping, and empty rects are supported too.
+  return (a.left() <= b.right()) && (b.left() <= a.right()) &&
+      (a.top() <= b.bottom()) && (b.top() <= a.bottom());
+}
+
 void PackageCheck::checkPadsClearanceToPads(MsgList& msgs) const {
   Length clearance(200000);  // 200 µm
   Length tolerance(10);  // 0.01 µm, to avoid rounding issues
 
+  struct PadData {
+    std::shared_ptr<const FootprintPad> pad;
+    std::shared_ptr<const PackagePad> pkgPad;
+    QPainterPath copperPx;
+    QPainterPath clearancePx;
+    QRectF clearanceRectPx;
+  };
+
   // Check all footprints.
   for (auto itFtp = mPackage.getFootprints().begin();
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    // Check all pads.
-    for (auto itPad1 = (*itFtp).getPads().begin();
-         itPad1 != (*itFtp).getPads().end(); ++itPad1) {
-      std::shared_ptr<const FootprintPad> pad1 = itPad1.ptr();
-      std::shared_ptr<const PackagePad> pkgPad1 = pad1->getPackagePadUuid()
-          ? mPackage.getPads().find(*pad1->getPackagePadUuid())
+    // Determine the geometry of all pads.
+    QVector<PadData> pads;
+    for (auto it = (*itFtp).getPads().begin(); it != (*itFtp).getPads().end();
+         ++it) {
+      PadData data;
+      data.pad = it.ptr();
+      data.pkgPad = data.pad->getPackagePadUuid()
+          ? mPackage.getPads().find(*data.pad->getPackagePadUuid())
           : nullptr;
-      const Transform pad1Transform(pad1->getPosition(), pad1->getRotation());
-      const Length pad1Clearance =
-          std::max(clearance, *pad1->getCopperClearance()) - tolerance;
-      const QPainterPath pad1CopperPx =
-          pad1Transform.mapPx(pad1->getGeometry().toFilledQPainterPathPx());
-      const QPainterPath pad1ClearancePx =
-          pad1Transform.mapPx(pad1->getGeometry()
-                                  .withOffset(pad1Clearance)
-                                  .toFilledQPainterPathPx());
-
-      // Compare with all pads *after* pad1 to avoid duplicate messages!
-      // So, don't initialize the iterator with begin() but with pad1 + 1.
-      auto itPad2 = itPad1;
-      for (++itPad2; itPad2 != (*itFtp).getPads().end(); ++itPad2) {
-        std::shared_ptr<const FootprintPad> pad2 = itPad2.ptr();
-        std::shared_ptr<const PackagePad> pkgPad2 = pad2->getPackagePadUuid()
-            ? mPackage.getPads().find(*pad2->getPackagePadUuid())
-            : nullptr;
-        const Transform pad2Transform(pad2->getPosition(), pad2->getRotation());
-        const Length pad2Clearance =
-            std::max(clearance, *pad2->getCopperClearance()) - tolerance;
-        const QPainterPath pad2CopperPx =
-            pad2Transform.mapPx(pad2->getGeometry().toFilledQPainterPathPx());
-        const QPainterPath pad2ClearancePx =
-            pad2Transform.mapPx(pad2->getGeometry()
-                                    .withOffset(pad2Clearance)
-                                    .toFilledQPainterPathPx());
-
-        // Only warn if both pads have copper on the same board side.
-        if ((pad1->getComponentSide() == pad2->getComponentSide()) ||
-            (pad1->isTht()) || (pad2->isTht())) {
-          // Only warn if both pads have different net signal, or one of them
-          // is unconnected (an unconnected pad is considered as a different
-          // net signal).
-          if ((pad1->getPackagePadUuid() != pad2->getPackagePadUuid()) ||
-              (!pad1->getPackagePadUuid()) || (!pad2->getPackagePadUuid())) {
-            // Now check if the clearance is really too small.
-            if (pad1CopperPx.intersects(pad2CopperPx)) {
-              msgs.append(std::make_shared<MsgOverlappingPads>(
-                  footprint, pad1, pkgPad1 ? *pkgPad1->getName() : QString(),
-                  pad2, pkgPad2 ? *pkgPad2->getName() : QString()));
-            } else if (pad1ClearancePx.intersects(pad2CopperPx) ||
-                       pad1CopperPx.intersects(pad2ClearancePx)) {
-              msgs.append(std::make_shared<MsgPadClearanceViolation>(
-                  footprint, pad1, pkgPad1 ? *pkgPad1->getName() : QString(),
-                  pad2, pkgPad2 ? *pkgPad2->getName() : QString(), clearance));
-            }
+      const Transform transform(data.pad->getPosition(),
+                                data.pad->getRotation());
+      const Length padClearance =
+          std::max(clearance, *data.pad->getCopperClearance()) - tolerance;
+      data.copperPx = transform.mapPx(
+          data.pad->getGeometry().toFilledQPainterPathPx());
+      data.clearancePx =
+          transform.mapPx(data.pad->getGeometry()
+                              .withOffset(padClearance)
+                              .toFilledQPainterPathPx());
+      data.clearanceRectPx = data.clearancePx.boundingRect();
+      pads.append(data);
+    }
+
+    // Find all pairs of pads with overlapping clearance bounding rects by
+    // sweeping over the pads sorted by their left edge. Only these pairs
+    // need to be checked with the expensive geometry operations. Each pair
+    // is ordered by the pad indices to get the same messages in the same
+    // order as when comparing each pad with all pads *after* it.
+    QVector<int> order(pads.count());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&pads](int a, int b) {
+      return pads.at(a).clearanceRectPx.left() <
+          pads.at(b).clearanceRectPx.left();
+    });
+    QVector<std::pair<int, int>> pairs;
+    for (int i = 0; i < order.count(); ++i) {
+      const QRectF& rect1 = pads.at(order.at(i)).clearanceRectPx;
+      for (int k = i + 1; k < order.count(); ++k) {
+        const QRectF& rect2 = pads.at(order.at(k)).clearanceRectPx;
+        if (rect2.left() > rect1.right()) {
+          break;  // All subsequent pads are even more right.
+        }
+        if (rectsOverlap(rect1, rect2)) {
+          pairs.append(std::make_pair(std::min(order.at(i), order.at(k)),
+                                      std::max(order.at(i), order.at(k))));
+        }
+      }
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    // Check all pairs of nearby pads.
+    for (const auto& pair : pairs) {
+      const PadData& pad1 = pads.at(pair.first);
+      const PadData& pad2 = pads.at(pair.second);
+
+      // Only warn if both pads have copper on the same board side.
+      if ((pad1.pad->getComponentSide() == pad2.pad->getComponentSide()) ||
+          (pad1.pad->isTht()) || (pad2.pad->isTht())) {
+        // Only warn if both pads have different net signal, or one of them
+        // is unconnected (an unconnected pad is considered as a different
+        // net signal).
+        if ((pad1.pad->getPackagePadUuid() != pad2.pad->getPackagePadUuid()) ||
+            (!pad1.pad->getPackagePadUuid()) ||
+            (!pad2.pad->getPackagePadUuid())) {
+          // Now check if the clearance is really too small.
+          if (pad1.copperPx.intersects(pad2.copperPx)) {
+            msgs.append(std::make_shared<MsgOverlappingPads>(
+                footprint, pad1.pad,
+                pad1.pkgPad ? *pad1.pkgPad->getName() : QString(), pad2.pad,
+                pad2.pkgPad ? *pad2.pkgPad->getName() : QString()));
+          } else if (pad1.clearancePx.intersects(pad2.copperPx) ||
+                     pad1.copperPx.intersects(pad2.clearancePx)) {
+            msgs.append(std::make_shared<MsgPadClearanceViolation>(
+                footprint, pad1.pad,
+                pad1.pkgPad ? *pad1.pkgPad->getName() : QString(), pad2.pad,
+                pad2.pkgPad ? *pad2.pkgPad->getName() : QString(),
+                clearance));
           }
         }
       }
@@ -389,13 +429,37 @@ void PackageCheck::checkPadsClearanceToPads(MsgList& msgs) const {
 }
 
 void PackageCheck::checkPadsClearanceToLegend(MsgList& msgs) const {
+  // Legend areas with their bounding rects, to check each pad only against
+  // the merged legend polygons in its neighbourhood. Polygons not overlapping
+  // the pad's bounding rect cannot affect the merged area within it, so the
+  // result is the same as with the merged legend of the whole footprint.
+  typedef QVector<std::pair<QPainterPath, QRectF>> Areas;
+  auto overlaps = [](const QPainterPath& path, const Areas& areas) {
+    const QRectF rect = path.boundingRect();
+    QPainterPath merged;
+    for (const auto& area : areas) {
+      if (rectsOverlap(rect, area.second)) {
+        merged.addPath(area.first);
+      }
+    }
+    return (!merged.isEmpty()) && path.intersects(merged);
+  };
+
   for (auto itFtp = mPackage.getFootprints().begin();
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    QPainterPath topLegend;
-    QPainterPath botLegend;
+    Areas topLegend;
+    Areas botLegend;
     for (const Polygon& polygon : footprint->getPolygons()) {
+      Areas* areas = nullptr;
+      if (polygon.getLayer() == Layer::topLegend()) {
+        areas = &topLegend;
+      } else if (polygon.getLayer() == Layer::botLegend()) {
+        areas = &botLegend;
+      } else {
+        continue;
+      }
       QPen pen(Qt::NoPen);
       if (polygon.getLineWidth() > 0) {
         pen.setStyle(Qt::SolidLine);
@@ -405,13 +469,9 @@ void PackageCheck::checkPadsClearanceToLegend(MsgList& msgs) const {
       if (polygon.isFilled() && polygon.getPath().isClosed()) {
         brush.setStyle(Qt::SolidPattern);
       }
-      QPainterPath area = Toolbox::shapeFromPath(
+      const QPainterPath area = Toolbox::shapeFromPath(
           polygon.getPath().toQPainterPathPx(), pen, brush);
-      if (polygon.getLayer() == Layer::topLegend()) {
-        topLegend.addPath(area);
-      } else if (polygon.getLayer() == Layer::botLegend()) {
-        botLegend.addPath(area);
-      }
+      areas->append(std::make_pair(area, area.boundingRect()));
     }
 
     for (auto it = (*itFtp).getPads().begin(); it != (*itFtp).getPads().end();
@@ -427,13 +487,12 @@ void PackageCheck::checkPadsClearanceToLegend(MsgList& msgs) const {
           transform.mapPx(pad->getGeometry()
                               .withOffset(clearance - tolerance)
                               .toFilledQPainterPathPx());
-      if (pad->isOnLayer(Layer::topCopper()) &&
-          stopMask.intersects(topLegend)) {
+      if (pad->isOnLayer(Layer::topCopper()) && overlaps(stopMask, topLegend)) {
         msgs.append(std::make_shared<MsgPadOverlapsWithLegend>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
       } else if (pad->isOnLayer(Layer::botCopper()) &&
-                 stopMask.intersects(botLegend)) {
+                 overlaps(stopMask, botLegend)) {
         msgs.append(std::make_shared<MsgPadOverlapsWithLegend>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
@@ -96,6 +96,7 @@ Board::Board(Project& project,
     mSilkscreenLayersBot({&Layer::botLegend(), &Layer::botNames()}),
     mDrcMessageApprovalsVersion(Application::getFileFormatVersion()),
     mDrcMessageApprovals(),
+    mDrcMessageApprovalKeys(),
     mSupportedDrcMessageApprovals() {
   if (mDirectoryName.isEmpty()) {
     throw LogicError(__FILE__, __LINE__);
@@ -307,10 +308,16 @@ void Board::loadDrcMessageApprovals(
     const Version& version, const QSet<SExpression>& approvals) noexcept {
   mDrcMessageApprovalsVersion = version;
   mDrcMessageApprovals = approvals;
+  mDrcMessageApprovalKeys.clear();
+  foreach (const SExpression& approval, mDrcMessageApprovals) {
+    mDrcMessageApprovalKeys.insert(RuleCheckMessage::calcApprovalKey(approval),
+                                   approval);
+  }
 }
 
-bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
-                                      bool partialRun) noexcept {
+bool Board::updateDrcMessageApprovals(
+    const QSet<RuleCheckMessage::ApprovalKey>& approvals,
+    bool partialRun) noexcept {
   mSupportedDrcMessageApprovals |= approvals;
 
   // Don't remove obsolete approvals after a partial DRC run because we would
@@ -321,31 +328,40 @@ bool Board::updateDrcMessageApprovals(QSet<SExpression> approvals,
 
   // When running the DRC the first time after a file format upgrade, remove
   // all approvals not occurring anymore to clean up obsolete approvals from
-  // the board file.
-  if (mDrcMessageApprovalsVersion < Application::getFileFormatVersion()) {
+  // the board file. Otherwise remove only approvals which disappeared during
+  // this session to avoid removing approvals added by newer minor application
+  // versions.
+  const bool upgraded =
+      (mDrcMessageApprovalsVersion < Application::getFileFormatVersion());
+  if (upgraded) {
     mDrcMessageApprovalsVersion = Application::getFileFormatVersion();
-    mDrcMessageApprovals &= approvals;
-    return true;
   }
-
-  // Remove only approvals which disappeared during this session to avoid
-  // removing approvals added by newer minor application versions.
-  approvals =
-      mDrcMessageApprovals - (mSupportedDrcMessageApprovals - approvals);
-  if (approvals != mDrcMessageApprovals) {
-    mDrcMessageApprovals = approvals;
-    return true;
+  bool modified = upgraded;
+  for (auto it = mDrcMessageApprovalKeys.begin();
+       it != mDrcMessageApprovalKeys.end();) {
+    const bool remove = (!approvals.contains(it.key())) &&
+        (upgraded || mSupportedDrcMessageApprovals.contains(it.key()));
+    if (remove) {
+      mDrcMessageApprovals.remove(it.value());
+      it = mDrcMessageApprovalKeys.erase(it);
+      modified = true;
+    } else {
+      ++it;
+    }
   }
-
-  return false;
+  return modified;
 }
 
 void Board::setDrcMessageApproved(const SExpression& approval,
                                   bool approved) noexcept {
+  const RuleCheckMessage::ApprovalKey key =
+      RuleCheckMessage::calcApprovalKey(approval);
   if (approved) {
     mDrcMessageApprovals.insert(approval);
+    mDrcMessageApprovalKeys.insert(key, approval);
   } else {
     mDrcMessageApprovals.remove(approval);
+    mDrcMessageApprovalKeys.remove(key);
   }
 }
 
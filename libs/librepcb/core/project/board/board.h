@@ -25,6 +25,7 @@
  ******************************************************************************/
 #include "../../fileio/filepath.h"
 #include "../../fileio/transactionaldirectory.h"
+#include "../../rulecheck/rulecheckmessage.h"
 #include "../../types/elementname.h"
 #include "../../types/length.h"
 #include "../../types/lengthunit.h"
@@ -172,8 +173,9 @@ public:
   }
   void loadDrcMessageApprovals(const Version& version,
                                const QSet<SExpression>& approvals) noexcept;
-  bool updateDrcMessageApprovals(QSet<SExpression> approvals,
-                                 bool partialRun) noexcept;
+  bool updateDrcMessageApprovals(
+      const QSet<RuleCheckMessage::ApprovalKey>& approvals,
+      bool partialRun) noexcept;
   void setDrcMessageApproved(const SExpression& approval,
                              bool approved) noexcept;
 
@@ -303,7 +305,8 @@ private:
   // DRC
   Version mDrcMessageApprovalsVersion;
   QSet<SExpression> mDrcMessageApprovals;
-  QSet<SExpression> mSupportedDrcMessageApprovals;
+  QHash<RuleCheckMessage::ApprovalKey, SExpression> mDrcMessageApprovalKeys;
+  QSet<RuleCheckMessage::ApprovalKey> mSupportedDrcMessageApprovals;
 
   // items
   QMap<Uuid, BI_Device*> mDeviceInstances;
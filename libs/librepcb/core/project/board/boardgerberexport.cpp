@@ -32,6 +32,7 @@
 #include "../../library/pkg/footprintpad.h"
 #include "../../library/pkg/package.h"
 #include "../../library/pkg/packagepad.h"
+#include "../../utils/scopeguard.h"
 #include "../../utils/transform.h"
 #include "../circuit/componentinstance.h"
 #include "../circuit/componentsignalinstance.h"
@@ -51,6 +52,7 @@
 #include "items/bi_stroketext.h"
 #include "items/bi_via.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -65,6 +67,145 @@ static bool operator<(const BoardGerberExport::LayerPair& lhs,
       ((lhs.first == rhs.first) && (Layer::lessThan(lhs.second, rhs.second)));
 }
 
+/*******************************************************************************
+ *  Class BoardGerberExport::GerberRecorder
+ ******************************************************************************/
+
+/**
+ * @brief Records draw calls to replay them on any number of
+ *        ::librepcb::GerberGenerator objects
+ *
+ * The arguments are copied, so the recorded calls don't depend on the board.
+ */
+class BoardGerberExport::GerberRecorder final {
+public:
+  using Function = GerberGenerator::Function;
+
+  void drawLine(const Point& start, const Point& end,
+                const UnsignedLength& width, Function function,
+                const std::optional<QString>& net,
+                const QString& component) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.drawLine(start, end, width, function, net, component);
+    });
+  }
+  void drawPathOutline(const Path& path, const UnsignedLength& lineWidth,
+                       Function function, const std::optional<QString>& net,
+                       const QString& component) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.drawPathOutline(path, lineWidth, function, net, component);
+    });
+  }
+  void drawPathArea(const Path& path, Function function,
+                    const std::optional<QString>& net,
+                    const QString& component) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.drawPathArea(path, function, net, component);
+    });
+  }
+  void flashCircle(const Point& pos, const PositiveLength& dia,
+                   Function function, const std::optional<QString>& net,
+                   const QString& component, const QString& pin,
+                   const QString& signal) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.flashCircle(pos, dia, function, net, component, pin, signal);
+    });
+  }
+  void flashRect(const Point& pos, const PositiveLength& w,
+                 const PositiveLength& h, const UnsignedLength& radius,
+                 const Angle& rot, Function function,
+                 const std::optional<QString>& net, const QString& component,
+                 const QString& pin, const QString& signal) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.flashRect(pos, w, h, radius, rot, function, net, component, pin,
+                    signal);
+    });
+  }
+  void flashObround(const Point& pos, const PositiveLength& w,
+                    const PositiveLength& h, const Angle& rot,
+                    Function function, const std::optional<QString>& net,
+                    const QString& component, const QString& pin,
+                    const QString& signal) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.flashObround(pos, w, h, rot, function, net, component, pin, signal);
+    });
+  }
+  void flashOctagon(const Point& pos, const PositiveLength& w,
+                    const PositiveLength& h, const UnsignedLength& radius,
+                    const Angle& rot, Function function,
+                    const std::optional<QString>& net, const QString& component,
+                    const QString& pin, const QString& signal) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.flashOctagon(pos, w, h, radius, rot, function, net, component, pin,
+                       signal);
+    });
+  }
+  void flashOutline(const Point& pos, const StraightAreaPath& path,
+                    const Angle& rot, Function function,
+                    const std::optional<QString>& net, const QString& component,
+                    const QString& pin, const QString& signal) noexcept {
+    mCalls.append([=](GerberGenerator& gen) {
+      gen.flashOutline(pos, path, rot, function, net, component, pin, signal);
+    });
+  }
+
+  void replay(GerberGenerator& gen) const noexcept {
+    for (const auto& call : mCalls) {
+      call(gen);
+    }
+  }
+
+private:
+  QVector<std::function<void(GerberGenerator&)>> mCalls;
+};
+
+/*******************************************************************************
+ *  Class BoardGerberExport::ExcellonRecorder
+ ******************************************************************************/
+
+/**
+ * @brief Records drill calls to replay them on any number of
+ *        ::librepcb::ExcellonGenerator objects
+ */
+class BoardGerberExport::ExcellonRecorder final {
+public:
+  using Function = ExcellonGenerator::Function;
+
+  void drill(const Point& pos, const PositiveLength& dia, bool plated,
+             Function function) noexcept {
+    mCalls.append([=](ExcellonGenerator& gen) {
+      gen.drill(pos, dia, plated, function);
+    });
+  }
+  void drill(const NonEmptyPath& path, const PositiveLength& dia, bool plated,
+             Function function) noexcept {
+    mCalls.append([=](ExcellonGenerator& gen) {
+      gen.drill(path, dia, plated, function);
+    });
+  }
+
+  void replay(ExcellonGenerator& gen) const noexcept {
+    for (const auto& call : mCalls) {
+      call(gen);
+    }
+  }
+
+private:
+  QVector<std::function<void(ExcellonGenerator&)>> mCalls;
+};
+
+/*******************************************************************************
+ *  Class BoardGerberExport::Snapshot
+ ******************************************************************************/
+
+class BoardGerberExport::Snapshot final {
+public:
+  QHash<const Layer*, GerberRecorder> layers;
+  ExcellonRecorder pthDrills;
+  ExcellonRecorder npthDrills;
+  QMap<LayerPair, ExcellonRecorder> blindBuriedDrills;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -74,11 +215,13 @@ BoardGerberExport::BoardGerberExport(const Board& board) noexcept
     mBoard(board),
     mRemoveObsoleteFiles(true),
     mBeforeWriteCallback(),
+    mSnapshot(),
     mCreationDateTime(QDateTime::currentDateTime()),
     mProjectName(*mProject.getName()),
     mCurrentInnerCopperLayer(0),
     mCurrentStartLayer(nullptr),
-    mCurrentEndLayer(nullptr) {
+    mCurrentEndLayer(nullptr),
+    mCurrentSnapshot() {
   // If the project contains multiple boards, add the board name to the
   // Gerber file metadata as well to distinguish between the different boards.
   if (mProject.getBoards().count() > 1) {
@@ -111,28 +254,132 @@ void BoardGerberExport::setBeforeWriteCallback(BeforeWriteCallback cb) {
   mBeforeWriteCallback = cb;
 }
 
+void BoardGerberExport::setSnapshot(
+    std::shared_ptr<const Snapshot> snapshot) noexcept {
+  mSnapshot = snapshot;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
+std::shared_ptr<const BoardGerberExport::Snapshot>
+    BoardGerberExport::createSnapshot() const {
+  std::shared_ptr<Snapshot> snapshot = std::make_shared<Snapshot>();
+
+  // Determine all layers which might be exported.
+  QVector<const Layer*> layers = {
+      &Layer::boardOutlines(),  &Layer::boardCutouts(),
+      &Layer::topCopper(),      &Layer::botCopper(),
+      &Layer::topStopMask(),    &Layer::botStopMask(),
+      &Layer::topSolderPaste(), &Layer::botSolderPaste(),
+  };
+  for (int i = 1; i <= mBoard.getInnerLayerCount(); ++i) {
+    if (const Layer* layer = Layer::innerCopper(i)) {
+      layers.append(layer);
+    }
+  }
+  foreach (const Layer* layer,
+           mBoard.getSilkscreenLayersTop() + mBoard.getSilkscreenLayersBot()) {
+    if (!layers.contains(layer)) {
+      layers.append(layer);
+    }
+  }
+
+  // Record the layers in parallel since they are independent of each other
+  // and only read from the board.
+  std::vector<GerberRecorder> recorders(layers.count());
+  QList<QFuture<void>> futures;
+  for (int i = 0; i < layers.count(); ++i) {
+    GerberRecorder& recorder = recorders.at(i);
+    const Layer* layer = layers.at(i);
+    futures.append(QtConcurrent::run(
+        [this, &recorder, layer]() { drawLayer(recorder, *layer); }));
+  }
+  drawPthDrills(snapshot->pthDrills);
+  drawNpthDrills(snapshot->npthDrills);
+  const auto vias = getBlindBuriedVias();
+  for (auto it = vias.begin(); it != vias.end(); it++) {
+    ExcellonRecorder& recorder = snapshot->blindBuriedDrills[it.key()];
+    foreach (const BI_Via* via, it.value()) {
+      recorder.drill(via->getPosition(), via->getDrillDiameter(), true,
+                     ExcellonGenerator::Function::ViaDrill);
+    }
+  }
+
+  // Wait until all threads are finished before throwing any exception, since
+  // the threads access local variables.
+  for (QFuture<void>& future : futures) {
+    try {
+      future.waitForFinished();  // can throw
+    } catch (...) {
+      // Will be rethrown below.
+    }
+  }
+  for (int i = 0; i < layers.count(); ++i) {
+    futures[i].waitForFinished();  // can throw
+    snapshot->layers.insert(layers.at(i), recorders.at(i));
+  }
+  return snapshot;
+}
+
 void BoardGerberExport::exportPcbLayers(
     const BoardFabricationOutputSettings& settings) const {
   mWrittenFiles.clear();
 
-  exportDrillsMerged(settings);
-  exportDrillsNpth(settings);
-  exportDrillsPth(settings);
-  exportDrillsBlindBuried(settings);
-  exportLayerBoardOutlines(settings);
-  exportLayerTopCopper(settings);
-  exportLayerInnerCopper(settings);
-  exportLayerBottomCopper(settings);
-  exportLayerTopSolderMask(settings);
-  exportLayerBottomSolderMask(settings);
-  exportLayerTopSilkscreen(settings);
-  exportLayerBottomSilkscreen(settings);
-  exportLayerTopSolderPaste(settings);
-  exportLayerBottomSolderPaste(settings);
+  // Draw from the provided snapshot, or create a temporary one.
+  mCurrentSnapshot = mSnapshot ? mSnapshot : createSnapshot();  // can throw
+  auto snapshotGuard = scopeGuard([this]() { mCurrentSnapshot.reset(); });
+
+  // Determine all output files. This has to be done sequentially since the
+  // file paths depend on the current layer attributes.
+  QList<OutputFileJob> jobs;
+  exportDrillsMerged(settings, jobs);
+  exportDrillsNpth(settings, jobs);
+  exportDrillsPth(settings, jobs);
+  exportDrillsBlindBuried(settings, jobs);
+  exportLayerBoardOutlines(settings, jobs);
+  exportLayerTopCopper(settings, jobs);
+  exportLayerInnerCopper(settings, jobs);
+  exportLayerBottomCopper(settings, jobs);
+  exportLayerTopSolderMask(settings, jobs);
+  exportLayerBottomSolderMask(settings, jobs);
+  exportLayerTopSilkscreen(settings, jobs);
+  exportLayerBottomSilkscreen(settings, jobs);
+  exportLayerTopSolderPaste(settings, jobs);
+  exportLayerBottomSolderPaste(settings, jobs);
+
+  // Generate the content of all files in parallel since the generators are
+  // independent of each other and only read from the snapshot.
+  QList<QFuture<QByteArray>> futures;
+  for (const OutputFileJob& job : jobs) {
+    futures.append(job.generator ? QtConcurrent::run(job.generator)
+                                 : QFuture<QByteArray>());
+  }
+
+  // Wait until all threads are finished before writing any file or throwing
+  // any exception, since the threads access this object.
+  for (QFuture<QByteArray>& future : futures) {
+    try {
+      future.waitForFinished();  // can throw
+    } catch (...) {
+      // Will be rethrown below.
+    }
+  }
+
+  // Write (or remove obsolete) files sequentially in the original order to
+  // get deterministic behavior.
+  for (int i = 0; i < jobs.count(); ++i) {
+    const OutputFileJob& job = jobs.at(i);
+    if (job.generator) {
+      const QByteArray content = futures[i].result();  // can throw
+      trackFileBeforeWrite(job.filePath);  // can throw
+      FileUtils::writeFile(job.filePath, content);  // can throw
+    } else if (mRemoveObsoleteFiles && job.filePath.isExistingFile() &&
+               (!mWrittenFiles.contains(job.filePath))) {
+      FileUtils::removeFile(job.filePath);  // can throw
+    }
+  }
 }
 
 void BoardGerberExport::exportComponentLayer(BoardSide side,
@@ -298,279 +545,312 @@ void BoardGerberExport::exportComponentLayer(BoardSide side,
  ******************************************************************************/
 
 void BoardGerberExport::exportDrillsMerged(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrills());
   if (settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Mixed);
-    drawPthDrills(*gen);
-    drawNpthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this, &settings]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          BoardGerberExport::createExcellonGenerator(
+              settings, ExcellonGenerator::Plating::Mixed);
+      mCurrentSnapshot->pthDrills.replay(*gen);
+      mCurrentSnapshot->npthDrills.replay(*gen);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsNpth(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsNpth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::No);
-    drawNpthDrills(*gen);
-
-    // Note that separate NPTH drill files could lead to issues with some PCB
-    // manufacturers, even if it's empty in many cases. However, we generate the
-    // NPTH file even if there are no NPTH drills since it could also lead to
-    // unexpected behavior if the file is generated only conditionally. See
-    // https://github.com/LibrePCB/LibrePCB/issues/998. If the PCB manufacturer
-    // doesn't support a separate NPTH file, the user shall enable the
-    // "merge PTH and NPTH drills"  option.
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this, &settings]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          BoardGerberExport::createExcellonGenerator(
+              settings, ExcellonGenerator::Plating::No);
+      mCurrentSnapshot->npthDrills.replay(*gen);
+
+      // Note that separate NPTH drill files could lead to issues with some PCB
+      // manufacturers, even if it's empty in many cases. However, we generate
+      // the NPTH file even if there are no NPTH drills since it could also
+      // lead to unexpected behavior if the file is generated only
+      // conditionally. See https://github.com/LibrePCB/LibrePCB/issues/998.
+      // If the PCB manufacturer doesn't support a separate NPTH file, the
+      // user shall enable the "merge PTH and NPTH drills"  option.
+      gen->generate();
+      return gen->toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsPth(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixDrillsPth());
   if (!settings.getMergeDrillFiles()) {
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    drawPthDrills(*gen);
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this, &settings]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          BoardGerberExport::createExcellonGenerator(
+              settings, ExcellonGenerator::Plating::Yes);
+      mCurrentSnapshot->pthDrills.replay(*gen);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportDrillsBlindBuried(
-    const BoardFabricationOutputSettings& settings) const {
-  auto vias = getBlindBuriedVias();
-  for (auto it = vias.begin(); it != vias.end(); it++) {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
+  const auto& drills = mCurrentSnapshot->blindBuriedDrills;
+  for (auto it = drills.begin(); it != drills.end(); it++) {
     mCurrentStartLayer = it.key().first;
     mCurrentEndLayer = it.key().second;
     const FilePath fp = getOutputFilePath(
         settings.getOutputBasePath() % settings.getSuffixDrillsBlindBuried());
-    std::unique_ptr<ExcellonGenerator> gen =
-        BoardGerberExport::createExcellonGenerator(
-            settings, ExcellonGenerator::Plating::Yes);
-    foreach (const BI_Via* via, it.value()) {
-      gen->drill(via->getPosition(), via->getDrillDiameter(), true,
-                 ExcellonGenerator::Function::ViaDrill);
-    }
-    gen->generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen->saveToFile(fp);
+    const ExcellonRecorder& recorder = it.value();
+    auto generator = [this, &settings, &recorder]() {
+      std::unique_ptr<ExcellonGenerator> gen =
+          BoardGerberExport::createExcellonGenerator(
+              settings, ExcellonGenerator::Plating::Yes);
+      recorder.replay(*gen);
+      gen->generate();
+      return gen->toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
   }
+  mCurrentStartLayer = nullptr;
+  mCurrentEndLayer = nullptr;
 }
 
 void BoardGerberExport::exportLayerBoardOutlines(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixOutlines());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionOutlines(false);
-  drawLayer(gen, Layer::boardOutlines());
-  drawLayer(gen, Layer::boardCutouts());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generator = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionOutlines(false);
+    drawLayer(gen, Layer::boardOutlines());
+    drawLayer(gen, Layer::boardCutouts());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  jobs.append(OutputFileJob{fp, generator});
 }
 
 void BoardGerberExport::exportLayerTopCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperTop());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::topCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generator = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionCopper(1, GerberGenerator::CopperSide::Top,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::topCopper());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  jobs.append(OutputFileJob{fp, generator});
 }
 
 void BoardGerberExport::exportLayerBottomCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                   settings.getSuffixCopperBot());
-  GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                      *mProject.getVersion());
-  gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
-                            GerberGenerator::CopperSide::Bottom,
-                            GerberGenerator::Polarity::Positive);
-  drawLayer(gen, Layer::botCopper());
-  gen.generate();
-  trackFileBeforeWrite(fp);  // can throw
-  gen.saveToFile(fp);
+  auto generator = [this]() {
+    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                        *mProject.getVersion());
+    gen.setFileFunctionCopper(mBoard.getInnerLayerCount() + 2,
+                              GerberGenerator::CopperSide::Bottom,
+                              GerberGenerator::Polarity::Positive);
+    drawLayer(gen, Layer::botCopper());
+    gen.generate();
+    return gen.toByteArray();
+  };
+  jobs.append(OutputFileJob{fp, generator});
 }
 
 void BoardGerberExport::exportLayerInnerCopper(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   for (int i = 1; i <= mBoard.getInnerLayerCount(); ++i) {
     mCurrentInnerCopperLayer = i;  // used for attribute provider
     FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                     settings.getSuffixCopperInner());
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
-                              GerberGenerator::Polarity::Positive);
-    if (const Layer* layer = Layer::innerCopper(i)) {
-      drawLayer(gen, *layer);
-    } else {
+    const Layer* layer = Layer::innerCopper(i);
+    if (!layer) {
       throw LogicError(__FILE__, __LINE__, "Unknown inner copper layer.");
     }
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
+    auto generator = [this, i, layer]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionCopper(i + 1, GerberGenerator::CopperSide::Inner,
+                                GerberGenerator::Polarity::Positive);
+      drawLayer(gen, *layer);
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
   }
   mCurrentInnerCopperLayer = 0;
 }
 
 void BoardGerberExport::exportLayerTopSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskTop());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Top,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSolderMask(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderMaskBot());
   if (mBoard.getSolderResist()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
-                                  GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionSolderMask(GerberGenerator::BoardSide::Bottom,
+                                    GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerTopSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenTop());
-  const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersTop();
+  const QVector<const Layer*> layers = mBoard.getSilkscreenLayersTop();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::topStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this, layers]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Top,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::topStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSilkscreen(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSilkscreenBot());
-  const QVector<const Layer*>& layers = mBoard.getSilkscreenLayersBot();
+  const QVector<const Layer*> layers = mBoard.getSilkscreenLayersBot();
   if (layers.count() > 0) {  // don't export silkscreen if no layers selected
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
-                              GerberGenerator::Polarity::Positive);
-    foreach (const Layer* layer, layers) {
-      drawLayer(gen, *layer);
-    }
-    gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
-    drawLayer(gen, Layer::botStopMask());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this, layers]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionLegend(GerberGenerator::BoardSide::Bottom,
+                                GerberGenerator::Polarity::Positive);
+      foreach (const Layer* layer, layers) {
+        drawLayer(gen, *layer);
+      }
+      gen.setLayerPolarity(GerberGenerator::Polarity::Negative);
+      drawLayer(gen, Layer::botStopMask());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerTopSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteTop());
   if (settings.getEnableSolderPasteTop()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::topSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Top,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::topSolderPaste());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
 void BoardGerberExport::exportLayerBottomSolderPaste(
-    const BoardFabricationOutputSettings& settings) const {
+    const BoardFabricationOutputSettings& settings,
+    QList<OutputFileJob>& jobs) const {
   const FilePath fp = getOutputFilePath(settings.getOutputBasePath() %
                                         settings.getSuffixSolderPasteBot());
   if (settings.getEnableSolderPasteBot()) {
-    GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
-                        *mProject.getVersion());
-    gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
-                             GerberGenerator::Polarity::Positive);
-    drawLayer(gen, Layer::botSolderPaste());
-    gen.generate();
-    trackFileBeforeWrite(fp);  // can throw
-    gen.saveToFile(fp);
-  } else if (mRemoveObsoleteFiles && fp.isExistingFile() &&
-             (!mWrittenFiles.contains(fp))) {
-    FileUtils::removeFile(fp);
+    auto generator = [this]() {
+      GerberGenerator gen(mCreationDateTime, mProjectName, mBoard.getUuid(),
+                          *mProject.getVersion());
+      gen.setFileFunctionPaste(GerberGenerator::BoardSide::Bottom,
+                               GerberGenerator::Polarity::Positive);
+      drawLayer(gen, Layer::botSolderPaste());
+      gen.generate();
+      return gen.toByteArray();
+    };
+    jobs.append(OutputFileJob{fp, generator});
+  } else {
+    jobs.append(OutputFileJob{fp, nullptr});
   }
 }
 
-int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
+int BoardGerberExport::drawNpthDrills(ExcellonRecorder& gen) const {
   int count = 0;
 
   // footprint holes
@@ -593,7 +873,7 @@ int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
   return count;
 }
 
-int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
+int BoardGerberExport::drawPthDrills(ExcellonRecorder& gen) const {
   int count = 0;
 
   // footprint pads
@@ -644,6 +924,15 @@ QMap<BoardGerberExport::LayerPair, QList<const BI_Via*>>
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen,
                                   const Layer& layer) const {
+  Q_ASSERT(mCurrentSnapshot);
+  auto it = mCurrentSnapshot->layers.constFind(&layer);
+  if (it != mCurrentSnapshot->layers.constEnd()) {
+    it->replay(gen);
+  }
+}
+
+void BoardGerberExport::drawLayer(GerberRecorder& gen,
+                                  const Layer& layer) const {
   // draw footprints incl. pads
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     Q_ASSERT(device);
@@ -746,7 +1035,7 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
   }
 }
 
-void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via,
+void BoardGerberExport::drawVia(GerberRecorder& gen, const BI_Via& via,
                                 const Layer& layer,
                                 const QString& netName) const {
   const bool drawCopper = via.getVia().isOnLayer(layer);
@@ -770,7 +1059,7 @@ void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via,
   }
 }
 
-void BoardGerberExport::drawDevice(GerberGenerator& gen,
+void BoardGerberExport::drawDevice(GerberRecorder& gen,
                                    const BI_Device& device,
                                    const Layer& layer) const {
   GerberGenerator::Function graphicsFunction = std::nullopt;
@@ -860,7 +1149,7 @@ void BoardGerberExport::drawDevice(GerberGenerator& gen,
   }
 }
 
-void BoardGerberExport::drawFootprintPad(GerberGenerator& gen,
+void BoardGerberExport::drawFootprintPad(GerberRecorder& gen,
                                          const BI_FootprintPad& pad,
                                          const Layer& layer) const {
   const QMap<FootprintPad::Function, GerberAttribute::ApertureFunction>
@@ -979,7 +1268,7 @@ void BoardGerberExport::drawFootprintPad(GerberGenerator& gen,
   }
 }
 
-void BoardGerberExport::drawPolygon(GerberGenerator& gen, const Layer& layer,
+void BoardGerberExport::drawPolygon(GerberRecorder& gen, const Layer& layer,
                                     const Path& outline,
                                     const UnsignedLength& lineWidth, bool fill,
                                     GerberGenerator::Function function,
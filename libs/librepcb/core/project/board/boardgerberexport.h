@@ -65,6 +65,16 @@ public:
   typedef std::pair<const Layer*, const Layer*> LayerPair;
   typedef std::function<void(const FilePath&)> BeforeWriteCallback;
 
+  /**
+   * @brief Flattened board geometry drawn by #exportPcbLayers()
+   *
+   * Contains copies of all primitives drawn to the Gerber and Excellon files,
+   * thus it does not reference the board anymore. It is immutable and can be
+   * shared by several exports (even in different threads) as long as the
+   * board is not modified.
+   */
+  class Snapshot;
+
   // Constructors / Destructor
   BoardGerberExport() = delete;
   BoardGerberExport(const BoardGerberExport& other) = delete;
@@ -81,8 +91,10 @@ public:
   // Setters
   void setRemoveObsoleteFiles(bool remove);
   void setBeforeWriteCallback(BeforeWriteCallback cb);
+  void setSnapshot(std::shared_ptr<const Snapshot> snapshot) noexcept;
 
   // General Methods
+  std::shared_ptr<const Snapshot> createSnapshot() const;
   void exportPcbLayers(const BoardFabricationOutputSettings& settings) const;
   void exportComponentLayer(BoardSide side, const Uuid& assemblyVariant,
                             const FilePath& filePath) const;
@@ -91,44 +103,62 @@ public:
   BoardGerberExport& operator=(const BoardGerberExport& rhs) = delete;
 
 private:
+  class GerberRecorder;
+  class ExcellonRecorder;
+
+  /**
+   * @brief An output file to be generated by #exportPcbLayers()
+   */
+  struct OutputFileJob {
+    FilePath filePath;
+    std::function<QByteArray()> generator;  ///< Null to remove obsolete file
+  };
+
   // Private Methods
-  void exportDrillsMerged(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsNpth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsPth(const BoardFabricationOutputSettings& settings) const;
-  void exportDrillsBlindBuried(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBoardOutlines(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerInnerCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerBottomCopper(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
+  void exportDrillsMerged(const BoardFabricationOutputSettings& settings,
+                          QList<OutputFileJob>& jobs) const;
+  void exportDrillsNpth(const BoardFabricationOutputSettings& settings,
+                        QList<OutputFileJob>& jobs) const;
+  void exportDrillsPth(const BoardFabricationOutputSettings& settings,
+                       QList<OutputFileJob>& jobs) const;
+  void exportDrillsBlindBuried(const BoardFabricationOutputSettings& settings,
+                               QList<OutputFileJob>& jobs) const;
+  void exportLayerBoardOutlines(const BoardFabricationOutputSettings& settings,
+                                QList<OutputFileJob>& jobs) const;
+  void exportLayerTopCopper(const BoardFabricationOutputSettings& settings,
+                            QList<OutputFileJob>& jobs) const;
+  void exportLayerInnerCopper(const BoardFabricationOutputSettings& settings,
+                              QList<OutputFileJob>& jobs) const;
+  void exportLayerBottomCopper(const BoardFabricationOutputSettings& settings,
+                               QList<OutputFileJob>& jobs) const;
+  void exportLayerTopSolderMask(const BoardFabricationOutputSettings& settings,
+                                QList<OutputFileJob>& jobs) const;
   void exportLayerBottomSolderMask(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QList<OutputFileJob>& jobs) const;
+  void exportLayerTopSilkscreen(const BoardFabricationOutputSettings& settings,
+                                QList<OutputFileJob>& jobs) const;
   void exportLayerBottomSilkscreen(
-      const BoardFabricationOutputSettings& settings) const;
-  void exportLayerTopSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QList<OutputFileJob>& jobs) const;
+  void exportLayerTopSolderPaste(const BoardFabricationOutputSettings& settings,
+                                 QList<OutputFileJob>& jobs) const;
   void exportLayerBottomSolderPaste(
-      const BoardFabricationOutputSettings& settings) const;
+      const BoardFabricationOutputSettings& settings,
+      QList<OutputFileJob>& jobs) const;
 
-  int drawNpthDrills(ExcellonGenerator& gen) const;
-  int drawPthDrills(ExcellonGenerator& gen) const;
+  int drawNpthDrills(ExcellonRecorder& gen) const;
+  int drawPthDrills(ExcellonRecorder& gen) const;
   QMap<LayerPair, QList<const BI_Via*> > getBlindBuriedVias() const;
   void drawLayer(GerberGenerator& gen, const Layer& layer) const;
-  void drawVia(GerberGenerator& gen, const BI_Via& via, const Layer& layer,
+  void drawLayer(GerberRecorder& gen, const Layer& layer) const;
+  void drawVia(GerberRecorder& gen, const BI_Via& via, const Layer& layer,
                const QString& netName) const;
-  void drawDevice(GerberGenerator& gen, const BI_Device& device,
+  void drawDevice(GerberRecorder& gen, const BI_Device& device,
                   const Layer& layer) const;
-  void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad,
+  void drawFootprintPad(GerberRecorder& gen, const BI_FootprintPad& pad,
                         const Layer& layer) const;
-  void drawPolygon(GerberGenerator& gen, const Layer& layer,
+  void drawPolygon(GerberRecorder& gen, const Layer& layer,
                    const Path& outline, const UnsignedLength& lineWidth,
                    bool fill, GerberGenerator::Function function,
                    const std::optional<QString>& net,
@@ -152,11 +182,13 @@ private:
   const Board& mBoard;
   bool mRemoveObsoleteFiles;
   BeforeWriteCallback mBeforeWriteCallback;
+  std::shared_ptr<const Snapshot> mSnapshot;
   QDateTime mCreationDateTime;
   QString mProjectName;
   mutable int mCurrentInnerCopperLayer;
   mutable const Layer* mCurrentStartLayer;
   mutable const Layer* mCurrentEndLayer;
+  mutable std::shared_ptr<const Snapshot> mCurrentSnapshot;
   mutable QVector<FilePath> mWrittenFiles;
 };
 
@@ -48,7 +48,7 @@ namespace librepcb {
 
 BoardClipperPathGenerator::BoardClipperPathGenerator(
     const PositiveLength& maxArcTolerance) noexcept
-  : mMaxArcTolerance(maxArcTolerance), mPaths() {
+  : mMaxArcTolerance(maxArcTolerance), mPaths(), mAreas() {
 }
 
 BoardClipperPathGenerator::~BoardClipperPathGenerator() noexcept {
@@ -58,7 +58,13 @@ BoardClipperPathGenerator::~BoardClipperPathGenerator() noexcept {
  *  Getters
  ******************************************************************************/
 
-void BoardClipperPathGenerator::takePathsTo(ClipperLib::Paths& out) noexcept {
+const ClipperLib::Paths& BoardClipperPathGenerator::getPaths() {
+  uniteAreas();  // can throw
+  return mPaths;
+}
+
+void BoardClipperPathGenerator::takePathsTo(ClipperLib::Paths& out) {
+  uniteAreas();  // can throw
   out = mPaths;
   mPaths.clear();
 }
@@ -226,11 +232,8 @@ void BoardClipperPathGenerator::addStopMaskOpenings(const Data& data,
         if (offset != 0) {
           geometry = geometry.withOffset(offset);
         }
-        ClipperHelpers::unite(
-            mPaths,
-            ClipperHelpers::convert(padTransform.map(geometry.toOutlines()),
-                                    mMaxArcTolerance),
-            ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+        addArea(ClipperHelpers::convert(
+            padTransform.map(geometry.toOutlines()), mMaxArcTolerance));
       }
     }
   }
@@ -254,9 +257,7 @@ void BoardClipperPathGenerator::addVia(const Data::Via& via,
   if (size > 0) {
     const Path sceneOutline =
         Path::circle(PositiveLength(size)).translated(via.position);
-    ClipperHelpers::unite(
-        mPaths, {ClipperHelpers::convert(sceneOutline, mMaxArcTolerance)},
-        ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    addArea({ClipperHelpers::convert(sceneOutline, mMaxArcTolerance)});
   }
 }
 
@@ -266,17 +267,13 @@ void BoardClipperPathGenerator::addTrace(const Data::Trace& trace,
   if (width > 0) {
     const Path sceneOutline = Path::obround(
         trace.startPosition, trace.endPosition, PositiveLength(width));
-    ClipperHelpers::unite(
-        mPaths, {ClipperHelpers::convert(sceneOutline, mMaxArcTolerance)},
-        ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    addArea({ClipperHelpers::convert(sceneOutline, mMaxArcTolerance)});
   }
 }
 
 void BoardClipperPathGenerator::addPlane(const QVector<Path>& fragments) {
   foreach (const Path& p, fragments) {
-    ClipperHelpers::unite(mPaths,
-                          {ClipperHelpers::convert(p, mMaxArcTolerance)},
-                          ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    addArea({ClipperHelpers::convert(p, mMaxArcTolerance)});
   }
 }
 
@@ -287,9 +284,7 @@ void BoardClipperPathGenerator::addPolygon(const Path& path,
   const Length totalWidth = lineWidth + offset * 2;
   if ((lineWidth > 0) && (totalWidth > 0)) {
     QVector<Path> paths = path.toOutlineStrokes(PositiveLength(totalWidth));
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    addArea(ClipperHelpers::convert(paths, mMaxArcTolerance));
   }
 
   // Area (only fill closed paths, for consistency with the appearance in
@@ -298,9 +293,12 @@ void BoardClipperPathGenerator::addPolygon(const Path& path,
     ClipperLib::Paths paths = {ClipperHelpers::convert(path, mMaxArcTolerance)};
     if (offset != 0) {
       ClipperHelpers::offset(paths, offset, mMaxArcTolerance);
+    } else {
+      // Filled areas use the even-odd fill type, but areas are united with
+      // the non-zero fill type, so normalize it first.
+      ClipperHelpers::unite(paths, ClipperLib::pftEvenOdd);
     }
-    ClipperHelpers::unite(mPaths, paths, ClipperLib::pftEvenOdd,
-                          ClipperLib::pftEvenOdd);
+    addArea(paths);
   }
 }
 
@@ -316,16 +314,12 @@ void BoardClipperPathGenerator::addCircle(const Data::Circle& circle,
   if (circle.lineWidth > 0) {
     QVector<Path> paths =
         path.toOutlineStrokes(PositiveLength(*circle.lineWidth));
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    addArea(ClipperHelpers::convert(paths, mMaxArcTolerance));
   }
 
   // Area.
   if (circle.filled) {
-    ClipperHelpers::unite(mPaths,
-                          {ClipperHelpers::convert(path, mMaxArcTolerance)},
-                          ClipperLib::pftEvenOdd, ClipperLib::pftEvenOdd);
+    addArea({ClipperHelpers::convert(path, mMaxArcTolerance)});
   }
 }
 
@@ -337,9 +331,7 @@ void BoardClipperPathGenerator::addStrokeText(
                             strokeText.mirror);
   foreach (const Path path, transform.map(strokeText.paths)) {
     QVector<Path> paths = path.toOutlineStrokes(width);
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(paths, mMaxArcTolerance),
-                          ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    addArea(ClipperHelpers::convert(paths, mMaxArcTolerance));
   }
 }
 
@@ -348,11 +340,8 @@ void BoardClipperPathGenerator::addHole(const PositiveLength& diameter,
                                         const Transform& transform,
                                         const Length& offset) {
   const PositiveLength width(std::max(*diameter + offset + offset, Length(1)));
-  ClipperHelpers::unite(
-      mPaths,
-      ClipperHelpers::convert(transform.map(*path).toOutlineStrokes(width),
-                              mMaxArcTolerance),
-      ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+  addArea(ClipperHelpers::convert(
+      transform.map(*path).toOutlineStrokes(width), mMaxArcTolerance));
 }
 
 void BoardClipperPathGenerator::addPad(const Data::Pad& pad, const Layer& layer,
@@ -362,25 +351,42 @@ void BoardClipperPathGenerator::addPad(const Data::Pad& pad, const Layer& layer,
     if (offset != 0) {
       geometry = geometry.withOffset(offset);
     }
-    ClipperHelpers::unite(
-        mPaths,
-        ClipperHelpers::convert(transform.map(geometry.toOutlines()),
-                                mMaxArcTolerance),
-        ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+    addArea(ClipperHelpers::convert(transform.map(geometry.toOutlines()),
+                                    mMaxArcTolerance));
 
     // Also add each hole to ensure correct copper areas even if
     // the pad outline is too small or invalid.
     for (const PadHole& hole : geometry.getHoles()) {
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(
-                                transform.map(hole.getPath()->toOutlineStrokes(
-                                    hole.getDiameter())),
-                                mMaxArcTolerance),
-                            ClipperLib::pftEvenOdd, ClipperLib::pftNonZero);
+      addArea(ClipperHelpers::convert(
+          transform.map(hole.getPath()->toOutlineStrokes(hole.getDiameter())),
+          mMaxArcTolerance));
     }
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardClipperPathGenerator::addArea(ClipperLib::Paths area) {
+  mAreas.append(std::move(area));
+}
+
+void BoardClipperPathGenerator::uniteAreas() {
+  if (mAreas.isEmpty()) {
+    return;
+  }
+  const ClipperLib::Paths paths =
+      ClipperHelpers::uniteBatched(mAreas, ClipperLib::pftNonZero);
+  mAreas.clear();
+  if (mPaths.empty()) {
+    mPaths = paths;
+  } else {
+    ClipperHelpers::unite(mPaths, paths, ClipperLib::pftEvenOdd,
+                          ClipperLib::pftNonZero);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
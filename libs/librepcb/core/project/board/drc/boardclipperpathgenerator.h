@@ -54,8 +54,8 @@ public:
   ~BoardClipperPathGenerator() noexcept;
 
   // Getters
-  const ClipperLib::Paths& getPaths() const noexcept { return mPaths; }
-  void takePathsTo(ClipperLib::Paths& out) noexcept;
+  const ClipperLib::Paths& getPaths();
+  void takePathsTo(ClipperLib::Paths& out);
 
   // General Methods
   void addCopper(const Data& data, const Layer& layer,
@@ -78,9 +78,18 @@ public:
   void addPad(const Data::Pad& pad, const Layer& layer,
               const Length& offset = Length(0));
 
+private:  // Methods
+  void addArea(ClipperLib::Paths area);
+  void uniteAreas();
+
 private:  // Data
   PositiveLength mMaxArcTolerance;
   ClipperLib::Paths mPaths;
+
+  /// Added areas (evaluated with non-zero fill type) not yet merged into
+  /// #mPaths. They are united in one batch when accessing the paths, which is
+  /// much faster than merging each area on its own.
+  QVector<ClipperLib::Paths> mAreas;
 };
 
 /*******************************************************************************
@@ -22,21 +22,12 @@
  ******************************************************************************/
 #include "electricalrulecheck.h"
 
-#include "../../library/cmp/component.h"
-#include "../../library/cmp/componentsignal.h"
-#include "../circuit/circuit.h"
-#include "../circuit/componentinstance.h"
-#include "../circuit/componentsignalinstance.h"
-#include "../circuit/netclass.h"
-#include "../circuit/netsignal.h"
 #include "../project.h"
-#include "../schematic/items/si_netpoint.h"
 #include "../schematic/items/si_netsegment.h"
-#include "../schematic/items/si_symbol.h"
-#include "../schematic/items/si_symbolpin.h"
 #include "../schematic/schematic.h"
 #include "electricalrulecheckmessages.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -44,157 +35,322 @@
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+template <typename T>
+static const T* findItem(const QMap<Uuid, T>* items, const Uuid& uuid) {
+  if (items) {
+    auto it = items->constFind(uuid);
+    if (it != items->constEnd()) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+template <typename T, typename F>
+static RuleCheckMessageList reuseOrCheck(
+    const T& item, const T* previousItem,
+    const QHash<Uuid, RuleCheckMessageList>& previousMessages,
+    QHash<Uuid, RuleCheckMessageList>& messages, int& checkedItems, F check) {
+  RuleCheckMessageList msgs;
+  auto it = previousMessages.constFind(item.uuid);
+  if (previousItem && (*previousItem == item) &&
+      (it != previousMessages.constEnd())) {
+    msgs = *it;  // Unmodified item, reuse the messages of the previous run.
+  } else {
+    msgs = check(item);
+    ++checkedItems;
+  }
+  messages.insert(item.uuid, msgs);
+  return msgs;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-ElectricalRuleCheck::ElectricalRuleCheck(const Project& project) noexcept
-  : mProject(project) {
+ElectricalRuleCheck::ElectricalRuleCheck(QObject* parent) noexcept
+  : QObject(parent), mRunning(false) {
 }
 
 ElectricalRuleCheck::~ElectricalRuleCheck() noexcept {
+  mFuture.waitForFinished();
 }
 
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
-RuleCheckMessageList ElectricalRuleCheck::runChecks() const {
-  mOpenNetSignals.clear();
+void ElectricalRuleCheck::start(const Project& project) noexcept {
+  if (mProject != &project) {
+    mSchematics.clear();
+    mModifiedSchematics.clear();
+    mProject = &project;
+  }
 
-  RuleCheckMessageList msgs;
-  checkNetClasses(msgs);
-  checkNetSignals(msgs);
-  checkComponents(msgs);
-  checkSchematics(msgs);
-  return msgs;
+  // Copy all relevant data for thread-safe access. Schematics which were not
+  // modified since the previous run are taken from the cache.
+  std::shared_ptr<Data> data = std::make_shared<Data>();
+  data->loadCircuit(project.getCircuit());
+  QHash<Uuid, Data::Schematic> schematics;
+  foreach (const Schematic* schematic, project.getSchematics()) {
+    const Uuid& uuid = schematic->getUuid();
+    auto it = mSchematics.constFind(uuid);
+    if ((it != mSchematics.constEnd()) &&
+        (!mModifiedSchematics.contains(uuid))) {
+      data->schematics.append(*it);
+    } else {
+      const auto type = Qt::UniqueConnection;
+      const auto slot = &ElectricalRuleCheck::schematicModified;
+      connect(schematic, &Schematic::symbolAdded, this, slot, type);
+      connect(schematic, &Schematic::symbolRemoved, this, slot, type);
+      connect(schematic, &Schematic::netSegmentAdded, this, slot, type);
+      connect(schematic, &Schematic::netSegmentRemoved, this, slot, type);
+      foreach (const SI_NetSegment* segment, schematic->getNetSegments()) {
+        connect(segment, &SI_NetSegment::netPointsAndNetLinesAdded, this,
+                slot, type);
+        connect(segment, &SI_NetSegment::netPointsAndNetLinesRemoved, this,
+                slot, type);
+        connect(segment, &SI_NetSegment::netLabelAdded, this, slot, type);
+        connect(segment, &SI_NetSegment::netLabelRemoved, this, slot, type);
+      }
+      data->schematics.append(Data::loadSchematic(*schematic));
+    }
+    schematics.insert(uuid, data->schematics.last());
+  }
+  mSchematics = schematics;
+  mModifiedSchematics.clear();
+
+  start(data);
+}
+
+void ElectricalRuleCheck::start(std::shared_ptr<Data> data) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mRunning) {
+    // The running worker checks the new data as soon as it's finished, which
+    // avoids blocking the caller. Previously pending data is outdated.
+    mPendingData = data;
+  } else {
+    mRunning = true;
+    mFuture = QtConcurrent::run(&ElectricalRuleCheck::run, this, data);
+  }
+}
+
+RuleCheckMessageList ElectricalRuleCheck::waitForFinished() const noexcept {
+  const auto result = mFuture.result();
+
+  // The caller probably expects all signals to be emitted after calling this
+  // method, but due to multithreading this might not be the case yet. Thus
+  // trying to enforce it now.
+  for (int i = 0; i < 5; i++) qApp->processEvents();
+
+  return result;
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void ElectricalRuleCheck::checkNetClasses(RuleCheckMessageList& msgs) const {
-  // Don't warn if there's only one netclass, as we need one to be used as
-  // default when adding a new wire.
-  if (mProject.getCircuit().getNetClasses().count() <= 1) {
-    return;
+void ElectricalRuleCheck::schematicModified() noexcept {
+  if (const Schematic* schematic = qobject_cast<const Schematic*>(sender())) {
+    mModifiedSchematics.insert(schematic->getUuid());
+  } else if (const SI_NetSegment* segment =
+                 qobject_cast<const SI_NetSegment*>(sender())) {
+    mModifiedSchematics.insert(segment->getSchematic().getUuid());
   }
+}
 
-  foreach (const NetClass* netClass, mProject.getCircuit().getNetClasses()) {
-    if (!netClass->isUsed()) {
-      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(*netClass));
+RuleCheckMessageList ElectricalRuleCheck::run(
+    std::shared_ptr<Data> data) noexcept {
+  while (true) {
+    data->resolve();
+    const RuleCheckMessageList msgs = runChecks(data);
+    QMutexLocker lock(&mMutex);
+    if (mPendingData) {
+      // Newer data available, the result of this run is already outdated.
+      data = std::move(mPendingData);
+      mPendingData.reset();
+      continue;
     }
+    mRunning = false;
+    // Emit with the mutex locked to guarantee that the results of subsequent
+    // runs are emitted in the right order.
+    emit finished(msgs);
+    return msgs;
   }
 }
 
-void ElectricalRuleCheck::checkNetSignals(RuleCheckMessageList& msgs) const {
-  foreach (const NetSignal* net, mProject.getCircuit().getNetSignals()) {
-    // Raise a warning if the net signal is connected to less then two component
-    // signals. But do not count component signals of schematic-only components
-    // since these are just "virtual" connections, i.e. not represented by a
-    // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
-    const QList<ComponentSignalInstance*>& sigs = net->getComponentSignals();
-    int registeredRealComponentCount = sigs.count();
-    if (registeredRealComponentCount >= 2) {  // Optimization
-      foreach (const ComponentSignalInstance* sig, sigs) {
-        if (sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
-          --registeredRealComponentCount;
-        }
-      }
-    }
-    if (registeredRealComponentCount < 2) {
-      mOpenNetSignals.insert(net);
-      msgs.append(std::make_shared<ErcMsgOpenNet>(*net));
+RuleCheckMessageList ElectricalRuleCheck::runChecks(
+    std::shared_ptr<const Data> data) noexcept {
+  QElapsedTimer timer;
+  timer.start();
+
+  const Data* previous = mPreviousData.get();
+  int checkedItems = 0;
+  int totalItems = 0;
+
+  RuleCheckMessageList msgs = checkNetClasses(*data);
+
+  QSet<Uuid> openNetSignals;
+  QHash<Uuid, RuleCheckMessageList> netSignalMessages;
+  for (const Data::NetSignal& net : data->netSignals) {
+    if (net.realComponentSignals < 2) {
+      openNetSignals.insert(net.uuid);
     }
+    msgs += reuseOrCheck(
+        net, findItem(previous ? &previous->netSignals : nullptr, net.uuid),
+        mNetSignalMessages, netSignalMessages, checkedItems, &checkNetSignal);
+    ++totalItems;
   }
-}
 
-void ElectricalRuleCheck::checkComponents(RuleCheckMessageList& msgs) const {
-  foreach (const ComponentInstance* cmp,
-           mProject.getCircuit().getComponentInstances()) {
-    checkComponentSignals(*cmp, msgs);
-
-    // Check for unplaced gates.
-    for (const ComponentSymbolVariantItem& gate :
-         cmp->getSymbolVariant().getSymbolItems()) {
-      if (!cmp->getSymbols().contains(gate.getUuid())) {
-        if (gate.isRequired()) {
-          msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(*cmp, gate));
-        } else {
-          msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(*cmp, gate));
-        }
+  QHash<Uuid, RuleCheckMessageList> componentMessages;
+  for (const Data::Component& cmp : data->components) {
+    msgs += reuseOrCheck(
+        cmp, findItem(previous ? &previous->components : nullptr, cmp.uuid),
+        mComponentMessages, componentMessages, checkedItems, &checkComponent);
+    ++totalItems;
+  }
+
+  QHash<Uuid, const Data::Schematic*> previousSchematics;
+  if (previous) {
+    for (const Data::Schematic& schematic : previous->schematics) {
+      previousSchematics.insert(schematic.uuid, &schematic);
+    }
+  }
+  QHash<Uuid, RuleCheckMessageList> symbolMessages;
+  QHash<Uuid, RuleCheckMessageList> netSegmentMessages;
+  for (const Data::Schematic& schematic : data->schematics) {
+    const Data::Schematic* previousSchematic =
+        previousSchematics.value(schematic.uuid);
+    for (const Data::Symbol& symbol : schematic.symbols) {
+      msgs += reuseOrCheck(
+          symbol,
+          findItem(previousSchematic ? &previousSchematic->symbols : nullptr,
+                   symbol.uuid),
+          mSymbolMessages, symbolMessages, checkedItems, &checkSymbol);
+      ++totalItems;
+    }
+    for (const Data::NetSegment& segment : schematic.netSegments) {
+      // The check depends on whether the net is open or not, so the segment
+      // has to be checked again if that has changed.
+      const bool openNet = openNetSignals.contains(segment.net);
+      const Data::NetSegment* previousSegment = nullptr;
+      if (openNet == mOpenNetSignals.contains(segment.net)) {
+        previousSegment = findItem(
+            previousSchematic ? &previousSchematic->netSegments : nullptr,
+            segment.uuid);
       }
+      msgs += reuseOrCheck(segment, previousSegment, mNetSegmentMessages,
+                           netSegmentMessages, checkedItems,
+                           [openNet](const Data::NetSegment& seg) {
+                             return checkNetSegment(seg, openNet);
+                           });
+      ++totalItems;
     }
   }
+
+  // Memorize state for the next run.
+  mPreviousData = data;
+  mOpenNetSignals = openNetSignals;
+  mNetSignalMessages = netSignalMessages;
+  mComponentMessages = componentMessages;
+  mSymbolMessages = symbolMessages;
+  mNetSegmentMessages = netSegmentMessages;
+
+  qDebug() << "ERC succeeded after" << timer.elapsed() << "ms, checked"
+           << checkedItems << "of" << totalItems << "items.";
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkComponentSignals(
-    const ComponentInstance& cmp, RuleCheckMessageList& msgs) const {
-  foreach (const ComponentSignalInstance* sig, cmp.getSignals()) {
-    // Check for forced net name conflict.
-    const QString netName =
-        sig->getNetSignal() ? (*sig->getNetSignal()->getName()) : QString();
-    if ((sig->getCompSignal().isRequired()) && (!sig->getNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(*sig));
-    } else if (sig->isNetSignalNameForced() &&
-               (sig->getForcedNetSignalName() != netName)) {
-      msgs.append(std::make_shared<ErcMsgForcedNetSignalNameConflict>(*sig));
+RuleCheckMessageList ElectricalRuleCheck::checkNetClasses(
+    const Data& data) noexcept {
+  RuleCheckMessageList msgs;
+
+  // Don't warn if there's only one netclass, as we need one to be used as
+  // default when adding a new wire.
+  if (data.netClasses.count() <= 1) {
+    return msgs;
+  }
+
+  for (const Data::NetClass& netClass : data.netClasses) {
+    if (!netClass.used) {
+      msgs.append(std::make_shared<ErcMsgUnusedNetClass>(netClass));
     }
   }
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkSchematics(RuleCheckMessageList& msgs) const {
-  foreach (const Schematic* schematic, mProject.getSchematics()) {
-    checkSymbols(*schematic, msgs);
-    checkNetSegments(*schematic, msgs);
+RuleCheckMessageList ElectricalRuleCheck::checkNetSignal(
+    const Data::NetSignal& net) noexcept {
+  RuleCheckMessageList msgs;
+
+  // Raise a warning if the net signal is connected to less then two component
+  // signals.
+  if (net.realComponentSignals < 2) {
+    msgs.append(std::make_shared<ErcMsgOpenNet>(net));
   }
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkSymbols(const Schematic& schematic,
-                                       RuleCheckMessageList& msgs) const {
-  foreach (const SI_Symbol* symbol, schematic.getSymbols()) {
-    checkPins(*symbol, msgs);
+RuleCheckMessageList ElectricalRuleCheck::checkComponent(
+    const Data::Component& cmp) noexcept {
+  RuleCheckMessageList msgs;
+
+  // Check signals.
+  for (const Data::ComponentSignal& sig : cmp.componentSignals) {
+    if (sig.required && (!sig.connected)) {
+      msgs.append(std::make_shared<ErcMsgUnconnectedRequiredSignal>(cmp, sig));
+    } else if (sig.forcedNetName && (*sig.forcedNetName != sig.netName)) {
+      // Forced net name conflict.
+      msgs.append(
+          std::make_shared<ErcMsgForcedNetSignalNameConflict>(cmp, sig));
+    }
   }
-}
 
-void ElectricalRuleCheck::checkPins(const SI_Symbol& symbol,
-                                    RuleCheckMessageList& msgs) const {
-  foreach (const SI_SymbolPin* pin, symbol.getPins()) {
-    if ((pin->getNetLines().isEmpty()) && (pin->getCompSigInstNetSignal())) {
-      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(*pin));
+  // Check for unplaced gates.
+  for (const Data::Gate& gate : cmp.gates) {
+    if (!gate.placed) {
+      if (gate.required) {
+        msgs.append(std::make_shared<ErcMsgUnplacedRequiredGate>(cmp, gate));
+      } else {
+        msgs.append(std::make_shared<ErcMsgUnplacedOptionalGate>(cmp, gate));
+      }
     }
   }
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkNetSegments(const Schematic& schematic,
-                                           RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetSegment* netSegment, schematic.getNetSegments()) {
-    checkNetPoints(*netSegment, msgs);
-
-    // If there are no net labels, check for any open wire. But only if there's
-    // no "open net" warning on the net raised, since this would be quite a
-    // duplicate warning.
-    if (netSegment->getNetLabels().isEmpty() &&
-        (!mOpenNetSignals.contains(&netSegment->getNetSignal()))) {
-      foreach (const SI_NetLine* netLine, netSegment->getNetLines()) {
-        if (netLine->getStartPoint().isOpen() ||
-            netLine->getEndPoint().isOpen()) {
-          msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(*netSegment));
-          break;
-        }
-      }
+RuleCheckMessageList ElectricalRuleCheck::checkSymbol(
+    const Data::Symbol& symbol) noexcept {
+  RuleCheckMessageList msgs;
+  for (const Data::Pin& pin : symbol.pins) {
+    if ((!pin.hasWires) && pin.connectedToNet) {
+      msgs.append(std::make_shared<ErcMsgConnectedPinWithoutWire>(symbol, pin));
     }
   }
+  return msgs;
 }
 
-void ElectricalRuleCheck::checkNetPoints(const SI_NetSegment& netSegment,
-                                         RuleCheckMessageList& msgs) const {
-  foreach (const SI_NetPoint* netPoint, netSegment.getNetPoints()) {
-    if (netPoint->getNetLines().isEmpty()) {
-      msgs.append(std::make_shared<ErcMsgUnconnectedJunction>(*netPoint));
+RuleCheckMessageList ElectricalRuleCheck::checkNetSegment(
+    const Data::NetSegment& segment, bool openNet) noexcept {
+  RuleCheckMessageList msgs;
+  for (const Data::NetPoint& netPoint : segment.netPoints) {
+    if (!netPoint.hasWires) {
+      msgs.append(
+          std::make_shared<ErcMsgUnconnectedJunction>(segment, netPoint));
     }
   }
+
+  // If there are no net labels, check for any open wire. But only if there's
+  // no "open net" warning on the net raised, since this would be quite a
+  // duplicate warning.
+  if ((!segment.hasLabels) && (!openNet) && segment.hasOpenWires) {
+    msgs.append(std::make_shared<ErcMsgOpenWireInSegment>(segment));
+  }
+  return msgs;
 }
 
 /*******************************************************************************
@@ -24,19 +24,18 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class NetSignal;
 class Project;
-class SI_NetSegment;
-class SI_Symbol;
 class Schematic;
 
 /*******************************************************************************
@@ -44,36 +43,105 @@ class Schematic;
  ******************************************************************************/
 
 /**
- * @brief The ElectricalRuleCheck class checks a ::librepcb::Board for
- *        design rule violations
+ * @brief The ElectricalRuleCheck class checks a ::librepcb::Project for
+ *        electrical rule violations
+ *
+ * The checks are run asynchronously on a snapshot of the project, so the
+ * project can be modified while the checks are running. To make repeated
+ * runs cheap, the messages of each net, component, symbol and net segment
+ * are kept and only items which were modified since the previous run of
+ * the same object are checked again.
+ *
+ * Also the snapshot is created incrementally: The schematic snapshots are
+ * kept and only schematics which emitted a modification signal since the
+ * previous run are copied again. Only the (much smaller) circuit data is
+ * copied on every run.
  */
-class ElectricalRuleCheck final {
+class ElectricalRuleCheck final : public QObject {
+  Q_OBJECT
+
 public:
+  // Types
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
-  explicit ElectricalRuleCheck(const Project& project) noexcept;
+  explicit ElectricalRuleCheck(QObject* parent = nullptr) noexcept;
   ~ElectricalRuleCheck() noexcept;
 
   // General Methods
-  RuleCheckMessageList runChecks() const;
+
+  /**
+   * @brief Start the checks asynchronously
+   *
+   * All relevant data is copied from the project before this method returns,
+   * so the project may be modified afterwards. If a previous run is still in
+   * progress, this method does not wait for it. Instead, the new data is
+   * checked as soon as the previous run is finished. If this method is called
+   * several times in the meantime, only the latest data is checked.
+   *
+   * @param project   The project to check.
+   */
+  void start(const Project& project) noexcept;
+
+  /**
+   * @brief Start the checks asynchronously on an existing snapshot
+   *
+   * Same as #start(const Project&), but with data created by the caller.
+   * The data gets resolved in the worker thread (see
+   * ::librepcb::ElectricalRuleCheckData::resolve()).
+   *
+   * @param data      The data to check.
+   */
+  void start(std::shared_ptr<Data> data) noexcept;
+
+  /**
+   * @brief Wait until the asynchronous operation is finished
+   *
+   * @return All emitted messages
+   */
+  RuleCheckMessageList waitForFinished() const noexcept;
+
+signals:
+  /**
+   * @brief The checks have been finished
+   *
+   * @note  This signal is emitted from the worker thread.
+   *
+   * @param messages  All emitted messages
+   */
+  void finished(const RuleCheckMessageList& messages);
 
 private:  // Methods
-  void checkNetClasses(RuleCheckMessageList& msgs) const;
-  void checkNetSignals(RuleCheckMessageList& msgs) const;
-  void checkComponents(RuleCheckMessageList& msgs) const;
-  void checkComponentSignals(const ComponentInstance& cmp,
-                             RuleCheckMessageList& msgs) const;
-  void checkSchematics(RuleCheckMessageList& msgs) const;
-  void checkSymbols(const Schematic& schematic,
-                    RuleCheckMessageList& msgs) const;
-  void checkPins(const SI_Symbol& symbol, RuleCheckMessageList& msgs) const;
-  void checkNetSegments(const Schematic& schematic,
-                        RuleCheckMessageList& msgs) const;
-  void checkNetPoints(const SI_NetSegment& netSegment,
-                      RuleCheckMessageList& msgs) const;
+  void schematicModified() noexcept;
+  RuleCheckMessageList run(std::shared_ptr<Data> data) noexcept;
+  RuleCheckMessageList runChecks(std::shared_ptr<const Data> data) noexcept;
+  static RuleCheckMessageList checkNetClasses(const Data& data) noexcept;
+  static RuleCheckMessageList checkNetSignal(
+      const Data::NetSignal& net) noexcept;
+  static RuleCheckMessageList checkComponent(
+      const Data::Component& cmp) noexcept;
+  static RuleCheckMessageList checkSymbol(const Data::Symbol& symbol) noexcept;
+  static RuleCheckMessageList checkNetSegment(const Data::NetSegment& segment,
+                                              bool openNet) noexcept;
 
 private:  // Data
-  const Project& mProject;
-  mutable QSet<const NetSignal*> mOpenNetSignals;
+  // Cached schematic snapshots, only accessed in the main thread.
+  QPointer<const Project> mProject;
+  QHash<Uuid, Data::Schematic> mSchematics;
+  QSet<Uuid> mModifiedSchematics;
+
+  QFuture<RuleCheckMessageList> mFuture;
+  QMutex mMutex;  ///< Protects mRunning and mPendingData
+  bool mRunning;  ///< Whether a worker is currently running
+  std::shared_ptr<Data> mPendingData;  ///< Data to check after current run
+
+  // State of the previous run, only accessed by runChecks().
+  std::shared_ptr<const Data> mPreviousData;
+  QSet<Uuid> mOpenNetSignals;
+  QHash<Uuid, RuleCheckMessageList> mNetSignalMessages;
+  QHash<Uuid, RuleCheckMessageList> mComponentMessages;
+  QHash<Uuid, RuleCheckMessageList> mSymbolMessages;
+  QHash<Uuid, RuleCheckMessageList> mNetSegmentMessages;
 };
 
 /*******************************************************************************
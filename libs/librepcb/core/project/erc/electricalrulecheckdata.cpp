@@ -0,0 +1,229 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "electricalrulecheckdata.h"
+
+#include "../../library/cmp/component.h"
+#include "../../library/cmp/componentsignal.h"
+#include "../../library/sym/symbolpin.h"
+#include "../circuit/circuit.h"
+#include "../circuit/componentinstance.h"
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netclass.h"
+#include "../circuit/netsignal.h"
+#include "../project.h"
+#include "../schematic/items/si_netline.h"
+#include "../schematic/items/si_netpoint.h"
+#include "../schematic/items/si_netsegment.h"
+#include "../schematic/items/si_symbol.h"
+#include "../schematic/items/si_symbolpin.h"
+#include "../schematic/schematic.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ElectricalRuleCheckData::ElectricalRuleCheckData() noexcept {
+}
+
+ElectricalRuleCheckData::ElectricalRuleCheckData(
+    const Project& project) noexcept {
+  loadCircuit(project.getCircuit());
+  foreach (const librepcb::Schematic* schematic, project.getSchematics()) {
+    schematics.append(loadSchematic(*schematic));
+  }
+  resolve();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ElectricalRuleCheckData::loadCircuit(const Circuit& circuit) noexcept {
+  netClasses.clear();
+  netSignals.clear();
+  components.clear();
+
+  foreach (const librepcb::NetClass* netClass, circuit.getNetClasses()) {
+    netClasses.insert(netClass->getUuid(),
+                      NetClass{
+                          netClass->getUuid(),
+                          *netClass->getName(),
+                          netClass->isUsed(),
+                      });
+  }
+
+  foreach (const librepcb::NetSignal* net, circuit.getNetSignals()) {
+    // Do not count component signals of schematic-only components since
+    // these are just "virtual" connections, i.e. not represented by a real
+    // pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
+    int realComponentSignals = 0;
+    foreach (const ComponentSignalInstance* sig, net->getComponentSignals()) {
+      if (!sig->getComponentInstance().getLibComponent().isSchematicOnly()) {
+        ++realComponentSignals;
+      }
+    }
+    netSignals.insert(net->getUuid(),
+                      NetSignal{
+                          net->getUuid(),
+                          *net->getName(),
+                          realComponentSignals,
+                      });
+  }
+
+  foreach (const ComponentInstance* cmp, circuit.getComponentInstances()) {
+    Component component{cmp->getUuid(), *cmp->getName(), {}, {}};
+    foreach (const ComponentSignalInstance* sig, cmp->getSignals()) {
+      const librepcb::NetSignal* net = sig->getNetSignal();
+      component.componentSignals.append(ComponentSignal{
+          sig->getCompSignal().getUuid(),
+          *sig->getCompSignal().getName(),
+          sig->getCompSignal().isRequired(),
+          net != nullptr,
+          net ? (*net->getName()) : QString(),
+          sig->isNetSignalNameForced()
+              ? std::make_optional(sig->getForcedNetSignalName())
+              : std::nullopt,
+      });
+    }
+    for (const ComponentSymbolVariantItem& gate :
+         cmp->getSymbolVariant().getSymbolItems()) {
+      component.gates.append(Gate{
+          gate.getUuid(),
+          *gate.getSuffix(),
+          gate.isRequired(),
+          cmp->getSymbols().contains(gate.getUuid()),
+      });
+    }
+    components.insert(component.uuid, component);
+  }
+}
+
+ElectricalRuleCheckData::Schematic ElectricalRuleCheckData::loadSchematic(
+    const librepcb::Schematic& sch) noexcept {
+  Schematic schematic{sch.getUuid(), {}, {}};
+  foreach (const SI_Symbol* sym, sch.getSymbols()) {
+    Symbol symbol{
+        sym->getUuid(),
+        sch.getUuid(),
+        sym->getComponentInstance().getUuid(),
+        *sym->getCompSymbVarItem().getSuffix(),
+        {},
+        QString(),
+    };
+    foreach (const SI_SymbolPin* pin, sym->getPins()) {
+      symbol.pins.append(Pin{
+          pin->getLibPinUuid(),
+          pin->getPinSignalMapItem().getSignalUuid(),
+          pin->getPinSignalMapItem().getDisplayType(),
+          *pin->getLibPin().getName(),
+          !pin->getNetLines().isEmpty(),
+          QString(),
+          false,
+      });
+    }
+    schematic.symbols.insert(symbol.uuid, symbol);
+  }
+  foreach (const SI_NetSegment* seg, sch.getNetSegments()) {
+    bool hasOpenWires = false;
+    foreach (const SI_NetLine* netLine, seg->getNetLines()) {
+      if (netLine->getStartPoint().isOpen() ||
+          netLine->getEndPoint().isOpen()) {
+        hasOpenWires = true;
+        break;
+      }
+    }
+    NetSegment segment{
+        seg->getUuid(),
+        sch.getUuid(),
+        seg->getNetSignal().getUuid(),
+        !seg->getNetLabels().isEmpty(),
+        hasOpenWires,
+        {},
+        QString(),
+    };
+    foreach (const SI_NetPoint* netPoint, seg->getNetPoints()) {
+      segment.netPoints.append(NetPoint{
+          netPoint->getUuid(),
+          !netPoint->getNetLines().isEmpty(),
+      });
+    }
+    schematic.netSegments.insert(segment.uuid, segment);
+  }
+  return schematic;
+}
+
+void ElectricalRuleCheckData::resolve() noexcept {
+  for (Schematic& schematic : schematics) {
+    for (Symbol& symbol : schematic.symbols) {
+      const Component* cmp = nullptr;
+      auto cmpIt = components.constFind(symbol.component);
+      if (cmpIt != components.constEnd()) {
+        cmp = &(*cmpIt);
+        if (symbol.gateSuffix.isEmpty()) {
+          symbol.name = cmp->name;
+        } else {
+          symbol.name = cmp->name % "-" % symbol.gateSuffix;
+        }
+      }
+      for (Pin& pin : symbol.pins) {
+        const ComponentSignal* sig = nullptr;
+        if (cmp && pin.componentSignal) {
+          for (const ComponentSignal& cmpSig : cmp->componentSignals) {
+            if (cmpSig.uuid == *pin.componentSignal) {
+              sig = &cmpSig;
+              break;
+            }
+          }
+        }
+        pin.connectedToNet = sig && sig->connected;
+        if (pin.displayType == CmpSigPinDisplayType::pinName()) {
+          pin.name = pin.pinName;
+        } else if (pin.displayType == CmpSigPinDisplayType::componentSignal()) {
+          pin.name = sig ? sig->name : QString();
+        } else if (pin.displayType == CmpSigPinDisplayType::netSignal()) {
+          pin.name = sig ? sig->netName : QString();
+        } else {
+          pin.name = QString();
+        }
+      }
+    }
+    for (NetSegment& segment : schematic.netSegments) {
+      auto netIt = netSignals.constFind(segment.net);
+      segment.netName =
+          (netIt != netSignals.constEnd()) ? netIt->name : QString();
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
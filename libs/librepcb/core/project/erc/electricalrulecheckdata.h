@@ -0,0 +1,221 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+#define LIBREPCB_CORE_ELECTRICALRULECHECKDATA_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../../library/cmp/cmpsigpindisplaytype.h"
+#include "../../types/uuid.h"
+
+#include <QtCore>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Circuit;
+class Project;
+class Schematic;
+
+/*******************************************************************************
+ *  Class ElectricalRuleCheckData
+ ******************************************************************************/
+
+/**
+ * @brief Input data structure for ::librepcb::ElectricalRuleCheck
+ *
+ * A snapshot of all the project data relevant for the ERC, allowing to run
+ * the checks in a worker thread while the project gets modified. The
+ * comparison operators are used to detect which items have been modified
+ * since the previous check.
+ *
+ * The schematic snapshots only contain data of the schematic itself and
+ * refer to circuit items by UUID. Names and net connections of symbols,
+ * pins and net segments are looked up from the circuit snapshot by
+ * #resolve(). This way the snapshot of an unmodified schematic can be
+ * reused even if the circuit was modified.
+ */
+struct ElectricalRuleCheckData final {
+  struct NetClass {
+    Uuid uuid;
+    QString name;
+    bool used;
+
+    bool operator==(const NetClass& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (name == rhs.name) && (used == rhs.used);
+    }
+  };
+  struct NetSignal {
+    Uuid uuid;
+    QString name;
+    int realComponentSignals;  // Excluding schematic-only components.
+
+    bool operator==(const NetSignal& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (name == rhs.name) &&
+          (realComponentSignals == rhs.realComponentSignals);
+    }
+  };
+  struct ComponentSignal {
+    Uuid uuid;  // Library component signal UUID.
+    QString name;
+    bool required;
+    bool connected;
+    QString netName;  // Empty if not connected to a net.
+    std::optional<QString> forcedNetName;
+
+    bool operator==(const ComponentSignal& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (name == rhs.name) &&
+          (required == rhs.required) && (connected == rhs.connected) &&
+          (netName == rhs.netName) && (forcedNetName == rhs.forcedNetName);
+    }
+  };
+  struct Gate {
+    Uuid uuid;
+    QString suffix;
+    bool required;
+    bool placed;
+
+    bool operator==(const Gate& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (suffix == rhs.suffix) &&
+          (required == rhs.required) && (placed == rhs.placed);
+    }
+  };
+  struct Component {
+    Uuid uuid;
+    QString name;
+    QList<ComponentSignal> componentSignals;
+    QList<Gate> gates;
+
+    bool operator==(const Component& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (name == rhs.name) &&
+          (componentSignals == rhs.componentSignals) && (gates == rhs.gates);
+    }
+  };
+  struct Pin {
+    Uuid uuid;  // Library symbol pin UUID.
+    std::optional<Uuid> componentSignal;
+    CmpSigPinDisplayType displayType;
+    QString pinName;  // Library symbol pin name.
+    bool hasWires;
+    QString name;  // Set by resolve().
+    bool connectedToNet;  // Set by resolve().
+
+    bool operator==(const Pin& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (componentSignal == rhs.componentSignal) &&
+          (displayType == rhs.displayType) && (pinName == rhs.pinName) &&
+          (hasWires == rhs.hasWires) && (name == rhs.name) &&
+          (connectedToNet == rhs.connectedToNet);
+    }
+  };
+  struct Symbol {
+    Uuid uuid;
+    Uuid schematic;
+    Uuid component;
+    QString gateSuffix;
+    QList<Pin> pins;
+    QString name;  // Set by resolve().
+
+    bool operator==(const Symbol& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (schematic == rhs.schematic) &&
+          (component == rhs.component) && (gateSuffix == rhs.gateSuffix) &&
+          (pins == rhs.pins) && (name == rhs.name);
+    }
+  };
+  struct NetPoint {
+    Uuid uuid;
+    bool hasWires;
+
+    bool operator==(const NetPoint& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (hasWires == rhs.hasWires);
+    }
+  };
+  struct NetSegment {
+    Uuid uuid;
+    Uuid schematic;
+    Uuid net;
+    bool hasLabels;
+    bool hasOpenWires;
+    QList<NetPoint> netPoints;
+    QString netName;  // Set by resolve().
+
+    bool operator==(const NetSegment& rhs) const noexcept {
+      return (uuid == rhs.uuid) && (schematic == rhs.schematic) &&
+          (net == rhs.net) && (hasLabels == rhs.hasLabels) &&
+          (hasOpenWires == rhs.hasOpenWires) && (netPoints == rhs.netPoints) &&
+          (netName == rhs.netName);
+    }
+  };
+  struct Schematic {
+    Uuid uuid;
+    QMap<Uuid, Symbol> symbols;
+    QMap<Uuid, NetSegment> netSegments;
+  };
+
+  // NOTE: All containers are implicitly shared, so copying this structure
+  // is a lightweight operation.
+  QMap<Uuid, NetClass> netClasses;
+  QMap<Uuid, NetSignal> netSignals;
+  QMap<Uuid, Component> components;
+  QList<Schematic> schematics;
+
+  // Constructors / Destructor
+  ElectricalRuleCheckData() noexcept;
+  explicit ElectricalRuleCheckData(const Project& project) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Replace the circuit data by a snapshot of the passed circuit
+   *
+   * @param circuit   The circuit to copy the data from.
+   */
+  void loadCircuit(const Circuit& circuit) noexcept;
+
+  /**
+   * @brief Create the (unresolved) snapshot of a single schematic
+   *
+   * @param schematic   The schematic to copy the data from.
+   *
+   * @return The schematic snapshot, to be added to #schematics.
+   */
+  static Schematic loadSchematic(const librepcb::Schematic& schematic) noexcept;
+
+  /**
+   * @brief Look up all circuit-related data of the schematic snapshots
+   *
+   * Must be called after all data has been loaded, before running the checks.
+   * Since it modifies (and thus detaches) the schematic containers, it is
+   * intended to be called in the worker thread.
+   */
+  void resolve() noexcept;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
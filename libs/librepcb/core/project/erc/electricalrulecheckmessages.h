@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../rulecheck/rulecheckmessage.h"
+#include "electricalrulecheckdata.h"
 
 #include <QtCore>
 
@@ -32,15 +33,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class ComponentInstance;
-class ComponentSignalInstance;
-class ComponentSymbolVariantItem;
-class NetClass;
-class NetSignal;
-class SI_NetPoint;
-class SI_NetSegment;
-class SI_SymbolPin;
-
 /*******************************************************************************
  *  Class ErcMsgUnusedNetClass
  ******************************************************************************/
@@ -52,9 +44,11 @@ class ErcMsgUnusedNetClass final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgUnusedNetClass)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgUnusedNetClass() = delete;
-  explicit ErcMsgUnusedNetClass(const NetClass& netClass) noexcept;
+  explicit ErcMsgUnusedNetClass(const Data::NetClass& netClass) noexcept;
   ErcMsgUnusedNetClass(const ErcMsgUnusedNetClass& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnusedNetClass() noexcept {}
@@ -71,9 +65,11 @@ class ErcMsgOpenNet final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgOpenNet)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgOpenNet() = delete;
-  explicit ErcMsgOpenNet(const NetSignal& net) noexcept;
+  explicit ErcMsgOpenNet(const Data::NetSignal& net) noexcept;
   ErcMsgOpenNet(const ErcMsgOpenNet& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenNet() noexcept {}
@@ -90,9 +86,11 @@ class ErcMsgOpenWireInSegment final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgOpenWireInSegment)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgOpenWireInSegment() = delete;
-  explicit ErcMsgOpenWireInSegment(const SI_NetSegment& segment) noexcept;
+  explicit ErcMsgOpenWireInSegment(const Data::NetSegment& segment) noexcept;
   ErcMsgOpenWireInSegment(const ErcMsgOpenWireInSegment& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgOpenWireInSegment() noexcept {}
@@ -109,10 +107,12 @@ class ErcMsgUnconnectedRequiredSignal final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgUnconnectedRequiredSignal)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgUnconnectedRequiredSignal() = delete;
-  explicit ErcMsgUnconnectedRequiredSignal(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgUnconnectedRequiredSignal(const Data::Component& component,
+                                  const Data::ComponentSignal& signal) noexcept;
   ErcMsgUnconnectedRequiredSignal(
       const ErcMsgUnconnectedRequiredSignal& other) noexcept
     : RuleCheckMessage(other) {}
@@ -130,17 +130,17 @@ class ErcMsgForcedNetSignalNameConflict final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgForcedNetSignalNameConflict)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgForcedNetSignalNameConflict() = delete;
-  explicit ErcMsgForcedNetSignalNameConflict(
-      const ComponentSignalInstance& signal) noexcept;
+  ErcMsgForcedNetSignalNameConflict(
+      const Data::Component& component,
+      const Data::ComponentSignal& signal) noexcept;
   ErcMsgForcedNetSignalNameConflict(
       const ErcMsgForcedNetSignalNameConflict& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgForcedNetSignalNameConflict() noexcept {}
-
-private:
-  static QString getSignalNet(const ComponentSignalInstance& signal) noexcept;
 };
 
 /*******************************************************************************
@@ -154,11 +154,12 @@ class ErcMsgUnplacedRequiredGate final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgUnplacedRequiredSymbol)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgUnplacedRequiredGate() = delete;
-  explicit ErcMsgUnplacedRequiredGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedRequiredGate(const Data::Component& component,
+                             const Data::Gate& gate) noexcept;
   ErcMsgUnplacedRequiredGate(const ErcMsgUnplacedRequiredGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedRequiredGate() noexcept {}
@@ -175,11 +176,12 @@ class ErcMsgUnplacedOptionalGate final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgUnplacedOptionalSymbol)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgUnplacedOptionalGate() = delete;
-  explicit ErcMsgUnplacedOptionalGate(
-      const ComponentInstance& component,
-      const ComponentSymbolVariantItem& gate) noexcept;
+  ErcMsgUnplacedOptionalGate(const Data::Component& component,
+                             const Data::Gate& gate) noexcept;
   ErcMsgUnplacedOptionalGate(const ErcMsgUnplacedOptionalGate& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnplacedOptionalGate() noexcept {}
@@ -196,9 +198,12 @@ class ErcMsgConnectedPinWithoutWire final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgConnectedPinWithoutWire)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgConnectedPinWithoutWire() = delete;
-  explicit ErcMsgConnectedPinWithoutWire(const SI_SymbolPin& pin) noexcept;
+  ErcMsgConnectedPinWithoutWire(const Data::Symbol& symbol,
+                                const Data::Pin& pin) noexcept;
   ErcMsgConnectedPinWithoutWire(
       const ErcMsgConnectedPinWithoutWire& other) noexcept
     : RuleCheckMessage(other) {}
@@ -216,9 +221,12 @@ class ErcMsgUnconnectedJunction final : public RuleCheckMessage {
   Q_DECLARE_TR_FUNCTIONS(ErcMsgUnconnectedJunction)
 
 public:
+  using Data = ElectricalRuleCheckData;
+
   // Constructors / Destructor
   ErcMsgUnconnectedJunction() = delete;
-  explicit ErcMsgUnconnectedJunction(const SI_NetPoint& netPoint) noexcept;
+  ErcMsgUnconnectedJunction(const Data::NetSegment& segment,
+                            const Data::NetPoint& netPoint) noexcept;
   ErcMsgUnconnectedJunction(const ErcMsgUnconnectedJunction& other) noexcept
     : RuleCheckMessage(other) {}
   virtual ~ErcMsgUnconnectedJunction() noexcept {}
@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "outputjobrunner.h"
 
+#include "../3d/scenedata3d.h"
 #include "../3d/stepexport.h"
 #include "../application.h"
 #include "../attribute/attributesubstitutor.h"
@@ -46,6 +47,7 @@
 #include "../job/netlistoutputjob.h"
 #include "../job/pickplaceoutputjob.h"
 #include "../job/projectjsonoutputjob.h"
+#include "../utils/scopeguard.h"
 #include "../utils/toolbox.h"
 #include "board/board.h"
 #include "board/boardd356netlistexport.h"
@@ -62,6 +64,7 @@
 #include "projectjsonexport.h"
 #include "schematic/schematicpainter.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -74,7 +77,7 @@ namespace librepcb {
  ******************************************************************************/
 
 OutputJobRunner::OutputJobRunner(Project& project) noexcept
-  : QObject(nullptr), mProject(project), mWriter() {
+  : QObject(nullptr), mProject(project), mWriter(), mBoardCache() {
   setOutputDirectory(mProject.getCurrentOutputDir());
 }
 
@@ -100,10 +103,6 @@ const QMultiHash<Uuid, FilePath>& OutputJobRunner::getWrittenFiles()
 
 void OutputJobRunner::setOutputDirectory(const FilePath& fp) noexcept {
   mWriter.reset(new OutputDirectoryWriter(fp));
-  connect(mWriter.data(), &OutputDirectoryWriter::aboutToWriteFile, this,
-          &OutputJobRunner::aboutToWriteFile);
-  connect(mWriter.data(), &OutputDirectoryWriter::aboutToRemoveFile, this,
-          &OutputJobRunner::aboutToRemoveFile);
 }
 
 /*******************************************************************************
@@ -112,11 +111,67 @@ void OutputJobRunner::setOutputDirectory(const FilePath& fp) noexcept {
 
 void OutputJobRunner::run(const QVector<std::shared_ptr<OutputJob>>& jobs) {
   mWriter->loadIndex();  // can throw
-  foreach (const auto& job, jobs) {
+
+  // Run the project-dependent part of all jobs in list order in this thread
+  // and queue the remaining work of each job in the thread pool. Before a job
+  // is started, the jobs it depends on are waited for. This cannot deadlock
+  // since dependencies are always further ahead in the list. If a job fails,
+  // only the jobs depending on it (directly or indirectly) are skipped.
+  const QVector<QSet<int>> graph = buildDependencyGraph(jobs);
+  mBoardCache.reset(new BoardCache());
+  auto cacheGuard = scopeGuard([this]() { mBoardCache.reset(); });
+  std::vector<std::shared_ptr<Exception>> errors(jobs.count());
+  QVector<bool> skipped(jobs.count(), false);
+  QThreadPool pool;  // Waits for all workers when leaving the scope.
+  QVector<QFuture<void>> futures;
+  for (int i = 0; i < jobs.count(); ++i) {
+    std::shared_ptr<const OutputJob> job = jobs.at(i);
+    JobContext ctx;
+    foreach (const int dependency, graph.at(i)) {
+      waitForFinished(futures.at(dependency));
+      if (skipped.at(dependency) || errors.at(dependency)) {
+        skipped[i] = true;
+      }
+      ctx.dependencies.insert(jobs.at(dependency)->getUuid());
+    }
+    if (skipped.at(i)) {
+      futures.append(QFuture<void>());  // Already finished.
+      continue;
+    }
     emit jobStarted(job);
-    run(*job);  // can throw
-    qApp->processEvents();  // Avoid freeze due to blocking loop.
+    const int countBefore = mWriter->getWrittenFiles(job->getUuid()).count();
+    try {
+      run(*job, ctx);  // can throw
+    } catch (const Exception& e) {
+      errors.at(i).reset(e.clone());
+      futures.append(QFuture<void>());  // Already finished.
+      continue;
+    }
+    auto runTasks = [this, i, job, tasks = ctx.tasks, countBefore, &errors]() {
+      try {
+        for (const auto& task : tasks) {
+          task();  // can throw
+        }
+        finish(*job, countBefore);  // can throw
+      } catch (const Exception& e) {
+        errors.at(i).reset(e.clone());
+      }
+    };
+    futures.append(QtConcurrent::run(&pool, runTasks));
   }
+  foreach (const QFuture<void>& future, futures) {
+    waitForFinished(future);
+  }
+
+  // Deliver signals still queued by the worker threads before returning.
+  QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+
+  for (const auto& error : errors) {
+    if (error) {
+      error->raise();
+    }
+  }
+
   mWriter->storeIndex();  // can throw
 }
 
@@ -126,7 +181,11 @@ QList<FilePath> OutputJobRunner::findUnknownFiles(
 }
 
 void OutputJobRunner::removeUnknownFiles(const QList<FilePath>& files) {
-  mWriter->removeUnknownFiles(files);
+  QMetaObject::Connection connection =
+      connect(mWriter.data(), &OutputDirectoryWriter::aboutToRemoveFile, this,
+              &OutputJobRunner::aboutToRemoveFile);
+  auto sg = scopeGuard([connection]() { disconnect(connection); });
+  mWriter->removeUnknownFiles(files);  // can throw
 }
 
 GraphicsExport::Pages OutputJobRunner::buildPages(
@@ -189,17 +248,12 @@ GraphicsExport::Pages OutputJobRunner::buildPages(
       foreach (const Board* board, boards) {
         foreach (auto av, assemblyVariants) {
           Q_UNUSED(av);  // TODO
-          std::shared_ptr<GraphicsPagePainter> painter;
           // New option "realistic" was added after the v1.0.0 release, thus
           // not officially supported in file format v1.0. Should probably be
           // migrated to a new content type in file format v2, maybe with
           // some configuration options.
-          if (content.options.contains("realistic")) {
-            painter = std::make_shared<RealisticBoardPainter>(
-                board->buildScene3D(std::nullopt));
-          } else {
-            painter = std::make_shared<BoardPainter>(*board);
-          }
+          std::shared_ptr<GraphicsPagePainter> painter = getBoardPainter(
+              *board, content.options.contains("realistic"));
           pages.append(std::make_pair(painter, settings));
         }
       }
@@ -220,48 +274,82 @@ GraphicsExport::Pages OutputJobRunner::buildPages(
  *  Private Methods
  ******************************************************************************/
 
-void OutputJobRunner::run(const OutputJob& job) {
-  const int countBefore = mWriter->getWrittenFiles().count(job.getUuid());
+QVector<QSet<int>> OutputJobRunner::buildDependencyGraph(
+    const QVector<std::shared_ptr<OutputJob>>& jobs) noexcept {
+  QVector<QSet<int>> graph;
+  QHash<Uuid, int> indices;
+  for (int i = 0; i < jobs.count(); ++i) {
+    const OutputJob& job = *jobs.at(i);
+    QSet<int> dependencies;
+    if (dynamic_cast<const CopyOutputJob*>(&job)) {
+      // Copy jobs might read the output of any previous job.
+      for (int k = 0; k < i; ++k) {
+        dependencies.insert(k);
+      }
+    } else {
+      // Dependencies to jobs not ahead in the list are reported as error
+      // when running the job.
+      foreach (const Uuid& uuid, job.getDependencies()) {
+        auto it = indices.constFind(uuid);
+        if (it != indices.constEnd()) {
+          dependencies.insert(*it);
+        }
+      }
+    }
+    graph.append(dependencies);
+    indices.insert(job.getUuid(), i);
+  }
+  return graph;
+}
+
+void OutputJobRunner::run(const OutputJob& job, JobContext& ctx) {
   if (auto ptr = dynamic_cast<const GraphicsOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const GerberExcellonOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const PickPlaceOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const GerberX3OutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const NetlistOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const BomOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr =
                  dynamic_cast<const InteractiveHtmlBomOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const Board3DOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const ProjectJsonOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const LppzOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const CopyOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else if (auto ptr = dynamic_cast<const ArchiveOutputJob*>(&job)) {
-    runImpl(*ptr);
+    runImpl(*ptr, ctx);
   } else {
     throw LogicError(
         __FILE__, __LINE__,
         tr("Unknown output job type '%1'.").arg(job.getType()) % " " %
             tr("You may need a more recent LibrePCB version to run this job."));
   }
-  const int countAfter = mWriter->getWrittenFiles().count(job.getUuid());
-  mWriter->removeObsoleteFiles(job.getUuid());  // can throw
+}
+
+void OutputJobRunner::finish(const OutputJob& job, int countBefore) {
+  const int countAfter = mWriter->getWrittenFiles(job.getUuid()).count();
+  const QList<FilePath> removedFiles =
+      mWriter->removeObsoleteFiles(job.getUuid());  // can throw
+  foreach (const FilePath& fp, removedFiles) {
+    emitInOwnThread([this, fp]() { emit aboutToRemoveFile(fp); });
+  }
   if (countAfter <= countBefore) {
-    emit warning(
+    logWarning(
         tr("No output files were generated, check the job configuration."));
   }
 }
 
-void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
+void OutputJobRunner::runImpl(const GraphicsOutputJob& job, JobContext& ctx) {
   // Build pages.
   const GraphicsExport::Pages pages = buildPages(job);
 
@@ -282,8 +370,8 @@ void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
       ((allBoards.count() == 1) && (*allBoards.begin()))
       ? ProjectAttributeLookup(**allBoards.begin(), av)
       : ProjectAttributeLookup(mProject, av);
-  const FilePath fp = mWriter->beginWritingFile(
-      job.getUuid(),
+  const FilePath fp = beginWritingFile(
+      job,
       AttributeSubstitutor::substitute(
           job.getOutputPath(), lookup, [&](const QString& str) {
             return FilePath::cleanFileName(
@@ -297,25 +385,29 @@ void OutputJobRunner::runImpl(const GraphicsOutputJob& job) {
   }
   docName = AttributeSubstitutor::substitute(docName, lookup).simplified();
 
-  // Perform the export.
-  GraphicsExport graphicsExport;
-  graphicsExport.setDocumentName(docName);
-  graphicsExport.startExport(pages, fp);
-  const GraphicsExport::Result result = graphicsExport.waitForFinished();
-  foreach (const FilePath& writtenFile, result.writtenFiles) {
-    if (writtenFile != fp) {
-      // Track additional files.
-      mWriter->beginWritingFile(
-          job.getUuid(),
-          writtenFile.toRelative(mWriter->getDirectoryPath()));  // can throw
+  // Perform the export. The pages don't access the project anymore, thus
+  // they can be exported in a worker thread.
+  ctx.tasks.append([this, &job, pages, docName, fp]() {
+    GraphicsExport graphicsExport;
+    graphicsExport.setDocumentName(docName);
+    graphicsExport.startExport(pages, fp);
+    const GraphicsExport::Result result = graphicsExport.waitForFinished();
+    foreach (const FilePath& writtenFile, result.writtenFiles) {
+      if (writtenFile != fp) {
+        // Track additional files.
+        beginWritingFile(
+            job,
+            writtenFile.toRelative(mWriter->getDirectoryPath()));  // can throw
+      }
     }
-  }
-  if (!result.errorMsg.isEmpty()) {
-    throw RuntimeError(__FILE__, __LINE__, result.errorMsg);
-  }
+    if (!result.errorMsg.isEmpty()) {
+      throw RuntimeError(__FILE__, __LINE__, result.errorMsg);
+    }
+  });
 }
 
-void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job) {
+void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job,
+                              JobContext& ctx) {
   // Build settings.
   BoardFabricationOutputSettings settings;
   settings.setOutputBasePath(mWriter->getDirectoryPath().toStr() % "/" %
@@ -342,19 +434,21 @@ void OutputJobRunner::runImpl(const GerberExcellonOutputJob& job) {
   // Determine boards.
   const QList<Board*> boards = getBoards(job.getBoards());
 
-  // Perform export:
+  // Perform export. Note that the board is accessed while exporting, thus
+  // this has to be done in this thread.
+  Q_UNUSED(ctx);
   foreach (const Board* board, boards) {
     BoardGerberExport grbExport(*board);
+    grbExport.setSnapshot(getGerberSnapshot(*board));  // can throw
     grbExport.setRemoveObsoleteFiles(false);  // must be done by this runner!
     grbExport.setBeforeWriteCallback([this, &job](const FilePath& fp) {
-      mWriter->beginWritingFile(job.getUuid(),
-                                fp.toRelative(mWriter->getDirectoryPath()));
+      beginWritingFile(job, fp.toRelative(mWriter->getDirectoryPath()));
     });
     grbExport.exportPcbLayers(settings);  // can throw
   }
 }
 
-void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
+void OutputJobRunner::runImpl(const PickPlaceOutputJob& job, JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -391,18 +485,18 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
     typeFilter.insert(PickPlaceDataItem::Type::Other);
   }
   if (typeFilter.isEmpty()) {
-    emit warning(
-        tr("No technologies selected, thus the output files won't "
-           "contain any entries."));
+    logWarning(
+        tr("No technologies selected, thus the output files won't contain any "
+           "entries."));
   }
 
   foreach (const Board* board, boards) {
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
-      BoardPickPlaceGenerator gen(*board, av->getUuid());
-      std::shared_ptr<PickPlaceData> data = gen.generate();
+      std::shared_ptr<const PickPlaceData> data =
+          getPickPlaceData(*board, av->getUuid());
       foreach (const auto& pair, sides) {
-        const FilePath fp = mWriter->beginWritingFile(
-            job.getUuid(),
+        const FilePath fp = beginWritingFile(
+            job,
             AttributeSubstitutor::substitute(
                 pair.second, ProjectAttributeLookup(*board, av),
                 [&](const QString& str) {
@@ -411,12 +505,15 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
                 }));  // can throw
 
         if (fp.getSuffix().toLower() == "csv") {
-          PickPlaceCsvWriter writer(*data);
-          writer.setIncludeMetadataComment(job.getIncludeComment());
-          writer.setBoardSide(pair.first);
-          writer.setTypeFilter(typeFilter);
-          std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-          csv->saveToFile(fp);  // can throw
+          const PickPlaceCsvWriter::BoardSide side = pair.first;
+          ctx.tasks.append([&job, data, side, typeFilter, fp]() {
+            PickPlaceCsvWriter writer(*data);
+            writer.setIncludeMetadataComment(job.getIncludeComment());
+            writer.setBoardSide(side);
+            writer.setTypeFilter(typeFilter);
+            std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
+            csv->saveToFile(fp);  // can throw
+          });
         } else {
           throw RuntimeError(__FILE__, __LINE__,
                              QString("Unsupported pick&place format: '%1'")
@@ -427,7 +524,8 @@ void OutputJobRunner::runImpl(const PickPlaceOutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
+void OutputJobRunner::runImpl(const GerberX3OutputJob& job, JobContext& ctx) {
+  Q_UNUSED(ctx);
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -445,8 +543,8 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
   foreach (const Board* board, boards) {
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
       foreach (const auto& pair, sides) {
-        const FilePath fp = mWriter->beginWritingFile(
-            job.getUuid(),
+        const FilePath fp = beginWritingFile(
+            job,
             AttributeSubstitutor::substitute(
                 pair.second, ProjectAttributeLookup(*board, av),
                 [&](const QString& str) {
@@ -454,6 +552,7 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
                       str, FilePath::ReplaceSpaces | FilePath::KeepCase);
                 }));  // can throw
 
+        // Note: Accesses the board, thus it has to be done in this thread.
         BoardGerberExport gen(*board);
         gen.exportComponentLayer(pair.first, av->getUuid(), fp);  // can throw
       }
@@ -461,11 +560,11 @@ void OutputJobRunner::runImpl(const GerberX3OutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
+void OutputJobRunner::runImpl(const NetlistOutputJob& job, JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards());
   foreach (const Board* board, boards) {
-    const FilePath fp = mWriter->beginWritingFile(
-        job.getUuid(),
+    const FilePath fp = beginWritingFile(
+        job,
         AttributeSubstitutor::substitute(
             job.getOutputPath(), ProjectAttributeLookup(*board, nullptr),
             [&](const QString& str) {
@@ -475,7 +574,10 @@ void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
 
     if (fp.getSuffix().toLower() == "d356") {
       BoardD356NetlistExport exp(*board);
-      FileUtils::writeFile(fp, exp.generate());  // can throw
+      const QByteArray content = exp.generate();
+      ctx.tasks.append([content, fp]() {
+        FileUtils::writeFile(fp, content);  // can throw
+      });
     } else {
       throw RuntimeError(
           __FILE__, __LINE__,
@@ -484,7 +586,7 @@ void OutputJobRunner::runImpl(const NetlistOutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const BomOutputJob& job) {
+void OutputJobRunner::runImpl(const BomOutputJob& job, JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards(), false);
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -494,8 +596,8 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
       const ProjectAttributeLookup lookup = board
           ? ProjectAttributeLookup(*board, av)
           : ProjectAttributeLookup(mProject, av);
-      const FilePath fp = mWriter->beginWritingFile(
-          job.getUuid(),
+      const FilePath fp = beginWritingFile(
+          job,
           AttributeSubstitutor::substitute(
               job.getOutputPath(), lookup, [&](const QString& str) {
                 return FilePath::cleanFileName(
@@ -504,11 +606,13 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
 
       BomGenerator gen(mProject);
       gen.setAdditionalAttributes(job.getCustomAttributes());
-      std::shared_ptr<Bom> bom = gen.generate(board, av->getUuid());
+      std::shared_ptr<const Bom> bom = gen.generate(board, av->getUuid());
       if (fp.getSuffix().toLower() == "csv") {
-        BomCsvWriter writer(*bom);
-        std::shared_ptr<CsvFile> csv = writer.generateCsv();
-        csv->saveToFile(fp);
+        ctx.tasks.append([bom, fp]() {
+          BomCsvWriter writer(*bom);
+          std::shared_ptr<CsvFile> csv = writer.generateCsv();
+          csv->saveToFile(fp);  // can throw
+        });
       } else {
         throw RuntimeError(
             __FILE__, __LINE__,
@@ -518,7 +622,8 @@ void OutputJobRunner::runImpl(const BomOutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
+void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job,
+                              JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants());
@@ -528,8 +633,8 @@ void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
       const ProjectAttributeLookup lookup = board
           ? ProjectAttributeLookup(*board, av)
           : ProjectAttributeLookup(mProject, av);
-      const FilePath fp = mWriter->beginWritingFile(
-          job.getUuid(),
+      const FilePath fp = beginWritingFile(
+          job,
           AttributeSubstitutor::substitute(
               job.getOutputPath(), lookup, [&](const QString& str) {
                 return FilePath::cleanFileName(
@@ -552,8 +657,10 @@ void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
         ibom->setShowFabrication(job.getShowFabrication());
         ibom->setShowPads(job.getShowPads());
         ibom->setCheckBoxes(job.getCheckBoxes());
-        const QString html = ibom->generateHtml();  // can throw
-        FileUtils::writeFile(fp, html.toUtf8());  // can throw
+        ctx.tasks.append([ibom, fp]() {
+          const QString html = ibom->generateHtml();  // can throw
+          FileUtils::writeFile(fp, html.toUtf8());  // can throw
+        });
       } else {
         throw RuntimeError(__FILE__, __LINE__,
                            QString("Unsupported interactive BOM format: '%1'")
@@ -563,15 +670,15 @@ void OutputJobRunner::runImpl(const InteractiveHtmlBomOutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
+void OutputJobRunner::runImpl(const Board3DOutputJob& job, JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards());
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants(), false);
 
   foreach (const Board* board, boards) {
     foreach (const std::shared_ptr<AssemblyVariant>& av, assemblyVariants) {
-      const FilePath fp = mWriter->beginWritingFile(
-          job.getUuid(),
+      const FilePath fp = beginWritingFile(
+          job,
           AttributeSubstitutor::substitute(
               job.getOutputPath(), ProjectAttributeLookup(*board, av),
               [&](const QString& str) {
@@ -579,17 +686,19 @@ void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
                     str, FilePath::ReplaceSpaces | FilePath::KeepCase);
               }));  // can throw
 
-      std::shared_ptr<SceneData3D> data = board->buildScene3D(
-          av ? std::make_optional(av->getUuid()) : std::nullopt);
+      std::shared_ptr<SceneData3D> data = buildScene3D(
+          *board, av ? std::make_optional(av->getUuid()) : std::nullopt);
 
       if ((fp.getSuffix().toLower() == "step") ||
           (fp.getSuffix().toLower() == "stp")) {
-        StepExport stepExport;
-        stepExport.start(data, fp);
-        const QString errorMsg = stepExport.waitForFinished();
-        if (!errorMsg.isEmpty()) {
-          throw RuntimeError(__FILE__, __LINE__, errorMsg);
-        }
+        ctx.tasks.append([data, fp]() {
+          StepExport stepExport;
+          stepExport.start(data, fp);
+          const QString errorMsg = stepExport.waitForFinished();
+          if (!errorMsg.isEmpty()) {
+            throw RuntimeError(__FILE__, __LINE__, errorMsg);
+          }
+        });
       } else {
         throw RuntimeError(
             __FILE__, __LINE__,
@@ -599,10 +708,11 @@ void OutputJobRunner::runImpl(const Board3DOutputJob& job) {
   }
 }
 
-void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job) {
+void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job,
+                              JobContext& ctx) {
   // Determine output file.
-  const FilePath fp = mWriter->beginWritingFile(
-      job.getUuid(),
+  const FilePath fp = beginWritingFile(
+      job,
       AttributeSubstitutor::substitute(
           job.getOutputPath(), ProjectAttributeLookup(mProject, nullptr),
           [&](const QString& str) {
@@ -612,13 +722,18 @@ void OutputJobRunner::runImpl(const ProjectJsonOutputJob& job) {
 
   // Export JSON.
   ProjectJsonExport jsonExport;
-  FileUtils::writeFile(fp, jsonExport.toUtf8(mProject));  // can throw
+  const QByteArray content = jsonExport.toUtf8(mProject);
+  ctx.tasks.append([content, fp]() {
+    FileUtils::writeFile(fp, content);  // can throw
+  });
 }
 
-void OutputJobRunner::runImpl(const LppzOutputJob& job) {
+void OutputJobRunner::runImpl(const LppzOutputJob& job, JobContext& ctx) {
+  Q_UNUSED(ctx);  // Saves the project, thus completely done in this thread.
+
   // Determine output file.
-  const FilePath fp = mWriter->beginWritingFile(
-      job.getUuid(),
+  const FilePath fp = beginWritingFile(
+      job,
       AttributeSubstitutor::substitute(
           job.getOutputPath(), ProjectAttributeLookup(mProject, nullptr),
           [&](const QString& str) {
@@ -650,7 +765,7 @@ void OutputJobRunner::runImpl(const LppzOutputJob& job) {
                                                        filter);  // can throw
 }
 
-void OutputJobRunner::runImpl(const CopyOutputJob& job) {
+void OutputJobRunner::runImpl(const CopyOutputJob& job, JobContext& ctx) {
   const QList<Board*> boards = getBoards(job.getBoards(), false);
   const QVector<std::shared_ptr<AssemblyVariant>> assemblyVariants =
       getAssemblyVariants(job.getAssemblyVariants(), false);
@@ -665,8 +780,8 @@ void OutputJobRunner::runImpl(const CopyOutputJob& job) {
             return FilePath::cleanFileName(
                 str, FilePath::ReplaceSpaces | FilePath::KeepCase);
           });
-      const FilePath outputFp = mWriter->beginWritingFile(
-          job.getUuid(),
+      const FilePath outputFp = beginWritingFile(
+          job,
           AttributeSubstitutor::substitute(
               job.getOutputPath(), lookup, [&](const QString& str) {
                 return FilePath::cleanFileName(
@@ -693,15 +808,17 @@ void OutputJobRunner::runImpl(const CopyOutputJob& job) {
       if (job.getSubstituteVariables()) {
         content = AttributeSubstitutor::substitute(content, lookup).toUtf8();
       }
-      FileUtils::writeFile(outputFp, content);  // can throw
+      ctx.tasks.append([content, outputFp]() {
+        FileUtils::writeFile(outputFp, content);  // can throw
+      });
     }
   }
 }
 
-void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
+void OutputJobRunner::runImpl(const ArchiveOutputJob& job, JobContext& ctx) {
   // Determine output file.
-  const FilePath fp = mWriter->beginWritingFile(
-      job.getUuid(),
+  const FilePath fp = beginWritingFile(
+      job,
       AttributeSubstitutor::substitute(
           job.getOutputPath(), ProjectAttributeLookup(mProject, nullptr),
           [&](const QString& str) {
@@ -709,38 +826,143 @@ void OutputJobRunner::runImpl(const ArchiveOutputJob& job) {
                 str, FilePath::ReplaceSpaces | FilePath::KeepCase);
           }));  // can throw
 
-  // Collect input files.
-  std::shared_ptr<TransactionalFileSystem> fs =
-      TransactionalFileSystem::openRW(FilePath::getRandomTempPath());
+  // Determine input files.
+  QList<std::pair<QString, FilePath>> inputFiles;
   for (auto it = job.getInputJobs().begin(); it != job.getInputJobs().end();
        ++it) {
-    if (!mWriter->getWrittenFiles().contains(it.key())) {
+    // Note: Only check the written files of jobs this job has waited for,
+    // others might be running in parallel right now.
+    const QList<FilePath> files = ctx.dependencies.contains(it.key())
+        ? mWriter->getWrittenFiles(it.key())
+        : QList<FilePath>();
+    if (files.isEmpty()) {
       throw RuntimeError(
           __FILE__, __LINE__,
           tr("The archive job depends on files from another job which was not "
              "run yet. Note that archive jobs can only depend on jobs further "
              "ahead in the list so you might need to reorder them."));
     }
-    foreach (const FilePath& inputFp,
-             mWriter->getWrittenFiles().values(it.key())) {
-      fs->write(it.value() % "/" % inputFp.getFilename(),
-                FileUtils::readFile(inputFp));  // can throw
+    foreach (const FilePath& inputFp, files) {
+      inputFiles.append(
+          std::make_pair(it.value() % "/" % inputFp.getFilename(), inputFp));
     }
   }
   if (job.getInputJobs().isEmpty()) {
-    emit warning(
-        tr("No input jobs selected, thus the resulting archive will "
-           "be empty."));
+    logWarning(
+        tr("No input jobs selected, thus the resulting archive will be "
+           "empty."));
   }
 
   // Export depending on file extension.
-  if (fp.getSuffix().toLower() == "zip") {
-    fs->exportToZip(fp);  // can throw
-  } else {
+  if (fp.getSuffix().toLower() != "zip") {
     throw RuntimeError(
         __FILE__, __LINE__,
         QString("Unsupported archive format: '%1'").arg(fp.getSuffix()));
   }
+  ctx.tasks.append([inputFiles, fp]() {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(FilePath::getRandomTempPath());
+    for (const auto& pair : inputFiles) {
+      fs->write(pair.first, FileUtils::readFile(pair.second));  // can throw
+    }
+    fs->exportToZip(fp);  // can throw
+  });
+}
+
+FilePath OutputJobRunner::beginWritingFile(const OutputJob& job,
+                                           const QString& relPath) {
+  const FilePath fp = mWriter->getDirectoryPath().getPathTo(relPath);
+  emitInOwnThread([this, fp]() { emit aboutToWriteFile(fp); });
+  return mWriter->beginWritingFile(job.getUuid(), relPath);  // can throw
+}
+
+void OutputJobRunner::logWarning(const QString& msg) noexcept {
+  emitInOwnThread([this, msg]() { emit warning(msg); });
+}
+
+void OutputJobRunner::emitInOwnThread(std::function<void()> emitter) noexcept {
+  // Receivers expect our signals to be emitted in our thread, thus signals
+  // from worker threads are queued to be emitted as soon as possible.
+  if (QThread::currentThread() == thread()) {
+    emitter();
+  } else {
+    QMetaObject::invokeMethod(this, emitter, Qt::QueuedConnection);
+  }
+}
+
+void OutputJobRunner::waitForFinished(const QFuture<void>& future) noexcept {
+  if (future.isFinished()) {
+    return;
+  }
+
+  // Process events (e.g. signals queued by worker threads) while waiting,
+  // but no user input events since the project must not be modified until
+  // all jobs are finished.
+  QEventLoop loop;
+  QFutureWatcher<void> watcher;
+  QObject::connect(&watcher, &QFutureWatcher<void>::finished, &loop,
+                   &QEventLoop::quit);
+  watcher.setFuture(future);
+  if (!future.isFinished()) {
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+  }
+}
+
+std::shared_ptr<GraphicsPagePainter> OutputJobRunner::getBoardPainter(
+    const Board& board, bool realistic) {
+  if (realistic) {
+    auto create = [this, &board]() -> std::shared_ptr<GraphicsPagePainter> {
+      return std::make_shared<RealisticBoardPainter>(
+          buildScene3D(board, std::nullopt));
+    };
+    return mBoardCache ? mBoardCache->realisticPainters.get(&board, create)
+                       : create();
+  } else {
+    // Note: The painter is thread-safe and caches the painted content, so
+    // sharing it between jobs avoids extracting the same content twice.
+    auto create = [&board]() -> std::shared_ptr<GraphicsPagePainter> {
+      return std::make_shared<BoardPainter>(board);
+    };
+    return mBoardCache ? mBoardCache->painters.get(&board, create) : create();
+  }
+}
+
+std::shared_ptr<const BoardGerberExport::Snapshot>
+    OutputJobRunner::getGerberSnapshot(const Board& board) {
+  // Note: The geometry does not depend on the job settings, thus all
+  // Gerber/Excellon jobs of the same board can share it.
+  auto create = [&board]() {
+    return BoardGerberExport(board).createSnapshot();  // can throw
+  };
+  return mBoardCache ? mBoardCache->gerberSnapshots.get(&board, create)
+                     : create();
+}
+
+std::shared_ptr<SceneData3D> OutputJobRunner::buildScene3D(
+    const Board& board, const std::optional<Uuid>& assemblyVariant) {
+  if (!mBoardCache) {
+    return board.buildScene3D(assemblyVariant);
+  }
+
+  // The consumers modify the scene data during preprocessing, thus each of
+  // them gets its own copy of the cached scene.
+  std::shared_ptr<const SceneData3D> data = mBoardCache->scenes.get(
+      std::make_pair(&board, assemblyVariant), [&board, &assemblyVariant]() {
+        return std::shared_ptr<const SceneData3D>(
+            board.buildScene3D(assemblyVariant));
+      });
+  return std::make_shared<SceneData3D>(*data);
+}
+
+std::shared_ptr<const PickPlaceData> OutputJobRunner::getPickPlaceData(
+    const Board& board, const Uuid& assemblyVariant) {
+  auto create = [&board, &assemblyVariant]() {
+    BoardPickPlaceGenerator gen(board, assemblyVariant);
+    return std::shared_ptr<const PickPlaceData>(gen.generate());
+  };
+  return mBoardCache ? mBoardCache->pickPlaceData.get(
+                           std::make_pair(&board, assemblyVariant), create)
+                     : create();
 }
 
 QList<Board*> OutputJobRunner::getBoards(
@@ -26,9 +26,12 @@
 #include "../export/graphicsexport.h"
 #include "../fileio/filepath.h"
 #include "../job/outputjob.h"
+#include "../utils/concurrentcache.h"
+#include "board/boardgerberexport.h"
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -42,6 +45,7 @@ class Board3DOutputJob;
 class Board;
 class BomOutputJob;
 class CopyOutputJob;
+class Exception;
 class GerberExcellonOutputJob;
 class GerberX3OutputJob;
 class GraphicsOutputJob;
@@ -50,9 +54,11 @@ class LppzOutputJob;
 class NetlistOutputJob;
 class OutputDirectoryWriter;
 class OutputJob;
+class PickPlaceData;
 class PickPlaceOutputJob;
 class Project;
 class ProjectJsonOutputJob;
+class SceneData3D;
 
 /*******************************************************************************
  *  Class OutputJobRunner
@@ -60,6 +66,31 @@ class ProjectJsonOutputJob;
 
 /**
  * @brief The OutputJobRunner class
+ *
+ * Each job is split into two parts: Everything which accesses the project
+ * (reading board or schematic data, saving the project for LPPZ jobs etc.)
+ * is done in the caller's thread, job by job in list order. The remaining
+ * work on immutable data (e.g. rendering graphics, exporting STEP files,
+ * writing files) is done in worker threads, so independent jobs are executed
+ * in parallel. Jobs are only serialized where they really depend on each
+ * other:
+ *
+ *   - Jobs listed in ::librepcb::OutputJob::getDependencies() (e.g. inputs of
+ *     archive jobs) are finished before the depending job is started.
+ *   - Copy jobs wait for all previous jobs since the input file might be an
+ *     output file of any of them.
+ *
+ * If a job fails, only the jobs depending on it are skipped. The other jobs
+ * are still executed, and #run() throws the error of the first failed job
+ * at the end.
+ *
+ * While waiting for worker threads, events are processed, but user input
+ * events are excluded. All signals are emitted in the caller's thread as
+ * soon as possible, thus signals of different jobs may be interleaved.
+ *
+ * Derived board data (graphics painters, Gerber geometry, 3D scenes,
+ * pick&place data) is created only once per #run() and shared by all jobs
+ * needing it.
  */
 class OutputJobRunner final : public QObject {
   Q_OBJECT
@@ -95,20 +126,57 @@ signals:
   void previewReady(int index, const QSize& pageSize, const QRectF margins,
                     std::shared_ptr<QPicture> picture);
 
+private:  // Types
+  /// State of a job being executed
+  struct JobContext {
+    QSet<Uuid> dependencies;  ///< Jobs finished before this job was started
+    QList<std::function<void()>> tasks;  ///< Work to run in a worker thread
+  };
+
+  /// Immutable board data shared by all jobs within one #run() call
+  struct BoardCache {
+    typedef std::pair<const Board*, std::optional<Uuid>> VariantKey;
+    ConcurrentCache<const Board*, std::shared_ptr<GraphicsPagePainter>>
+        painters;
+    ConcurrentCache<const Board*, std::shared_ptr<GraphicsPagePainter>>
+        realisticPainters;
+    ConcurrentCache<const Board*,
+                    std::shared_ptr<const BoardGerberExport::Snapshot>>
+        gerberSnapshots;
+    ConcurrentCache<VariantKey, std::shared_ptr<const SceneData3D>> scenes;
+    ConcurrentCache<VariantKey, std::shared_ptr<const PickPlaceData>>
+        pickPlaceData;
+  };
+
 private:  // Methods
-  void run(const OutputJob& job);
-  void runImpl(const GraphicsOutputJob& job);
-  void runImpl(const GerberExcellonOutputJob& job);
-  void runImpl(const PickPlaceOutputJob& job);
-  void runImpl(const GerberX3OutputJob& job);
-  void runImpl(const NetlistOutputJob& job);
-  void runImpl(const BomOutputJob& job);
-  void runImpl(const InteractiveHtmlBomOutputJob& job);
-  void runImpl(const Board3DOutputJob& job);
-  void runImpl(const ProjectJsonOutputJob& job);
-  void runImpl(const LppzOutputJob& job);
-  void runImpl(const CopyOutputJob& job);
-  void runImpl(const ArchiveOutputJob& job);
+  static QVector<QSet<int>> buildDependencyGraph(
+      const QVector<std::shared_ptr<OutputJob>>& jobs) noexcept;
+  void run(const OutputJob& job, JobContext& ctx);
+  void finish(const OutputJob& job, int countBefore);
+  void runImpl(const GraphicsOutputJob& job, JobContext& ctx);
+  void runImpl(const GerberExcellonOutputJob& job, JobContext& ctx);
+  void runImpl(const PickPlaceOutputJob& job, JobContext& ctx);
+  void runImpl(const GerberX3OutputJob& job, JobContext& ctx);
+  void runImpl(const NetlistOutputJob& job, JobContext& ctx);
+  void runImpl(const BomOutputJob& job, JobContext& ctx);
+  void runImpl(const InteractiveHtmlBomOutputJob& job, JobContext& ctx);
+  void runImpl(const Board3DOutputJob& job, JobContext& ctx);
+  void runImpl(const ProjectJsonOutputJob& job, JobContext& ctx);
+  void runImpl(const LppzOutputJob& job, JobContext& ctx);
+  void runImpl(const CopyOutputJob& job, JobContext& ctx);
+  void runImpl(const ArchiveOutputJob& job, JobContext& ctx);
+  FilePath beginWritingFile(const OutputJob& job, const QString& relPath);
+  void logWarning(const QString& msg) noexcept;
+  void emitInOwnThread(std::function<void()> emitter) noexcept;
+  static void waitForFinished(const QFuture<void>& future) noexcept;
+  std::shared_ptr<GraphicsPagePainter> getBoardPainter(const Board& board,
+                                                       bool realistic);
+  std::shared_ptr<const BoardGerberExport::Snapshot> getGerberSnapshot(
+      const Board& board);
+  std::shared_ptr<SceneData3D> buildScene3D(
+      const Board& board, const std::optional<Uuid>& assemblyVariant);
+  std::shared_ptr<const PickPlaceData> getPickPlaceData(
+      const Board& board, const Uuid& assemblyVariant);
   QList<Board*> getBoards(const OutputJob::ObjectSet<std::optional<Uuid>>& set,
                           bool includeNullInAll) const;
   QList<Board*> getBoards(const OutputJob::ObjectSet<Uuid>& set) const;
@@ -121,6 +189,9 @@ private:  // Methods
 private:  // Data
   Project& mProject;
   QScopedPointer<OutputDirectoryWriter> mWriter;
+
+  /// Only available during #run() since the board might be modified later
+  std::unique_ptr<BoardCache> mBoardCache;
 };
 
 /*******************************************************************************
@@ -186,6 +186,11 @@ bool Project::setErcMessageApprovals(
     const QSet<SExpression>& approvals) noexcept {
   if (approvals != mErcMessageApprovals) {
     mErcMessageApprovals = approvals;
+    mErcMessageApprovalKeys.clear();
+    foreach (const SExpression& approval, mErcMessageApprovals) {
+      mErcMessageApprovalKeys.insert(
+          RuleCheckMessage::calcApprovalKey(approval), approval);
+    }
     emit ercMessageApprovalsChanged(mErcMessageApprovals);
     return true;
   } else {
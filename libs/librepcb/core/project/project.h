@@ -27,6 +27,7 @@
 #include "../fileio/directorylock.h"
 #include "../fileio/transactionaldirectory.h"
 #include "../job/outputjob.h"
+#include "../rulecheck/rulecheckmessage.h"
 #include "../types/elementname.h"
 #include "../types/fileproofname.h"
 #include "../types/uuid.h"
@@ -254,6 +255,19 @@ public:
     return mErcMessageApprovals;
   }
 
+  /**
+   * @brief Get all ERC message approvals with their approval keys
+   *
+   * The keys are calculated only when the approvals are modified, so this
+   * is cheaper than calculating the keys of #getErcMessageApprovals().
+   *
+   * @return Approval nodes by their approval key
+   */
+  const QHash<RuleCheckMessage::ApprovalKey, SExpression>&
+      getErcMessageApprovalKeys() const noexcept {
+    return mErcMessageApprovalKeys;
+  }
+
   /**
    * @brief Get the primary board (the first one)
    *
@@ -634,6 +648,9 @@ private:  // Data
   /// All approved ERC messages
   QSet<SExpression> mErcMessageApprovals;
 
+  /// Keys of #mErcMessageApprovals
+  QHash<RuleCheckMessage::ApprovalKey, SExpression> mErcMessageApprovalKeys;
+
   // Cached properties
   QPointer<Board> mPrimaryBoard;
 };
@@ -151,8 +151,9 @@ std::unique_ptr<Project> ProjectLoader::open(
   // If the file format was migrated, clean up obsolete ERC messages.
   if (mUpgradeMessages) {
     qInfo() << "Running ERC to clean up obsolete message approvals...";
-    ElectricalRuleCheck erc(*p);
-    const RuleCheckMessageList msgs = erc.runChecks();
+    ElectricalRuleCheck erc;
+    erc.start(*p);
+    const RuleCheckMessageList msgs = erc.waitForFinished();
     const QSet<SExpression> approvals = RuleCheckMessage::getAllApprovals(msgs);
     p->setErcMessageApprovals(p->getErcMessageApprovals() & approvals);
   }
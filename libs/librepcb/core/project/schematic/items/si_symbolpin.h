@@ -106,6 +106,9 @@ public:
   const Uuid& getLibPinUuid() const noexcept;
   SI_Symbol& getSymbol() const noexcept { return mSymbol; }
   const SymbolPin& getLibPin() const noexcept { return *mSymbolPin; }
+  const ComponentPinSignalMapItem& getPinSignalMapItem() const noexcept {
+    return *mPinSignalMapItem;
+  }
   ComponentSignalInstance* getComponentSignalInstance() const noexcept {
     return mComponentSignalInstance;
   }
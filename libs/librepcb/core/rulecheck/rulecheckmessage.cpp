@@ -36,7 +36,9 @@ RuleCheckMessage::RuleCheckMessage(const RuleCheckMessage& other) noexcept
     mMessage(other.mMessage),
     mDescription(other.mDescription),
     mApproval(new SExpression(*other.mApproval)),
-    mLocations(other.mLocations) {
+    mLocations(other.mLocations),
+    mApprovalKeyFlag(),
+    mApprovalKey() {
 }
 
 RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
@@ -47,7 +49,9 @@ RuleCheckMessage::RuleCheckMessage(Severity severity, const QString& msg,
     mMessage(msg),
     mDescription(description),
     mApproval(SExpression::createList("approved")),
-    mLocations(locations) {
+    mLocations(locations),
+    mApprovalKeyFlag(),
+    mApprovalKey() {
   mApproval->appendChild(SExpression::createToken(approvalName));  // snake_case
 }
 
@@ -62,6 +66,14 @@ const QIcon& RuleCheckMessage::getSeverityIcon() const noexcept {
   return getSeverityIcon(mSeverity);
 }
 
+const RuleCheckMessage::ApprovalKey& RuleCheckMessage::getApprovalKey()
+    const noexcept {
+  // Note: Messages are shared between threads, thus the thread-safe init.
+  std::call_once(mApprovalKeyFlag,
+                 [this]() { mApprovalKey = calcApprovalKey(*mApproval); });
+  return mApprovalKey;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -99,6 +111,72 @@ QSet<SExpression> RuleCheckMessage::getAllApprovals(
   return approvals;
 }
 
+QSet<RuleCheckMessage::ApprovalKey> RuleCheckMessage::getAllApprovalKeys(
+    const QVector<std::shared_ptr<const RuleCheckMessage>>& messages) noexcept {
+  QSet<ApprovalKey> keys;
+  keys.reserve(messages.count());
+  foreach (const auto& msg, messages) {
+    Q_ASSERT(msg);
+    keys.insert(msg->getApprovalKey());
+  }
+  return keys;
+}
+
+RuleCheckMessage::ApprovalKey RuleCheckMessage::calcApprovalKey(
+    const SExpression& approval) noexcept {
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  addToApprovalHash(hash, approval);
+  const QByteArray digest = hash.result();
+  Q_ASSERT(digest.size() == 16);
+  return std::make_pair(qFromLittleEndian<quint64>(digest.constData()),
+                        qFromLittleEndian<quint64>(digest.constData() + 8));
+}
+
+QSet<RuleCheckMessage::ApprovalKey> RuleCheckMessage::calcApprovalKeys(
+    const QSet<SExpression>& approvals) noexcept {
+  QSet<ApprovalKey> keys;
+  keys.reserve(approvals.count());
+  foreach (const SExpression& approval, approvals) {
+    keys.insert(calcApprovalKey(approval));
+  }
+  return keys;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void RuleCheckMessage::addToApprovalHash(QCryptographicHash& hash,
+                                         const SExpression& node) noexcept {
+  // Feed all properties compared by SExpression::operator==() into the hash,
+  // with length prefixes to make the byte stream unambiguous.
+  auto addNumber = [&hash](quint32 number) {
+    const quint32 le = qToLittleEndian(number);
+    hash.addData(reinterpret_cast<const char*>(&le), sizeof(le));
+  };
+  auto addString = [&](const QString& str) {
+    const QByteArray utf8 = str.toUtf8();
+    addNumber(static_cast<quint32>(utf8.size()));
+    hash.addData(utf8);
+  };
+  addNumber(static_cast<quint32>(node.getType()));
+  switch (node.getType()) {
+    case SExpression::Type::List:
+      addString(node.getName());
+      addNumber(static_cast<quint32>(node.getChildCount()));
+      for (std::size_t i = 0; i < node.getChildCount(); ++i) {
+        addToApprovalHash(hash, node.getChild(static_cast<int>(i)));
+      }
+      break;
+    case SExpression::Type::Token:
+    case SExpression::Type::String:
+      addString(node.getValue());
+      break;
+    default:
+      break;
+  }
+}
+
 /*******************************************************************************
  *  Operator Overloads
  ******************************************************************************/
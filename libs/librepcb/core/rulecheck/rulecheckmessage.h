@@ -29,6 +29,8 @@
 #include <QtCore>
 
 #include <memory>
+#include <mutex>
+#include <utility>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -53,6 +55,13 @@ public:
     Error = 2,
   };
 
+  /// Compact 128-bit digest of an approval node
+  ///
+  /// Equal approval nodes always have equal keys, so lookups and set
+  /// operations can be done on keys instead of on the full node trees. The
+  /// trees are only needed for serialization.
+  typedef std::pair<quint64, quint64> ApprovalKey;
+
   // Constructors / Destructor
   RuleCheckMessage() = delete;
 
@@ -63,6 +72,7 @@ public:
   const QString& getMessage() const noexcept { return mMessage; }
   const QString& getDescription() const noexcept { return mDescription; }
   const SExpression& getApproval() const noexcept { return *mApproval; }
+  const ApprovalKey& getApprovalKey() const noexcept;
   const QVector<Path>& getLocations() const noexcept { return mLocations; }
 
   // General Methods
@@ -81,6 +91,12 @@ public:
   static QSet<SExpression> getAllApprovals(
       const QVector<std::shared_ptr<const RuleCheckMessage>>&
           messages) noexcept;
+  static QSet<ApprovalKey> getAllApprovalKeys(
+      const QVector<std::shared_ptr<const RuleCheckMessage>>&
+          messages) noexcept;
+  static ApprovalKey calcApprovalKey(const SExpression& approval) noexcept;
+  static QSet<ApprovalKey> calcApprovalKeys(
+      const QSet<SExpression>& approvals) noexcept;
 
   // Operator Overloads
   bool operator==(const RuleCheckMessage& rhs) const noexcept;
@@ -93,12 +109,22 @@ protected:  // Methods
                    const QVector<Path>& locations = {}) noexcept;
   virtual ~RuleCheckMessage() noexcept;
 
+private:  // Methods
+  static void addToApprovalHash(QCryptographicHash& hash,
+                                const SExpression& node) noexcept;
+
 protected:  // Data
   Severity mSeverity;
   QString mMessage;
   QString mDescription;
   std::unique_ptr<SExpression> mApproval;
   QVector<Path> mLocations;
+
+private:  // Data
+  /// Lazily calculated because subclasses extend ::mApproval in their
+  /// constructors
+  mutable std::once_flag mApprovalKeyFlag;
+  mutable ApprovalKey mApprovalKey;
 };
 
 typedef QVector<std::shared_ptr<const RuleCheckMessage>> RuleCheckMessageList;
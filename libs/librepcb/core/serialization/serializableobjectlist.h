@@ -88,6 +88,15 @@ namespace librepcb {
  * same address over the whole lifetime. To still minimize the risk of memory
  * leaks, `std::shared_ptr` is used instead of raw pointers.
  *
+ * @note    To avoid quadratic runtime when building or querying big lists,
+ * lookups by pointer, UUID and (case sensitive) name use hash indices once
+ * the list contains at least #sIndexThreshold elements. These indices are
+ * built lazily on the first lookup, extended incrementally when elements are
+ * appended, and invalidated when elements are inserted, removed or edited
+ * (therefore the elements must emit `onEdited` when their UUID or name
+ * changes). Lookups are thread-safe as long as the list is not modified
+ * concurrently.
+ *
  * @warning Using Qt's `foreach` keyword on a ::librepcb::SerializableObjectList
  * is not recommended because it always creates a deep copy of the list! You
  * should use range based for loops (since C++11) instead.
@@ -141,6 +150,9 @@ public:
                const std::shared_ptr<const T>&, OnEditedArgs...>
       OnElementEditedSlot;
 
+  /// Minimum list size to use hash indices for lookups
+  static constexpr int sIndexThreshold = 32;
+
   // Constructors / Destructor
   SerializableObjectList() noexcept
     : onEdited(*this),
@@ -217,6 +229,12 @@ public:
 
   // Element Query
   int indexOf(const T* obj) const noexcept {
+    if (count() >= sIndexThreshold) {
+      return indexOfIndexed(mPointerIndex, mPointerIndexCount, obj,
+                            [](const std::shared_ptr<T>& ptr) -> const T* {
+                              return ptr.get();
+                            });
+    }
     for (int i = 0; i < count(); ++i) {
       if (mObjects[i].get() == obj) {
         return i;
@@ -225,6 +243,12 @@ public:
     return -1;
   }
   int indexOf(const Uuid& key) const noexcept {
+    if (count() >= sIndexThreshold) {
+      return indexOfIndexed(mUuidIndex, mUuidIndexCount, key,
+                            [](const std::shared_ptr<T>& ptr) -> Uuid {
+                              return ptr->getUuid();
+                            });
+    }
     for (int i = 0; i < count(); ++i) {
       if (mObjects[i]->getUuid() == key) {
         return i;
@@ -234,6 +258,12 @@ public:
   }
   int indexOf(const QString& name,
               Qt::CaseSensitivity cs = Qt::CaseSensitive) const noexcept {
+    if ((cs == Qt::CaseSensitive) && (count() >= sIndexThreshold)) {
+      return indexOfIndexed(mNameIndex, mNameIndexCount, name,
+                            [this](const std::shared_ptr<T>& ptr) -> QString {
+                              return asStr(ptr->getName());
+                            });
+    }
     for (int i = 0; i < count(); ++i) {
       if (QString::compare(asStr(mObjects[i]->getName()), name, cs) == 0) {
         return i;
@@ -447,19 +477,25 @@ public:
 
 protected:  // Methods
   void insertElement(int index, const std::shared_ptr<T>& obj) noexcept {
+    if (index < mObjects.count()) {
+      // Appended elements are indexed lazily, all others shift the indices.
+      invalidateIndices(true);
+    }
     mObjects.insert(index, obj);
     obj->onEdited.attach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementAdded);
   }
   std::shared_ptr<T> takeElement(int index) noexcept {
+    invalidateIndices(true);
     std::shared_ptr<T> obj = mObjects.takeAt(index);
     obj->onEdited.detach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementRemoved);
     return obj;
   }
   void elementEditedHandler(const T& obj, OnEditedArgs... args) noexcept {
-    int index = indexOf(&obj);
+    int index = indexOf(&obj);  // Pointers never change, index stays valid.
     if (contains(index)) {
+      updateIndicesAfterEdit(index);
       onElementEdited.notify(index, at(index), args...);
       onEdited.notify(index, at(index), Event::ElementEdited);
     } else {
@@ -486,6 +522,74 @@ protected:  // Methods
   }
 
 private:  // Internal Helper Methods
+  template <typename K, typename F>
+  int indexOfIndexed(QHash<K, int>& index, int& indexedCount, const K& key,
+                     F getKey) const noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    auto sync = [&]() {
+      for (; indexedCount < mObjects.count(); ++indexedCount) {
+        const K k = getKey(mObjects.at(indexedCount));
+        if (!index.contains(k)) {
+          index.insert(k, indexedCount);  // Keep the first occurrence.
+        }
+      }
+    };
+    sync();
+    int i = index.value(key, -1);
+    if ((i >= 0) &&
+        ((i >= mObjects.count()) || (getKey(mObjects.at(i)) != key))) {
+      // Index is outdated (e.g. element modified without notification).
+      index.clear();
+      indexedCount = 0;
+      sync();
+      i = index.value(key, -1);
+    }
+    return i;
+  }
+  void updateIndicesAfterEdit(int i) noexcept {
+    // Most edits (e.g. moving an element) neither change the UUID nor the
+    // name, so the indices are only dropped if they are wrong for the new
+    // keys. Entries of an old key are detected as outdated on lookup.
+    QMutexLocker lock(&mIndexMutex);
+    if constexpr (requires(const T& t) { t.getUuid(); }) {
+      keepIndexIfValid(mUuidIndex, mUuidIndexCount, i,
+                       mObjects.at(i)->getUuid(),
+                       [this](int k) { return mObjects.at(k)->getUuid(); });
+    }
+    if constexpr (requires(const T& t) { t.getName(); }) {
+      keepIndexIfValid(
+          mNameIndex, mNameIndexCount, i, asStr(mObjects.at(i)->getName()),
+          [this](int k) { return asStr(mObjects.at(k)->getName()); });
+    }
+  }
+  template <typename K, typename F>
+  void keepIndexIfValid(QHash<K, int>& index, int& indexedCount, int i,
+                        const K& key, F keyAt) noexcept {
+    if (i >= indexedCount) {
+      return;  // Element not indexed yet.
+    }
+    // The index must point to the first element with this key.
+    const int k = index.value(key, -1);
+    if ((k < 0) || (k > i) || (keyAt(k) != key)) {
+      index.clear();
+      indexedCount = 0;
+    }
+  }
+  void invalidateIndices(bool includingPointers) noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    if (includingPointers && (mPointerIndexCount > 0)) {
+      mPointerIndex.clear();
+      mPointerIndexCount = 0;
+    }
+    if (mUuidIndexCount > 0) {
+      mUuidIndex.clear();
+      mUuidIndexCount = 0;
+    }
+    if (mNameIndexCount > 0) {
+      mNameIndex.clear();
+      mNameIndexCount = 0;
+    }
+  }
   std::shared_ptr<T> copyObject(const T& other,
                                 std::true_type copyConstructable) noexcept {
     Q_UNUSED(copyConstructable);
@@ -505,6 +609,15 @@ private:  // Internal Helper Methods
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   Slot<T, OnEditedArgs...> mOnEditedSlot;
+
+private:  // Lookup Indices
+  mutable QMutex mIndexMutex;
+  mutable QHash<const T*, int> mPointerIndex;
+  mutable int mPointerIndexCount = 0;  ///< Number of indexed elements
+  mutable QHash<Uuid, int> mUuidIndex;
+  mutable int mUuidIndexCount = 0;  ///< Number of indexed elements
+  mutable QHash<QString, int> mNameIndex;
+  mutable int mNameIndexCount = 0;  ///< Number of indexed elements
 };
 
 }  // namespace librepcb
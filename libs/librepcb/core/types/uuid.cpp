@@ -25,7 +25,6 @@
 #include "../exceptions.h"
 #include "../serialization/sexpression.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -39,73 +38,49 @@ Uuid::~Uuid() noexcept {
 #endif
 
 /*******************************************************************************
- *  Static Methods
+ *  Getters
  ******************************************************************************/
 
-bool Uuid::isValid(const QString& str) noexcept {
-  // Note: This used to be done using a RegEx, but when profiling and
-  // optimizing the library rescan code we found that a manually unrolled
-  // comparison loop performs much better than the previous RegEx.
-  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
-  if (str.length() != 36) return false;
-
-  // Helper function
-  auto isLowerHex = [](const QChar& chr) {
-    return (chr >= QChar('0') && chr <= QChar('9')) ||
-        (chr >= QChar('a') && chr <= QChar('f'));
+QString Uuid::toStr() const noexcept {
+  static constexpr char sHexDigits[] = "0123456789abcdef";
+  QString str(36, Qt::Uninitialized);
+  QChar* out = str.data();
+  int pos = 0;
+  auto appendHex = [&](quint64 value, int digits) {
+    for (int i = digits - 1; i >= 0; --i) {
+      out[pos++] = QLatin1Char(sHexDigits[(value >> (i * 4)) & 0xF]);
+    }
   };
+  appendHex(mHi >> 32, 8);
+  out[pos++] = QLatin1Char('-');
+  appendHex(mHi >> 16, 4);
+  out[pos++] = QLatin1Char('-');
+  appendHex(mHi, 4);
+  out[pos++] = QLatin1Char('-');
+  appendHex(mLo >> 48, 4);
+  out[pos++] = QLatin1Char('-');
+  appendHex(mLo, 12);
+  return str;
+}
 
-  if (!isLowerHex(str[0])) return false;
-  if (!isLowerHex(str[1])) return false;
-  if (!isLowerHex(str[2])) return false;
-  if (!isLowerHex(str[3])) return false;
-  if (!isLowerHex(str[4])) return false;
-  if (!isLowerHex(str[5])) return false;
-  if (!isLowerHex(str[6])) return false;
-  if (!isLowerHex(str[7])) return false;
-  if (str[8] != QChar('-')) return false;
-  if (!isLowerHex(str[9])) return false;
-  if (!isLowerHex(str[10])) return false;
-  if (!isLowerHex(str[11])) return false;
-  if (!isLowerHex(str[12])) return false;
-  if (str[13] != QChar('-')) return false;
-  if (!isLowerHex(str[14])) return false;
-  if (!isLowerHex(str[15])) return false;
-  if (!isLowerHex(str[16])) return false;
-  if (!isLowerHex(str[17])) return false;
-  if (str[18] != QChar('-')) return false;
-  if (!isLowerHex(str[19])) return false;
-  if (!isLowerHex(str[20])) return false;
-  if (!isLowerHex(str[21])) return false;
-  if (!isLowerHex(str[22])) return false;
-  if (str[23] != QChar('-')) return false;
-  if (!isLowerHex(str[24])) return false;
-  if (!isLowerHex(str[25])) return false;
-  if (!isLowerHex(str[26])) return false;
-  if (!isLowerHex(str[27])) return false;
-  if (!isLowerHex(str[28])) return false;
-  if (!isLowerHex(str[29])) return false;
-  if (!isLowerHex(str[30])) return false;
-  if (!isLowerHex(str[31])) return false;
-  if (!isLowerHex(str[32])) return false;
-  if (!isLowerHex(str[33])) return false;
-  if (!isLowerHex(str[34])) return false;
-  if (!isLowerHex(str[35])) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
 
-  return true;
+bool Uuid::isValid(const QString& str) noexcept {
+  quint64 hi, lo;
+  return parse(str, hi, lo);
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  const QByteArray data = QUuid::createUuid().toRfc4122();
+  quint64 hi = 0, lo = 0;
+  if (data.size() == 16) {
+    hi = qFromBigEndian<quint64>(data.constData());
+    lo = qFromBigEndian<quint64>(data.constData() + 8);
+  }
+  if (isValidVariantAndVersion(hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     // Calls abort()!
     qFatal("Not able to generate valid random UUID, terminating application!");
@@ -113,8 +88,9 @@ Uuid Uuid::createRandom() noexcept {
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 hi, lo;
+  if (parse(str, hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("String is not a valid UUID: \"%1\"").arg(str));
@@ -122,13 +98,53 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 std::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 hi, lo;
+  if (parse(str, hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     return std::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& hi, quint64& lo) noexcept {
+  // Note: This used to be done using a RegEx, but when profiling and
+  // optimizing the library rescan code we found that a manually unrolled
+  // comparison loop performs much better than the previous RegEx.
+  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
+  // Nowadays the string is validated and converted to integers in one pass.
+  if (str.length() != 36) return false;
+
+  const QChar* data = str.constData();
+  hi = 0;
+  lo = 0;
+  int digits = 0;
+  for (int i = 0; i < 36; ++i) {
+    const char16_t chr = data[i].unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (chr != u'-') return false;
+      continue;
+    }
+    quint64 nibble;
+    if ((chr >= u'0') && (chr <= u'9')) {
+      nibble = chr - u'0';
+    } else if ((chr >= u'a') && (chr <= u'f')) {
+      nibble = chr - u'a' + 10;
+    } else {
+      return false;  // Note: Uppercase characters are not allowed.
+    }
+    quint64& half = (digits < 16) ? hi : lo;
+    half = (half << 4) | nibble;
+    ++digits;
+  }
+
+  // check type of uuid
+  return isValidVariantAndVersion(hi, lo);
+}
+
 /*******************************************************************************
  *  Non-Member Functions
  ******************************************************************************/
@@ -46,6 +46,13 @@ namespace librepcb {
  *
  * A valid UUID looks like this: "d79d354b-62bd-4866-996a-78941c575e78"
  *
+ * Internally the UUID is stored as two 64-bit integers (the big-endian halves
+ * of the 128-bit value), so copying, comparing and hashing is cheap. The
+ * string representation is only created on demand with #toStr(). Since the
+ * string representation has a fixed format with lowercase hex digits, the
+ * ordering of the integer representation is identical to the ordering of the
+ * string representation.
+ *
  * @note This class guarantees that only Uuid objects representing a valid UUID
  * can be created (in opposite to QUuid which allows "Null UUIDs")! If you need
  * a nullable UUID, use std::optional<librepcb::Uuid> instead.
@@ -69,7 +76,7 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHi(other.mHi), mLo(other.mLo) {}
 
   /**
    * @brief Destructor
@@ -88,7 +95,7 @@ public:
    *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -96,18 +103,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (same result as comparing them
+   *         as strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHi = rhs.mHi;
+    mLo = rhs.mLo;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHi == rhs.mHi) && (mLo == rhs.mLo);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHi < rhs.mHi) || ((mHi == rhs.mHi) && (mLo < rhs.mLo));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -153,14 +166,42 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its integer halves
+   *
+   * @param hi        The upper 64 bits of the UUID
+   * @param lo        The lower 64 bits of the UUID
+   */
+  Uuid(quint64 hi, quint64 lo) noexcept : mHi(hi), mLo(lo) {}
+
+  /**
+   * @brief Parse and validate a UUID string
+   *
+   * @param str       The string to parse
+   * @param hi        Output for the upper 64 bits
+   * @param lo        Output for the lower 64 bits
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @retval true     If str is a valid UUID (outputs are set)
+   * @retval false    If str is not a valid UUID (outputs are undefined)
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  static bool parse(const QString& str, quint64& hi, quint64& lo) noexcept;
+
+  /**
+   * @brief Check if the given integer halves represent a valid UUID
+   *
+   * @param hi        The upper 64 bits of the UUID
+   * @param lo        The lower 64 bits of the UUID
+   *
+   * @return Whether it is a DCE UUID of version 4 (random)
+   */
+  static bool isValidVariantAndVersion(quint64 hi, quint64 lo) noexcept {
+    return (((hi >> 12) & 0xF) == 4) && ((lo >> 62) == 2);
+  }
+
+  friend std::size_t qHash(const Uuid& key, std::size_t seed) noexcept;
 
 private:  // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+  quint64 mHi;  ///< Upper 64 bits, guaranteed to be part of a valid UUID
+  quint64 mLo;  ///< Lower 64 bits, guaranteed to be part of a valid UUID
 };
 
 /*******************************************************************************
@@ -178,7 +219,7 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline std::size_t qHash(const Uuid& key, std::size_t seed = 0) noexcept {
-  return ::qHash(key.toStr(), seed);
+  return qHashMulti(seed, key.mHi, key.mLo);
 }
 
 }  // namespace librepcb
@@ -186,7 +227,7 @@ inline std::size_t qHash(const Uuid& key, std::size_t seed = 0) noexcept {
 namespace std {
 inline size_t qHash(const optional<librepcb::Uuid>& key,
                     size_t seed = 0) noexcept {
-  return ::qHash(key ? key->toStr() : QString(), seed);
+  return key ? librepcb::qHash(*key, seed) : ::qHash(QString(), seed);
 }
 }  // namespace std
 
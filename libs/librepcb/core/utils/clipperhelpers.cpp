@@ -22,13 +22,21 @@
  ******************************************************************************/
 #include "clipperhelpers.h"
 
+#include <QtConcurrent>
 #include <QtCore>
 
+#include <algorithm>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+// Maximum number of areas united in a single Clipper sweep by uniteBatched().
+// Larger groups are split and processed in parallel.
+static constexpr int sUniteBatchSize = 64;
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -145,6 +153,34 @@ std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteToTree(
   }
 }
 
+ClipperLib::Paths ClipperHelpers::uniteBatched(
+    const QVector<ClipperLib::Paths>& areas,
+    ClipperLib::PolyFillType fillType) {
+  const QVector<int> order = sortAreasByPosition(areas);
+  return uniteBatchedRange(areas, order, 0, order.count(), fillType);
+}
+
+std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteBatchedToTree(
+    const QVector<ClipperLib::Paths>& areas,
+    ClipperLib::PolyFillType fillType) {
+  try {
+    // Wrap the PolyTree object in a smart pointer since PolyTree cannot
+    // safely be copied (i.e. returned by value), it would lead to a crash!!!
+    std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
+    const QVector<int> order = sortAreasByPosition(areas);
+    ClipperLib::Clipper c;
+    addBatchedAreas(c, areas, order, 0, order.count(), fillType);
+    c.Execute(ClipperLib::ctUnion, *result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const Exception&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Failed to unite paths: %1").arg(e.what()));
+  }
+}
+
 void ClipperHelpers::intersect(ClipperLib::Paths& subject,
                                const ClipperLib::Paths& clip,
                                ClipperLib::PolyFillType subjectFillType,
@@ -294,20 +330,8 @@ ClipperLib::Paths ClipperHelpers::treeToPaths(
 ClipperLib::Paths ClipperHelpers::flattenTree(
     const ClipperLib::PolyNode& node) {
   ClipperLib::Paths paths;
-  for (const ClipperLib::PolyNode* outlineChild : node.Childs) {
-    Q_ASSERT(outlineChild);
-    if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-    ClipperLib::Paths holes;
-    for (ClipperLib::PolyNode* holeChild : outlineChild->Childs) {
-      Q_ASSERT(holeChild);
-      if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
-      holes.push_back(holeChild->Contour);
-      ClipperLib::Paths subpaths = flattenTree(*holeChild);  // can throw
-      paths.insert(paths.end(), subpaths.begin(), subpaths.end());
-    }
-    paths.push_back(
-        convertHolesToCutIns(outlineChild->Contour, holes));  // can throw
-  }
+  paths.reserve(node.ChildCount());
+  flattenTreeTo(node, paths);  // can throw
   return paths;
 }
 
@@ -370,19 +394,39 @@ ClipperLib::IntPoint ClipperHelpers::convert(const Point& point) noexcept {
  *  Internal Helper Methods
  ******************************************************************************/
 
+void ClipperHelpers::flattenTreeTo(const ClipperLib::PolyNode& node,
+                                   ClipperLib::Paths& paths) {
+  ClipperLib::Paths holes;
+  for (const ClipperLib::PolyNode* outlineChild : node.Childs) {
+    Q_ASSERT(outlineChild);
+    if (outlineChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+    holes.clear();
+    for (ClipperLib::PolyNode* holeChild : outlineChild->Childs) {
+      Q_ASSERT(holeChild);
+      if (!holeChild->IsHole()) throw LogicError(__FILE__, __LINE__);
+      holes.push_back(holeChild->Contour);
+      flattenTreeTo(*holeChild, paths);  // can throw
+    }
+    paths.push_back(
+        convertHolesToCutIns(outlineChild->Contour, holes));  // can throw
+  }
+}
+
 ClipperLib::Path ClipperHelpers::convertHolesToCutIns(
     const ClipperLib::Path& outline, const ClipperLib::Paths& holes) {
-  ClipperLib::Path path = outline;
+  ClipperLib::Path path;
+  std::size_t size = outline.size();
+  for (const ClipperLib::Path& hole : holes) {
+    size += hole.size() + 2;  // Hole plus connection points.
+  }
+  path.reserve(size);
+  path = outline;
   ClipperLib::Paths preparedHoles = prepareHoles(holes);
   for (const ClipperLib::Path& hole : preparedHoles) {
     addCutInToPath(path, hole);  // can throw
   }
   // Remove duplicates which might have been created by cut-ins.
-  for (std::size_t i = (path.size() - 1); i > 0; --i) {
-    if (path.at(i) == path.at(i - 1)) {
-      path.erase(path.begin() + i);
-    }
-  }
+  path.erase(std::unique(path.begin(), path.end()), path.end());
   return path;
 }
 
@@ -468,6 +512,137 @@ bool ClipperHelpers::calcIntersectionPos(const ClipperLib::IntPoint& p1,
   }
 }
 
+QVector<int> ClipperHelpers::sortAreasByPosition(
+    const QVector<ClipperLib::Paths>& areas) noexcept {
+  if (areas.isEmpty()) {
+    return QVector<int>();
+  }
+
+  // Determine the bounding box center of each area.
+  using Limits = std::numeric_limits<ClipperLib::cInt>;
+  const ClipperLib::cInt maxValue = Limits::max();
+  const ClipperLib::cInt minValue = Limits::min();
+  QVector<ClipperLib::IntPoint> centers;
+  centers.reserve(areas.count());
+  ClipperLib::IntRect bounds{maxValue, maxValue, minValue, minValue};
+  for (const ClipperLib::Paths& area : areas) {
+    ClipperLib::IntRect rect{maxValue, maxValue, minValue, minValue};
+    for (const ClipperLib::Path& path : area) {
+      for (const ClipperLib::IntPoint& p : path) {
+        rect.left = std::min(rect.left, p.X);
+        rect.top = std::min(rect.top, p.Y);
+        rect.right = std::max(rect.right, p.X);
+        rect.bottom = std::max(rect.bottom, p.Y);
+      }
+    }
+    ClipperLib::IntPoint center(0, 0);
+    if (rect.left <= rect.right) {
+      center.X = rect.left + (rect.right - rect.left) / 2;
+      center.Y = rect.top + (rect.bottom - rect.top) / 2;
+    }
+    bounds.left = std::min(bounds.left, center.X);
+    bounds.top = std::min(bounds.top, center.Y);
+    bounds.right = std::max(bounds.right, center.X);
+    bounds.bottom = std::max(bounds.bottom, center.Y);
+    centers.append(center);
+  }
+
+  // Sort the areas along a Z-order curve, so each contiguous range of areas
+  // covers a compact region of the plane.
+  const qreal width = std::max(bounds.right - bounds.left, ClipperLib::cInt(1));
+  const qreal height =
+      std::max(bounds.bottom - bounds.top, ClipperLib::cInt(1));
+  QVector<std::pair<quint32, int>> keys;
+  keys.reserve(centers.count());
+  for (int i = 0; i < centers.count(); ++i) {
+    const ClipperLib::IntPoint& center = centers.at(i);
+    const quint32 x = qRound(qreal(center.X - bounds.left) * 65535 / width);
+    const quint32 y = qRound(qreal(center.Y - bounds.top) * 65535 / height);
+    keys.append(std::make_pair(calcMortonKey(x, y), i));
+  }
+  std::sort(keys.begin(), keys.end());
+  QVector<int> order;
+  order.reserve(keys.count());
+  for (const auto& key : keys) {
+    order.append(key.second);
+  }
+  return order;
+}
+
+quint32 ClipperHelpers::calcMortonKey(quint32 x, quint32 y) noexcept {
+  // Interleave the lower 16 bits of x and y.
+  auto spread = [](quint32 v) {
+    v &= 0x0000FFFF;
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+  };
+  return spread(x) | (spread(y) << 1);
+}
+
+void ClipperHelpers::addBatchedAreas(ClipperLib::Clipper& c,
+                                     const QVector<ClipperLib::Paths>& areas,
+                                     const QVector<int>& order, int begin,
+                                     int end,
+                                     ClipperLib::PolyFillType fillType) {
+  if ((end - begin) <= sUniteBatchSize) {
+    // Normalize each area on its own, so the results of all areas can be
+    // united with the non-zero fill type in a single sweep.
+    ClipperLib::Clipper normalizer;
+    ClipperLib::Paths area;
+    for (int i = begin; i < end; ++i) {
+      normalizer.Clear();
+      normalizer.AddPaths(areas.at(order.at(i)), ClipperLib::ptSubject, true);
+      normalizer.Execute(ClipperLib::ctUnion, area, fillType, fillType);
+      c.AddPaths(area, ClipperLib::ptSubject, true);
+    }
+  } else {
+    // Unite both halves in parallel. Note that waiting for the future runs
+    // the task in this thread if no worker thread picked it up yet, thus
+    // this does not deadlock even if the thread pool is exhausted.
+    const int middle = begin + (end - begin) / 2;
+    QFuture<ClipperLib::Paths> future = QtConcurrent::run([&, begin, middle]() {
+      return uniteBatchedRange(areas, order, begin, middle, fillType);
+    });
+    ClipperLib::Paths second;
+    try {
+      second = uniteBatchedRange(areas, order, middle, end, fillType);
+    } catch (...) {
+      // The task references the arguments, thus wait until it is finished
+      // before they might get destroyed while unwinding.
+      try {
+        future.waitForFinished();
+      } catch (...) {
+        // Only the first exception is rethrown.
+      }
+      throw;
+    }
+    const ClipperLib::Paths first = future.result();  // can throw
+    c.AddPaths(first, ClipperLib::ptSubject, true);
+    c.AddPaths(second, ClipperLib::ptSubject, true);
+  }
+}
+
+ClipperLib::Paths ClipperHelpers::uniteBatchedRange(
+    const QVector<ClipperLib::Paths>& areas, const QVector<int>& order,
+    int begin, int end, ClipperLib::PolyFillType fillType) {
+  try {
+    ClipperLib::Paths result;
+    ClipperLib::Clipper c;
+    addBatchedAreas(c, areas, order, begin, end, fillType);
+    c.Execute(ClipperLib::ctUnion, result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const Exception&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     QString("Failed to unite paths: %1").arg(e.what()));
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -69,6 +69,26 @@ public:
       const ClipperLib::Paths& paths, const ClipperLib::Paths& clip,
       ClipperLib::PolyFillType subjectFillType,
       ClipperLib::PolyFillType clipFillType);
+
+  /**
+   * @brief Unite a large number of areas in parallel
+   *
+   * Each area is evaluated on its own with the given fill type, then all
+   * areas are united. The areas are sorted by their position to unite
+   * spatially local groups in parallel, and the partial results are merged
+   * hierarchically. This is much faster than a single Clipper sweep when
+   * uniting thousands of small areas, e.g. the copper of a whole layer.
+   *
+   * @param areas     The areas to unite.
+   * @param fillType  The fill type to evaluate each area with.
+   * @return The united paths, equal to the union of all areas.
+   */
+  static ClipperLib::Paths uniteBatched(const QVector<ClipperLib::Paths>& areas,
+                                        ClipperLib::PolyFillType fillType);
+  static std::unique_ptr<ClipperLib::PolyTree> uniteBatchedToTree(
+      const QVector<ClipperLib::Paths>& areas,
+      ClipperLib::PolyFillType fillType);
+
   static void intersect(ClipperLib::Paths& subject,
                         const ClipperLib::Paths& clip,
                         ClipperLib::PolyFillType subjectFillType,
@@ -108,6 +128,18 @@ public:
   static ClipperLib::IntPoint convert(const Point& point) noexcept;
 
 private:  // Internal Helper Methods
+  static void flattenTreeTo(const ClipperLib::PolyNode& node,
+                            ClipperLib::Paths& paths);
+  static QVector<int> sortAreasByPosition(
+      const QVector<ClipperLib::Paths>& areas) noexcept;
+  static quint32 calcMortonKey(quint32 x, quint32 y) noexcept;
+  static void addBatchedAreas(ClipperLib::Clipper& c,
+                              const QVector<ClipperLib::Paths>& areas,
+                              const QVector<int>& order, int begin, int end,
+                              ClipperLib::PolyFillType fillType);
+  static ClipperLib::Paths uniteBatchedRange(
+      const QVector<ClipperLib::Paths>& areas, const QVector<int>& order,
+      int begin, int end, ClipperLib::PolyFillType fillType);
   static ClipperLib::Path convertHolesToCutIns(const ClipperLib::Path& outline,
                                                const ClipperLib::Paths& holes);
   static ClipperLib::Paths prepareHoles(
@@ -0,0 +1,120 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CORE_CONCURRENTCACHE_H
+#define LIBREPCB_CORE_CONCURRENTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <exception>
+#include <future>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ConcurrentCache
+ ******************************************************************************/
+
+/**
+ * @brief Thread-safe cache creating each value only once
+ *
+ * If several threads request the same key at the same time, only the first
+ * one creates the value while the others wait for it. If the creation throws
+ * an exception, it is rethrown to all threads requesting that key.
+ *
+ * @tparam Key    Key type, must be usable as key of QHash.
+ * @tparam T      Value type, must be copyable (e.g. a std::shared_ptr).
+ */
+template <typename Key, typename T>
+class ConcurrentCache final {
+public:
+  // Constructors / Destructor
+  ConcurrentCache() noexcept : mMutex(), mValues() {}
+  ConcurrentCache(const ConcurrentCache& other) = delete;
+  ~ConcurrentCache() noexcept {}
+
+  // General Methods
+  int count() const noexcept {
+    QMutexLocker lock(&mMutex);
+    return mValues.count();
+  }
+
+  void clear() noexcept {
+    QMutexLocker lock(&mMutex);
+    mValues.clear();
+  }
+
+  /**
+   * @brief Get the value of a key, create it if not cached yet
+   *
+   * @param key     The key to look up.
+   * @param create  Function returning the value, called only on cache miss.
+   *                Called without holding any lock.
+   *
+   * @return The cached or newly created value.
+   *
+   * @throw Any exception thrown by `create`.
+   */
+  template <typename Fun>
+  T get(const Key& key, Fun create) {
+    std::promise<T> promise;
+    std::shared_future<T> future;
+    bool isCreator = false;
+    {
+      QMutexLocker lock(&mMutex);
+      auto it = mValues.find(key);
+      if (it == mValues.end()) {
+        future = promise.get_future().share();
+        mValues.insert(key, future);
+        isCreator = true;
+      } else {
+        future = *it;
+      }
+    }
+    if (isCreator) {
+      try {
+        promise.set_value(create());  // can throw
+      } catch (...) {
+        promise.set_exception(std::current_exception());
+      }
+    }
+    return future.get();  // can throw
+  }
+
+  // Operator Overloadings
+  ConcurrentCache& operator=(const ConcurrentCache& rhs) = delete;
+
+private:  // Data
+  mutable QMutex mMutex;
+  QHash<Key, std::shared_future<T>> mValues;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif
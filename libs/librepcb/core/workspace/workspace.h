@@ -97,6 +97,13 @@ public:
    */
   const FilePath& getDataPath() const { return mDataPath; }
 
+  /**
+   * @brief Get the filepath to the "data/cache" directory in the workspace
+   *
+   * Contains only files which can be regenerated at any time.
+   */
+  FilePath getCachePath() const { return mDataPath.getPathTo("cache"); }
+
   /**
    * @brief Get the filepath to the "data/libraries" directory in the workspace
    */
@@ -25,6 +25,7 @@
 #include "opengltriangleobject.h"
 
 #include <librepcb/core/3d/occmodel.h>
+#include <librepcb/core/algorithm/polygontriangulator.h>
 #include <librepcb/core/exceptions.h>
 #include <librepcb/core/fileio/filesystem.h>
 #include <librepcb/core/fileio/fileutils.h>
@@ -33,24 +34,10 @@
 #include <librepcb/core/utils/clipperhelpers.h>
 #include <librepcb/core/utils/scopeguard.h>
 #include <librepcb/core/utils/toolbox.h>
-#include <librepcb_build_env.h>
 
 #include <QtConcurrent>
 #include <QtCore>
 
-#if USE_GLU
-#ifdef __APPLE__
-#include <OpenGL/glu.h>
-#elif defined(Q_OS_WIN)
-#include <windef.h>
-// Including <windef.h> first fixes compile error on some systems, see
-// https://stackoverflow.com/questions/19198244/how-do-i-get-rid-of-these-compiler-errors-in-glu-h.
-#include <GL/glu.h>
-#else
-#include <GL/glu.h>
-#endif
-#endif
-
 Q_DECLARE_METATYPE(std::shared_ptr<librepcb::editor::OpenGlObject>)
 
 /*******************************************************************************
@@ -63,8 +50,15 @@ namespace editor {
  *  Constructors / Destructor
  ******************************************************************************/
 
-OpenGlSceneBuilder::OpenGlSceneBuilder(QObject* parent) noexcept
-  : QObject(parent), mMaxArcTolerance(5000), mFuture(), mAbort(false) {
+OpenGlSceneBuilder::OpenGlSceneBuilder(const FilePath& meshCacheDir,
+                                       QObject* parent) noexcept
+  : QObject(parent),
+    mMaxArcTolerance(5000),
+    mFuture(),
+    mAbort(false),
+    mTriangleObjectFactory(
+        []() { return std::make_shared<OpenGlTriangleObject>(); }),
+    mMeshCache(meshCacheDir) {
   qRegisterMetaType<std::shared_ptr<OpenGlObject>>();
 }
 
@@ -72,6 +66,16 @@ OpenGlSceneBuilder::~OpenGlSceneBuilder() noexcept {
   cancel();
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void OpenGlSceneBuilder::setTriangleObjectFactory(
+    TriangleObjectFactory factory) noexcept {
+  Q_ASSERT(!isBusy());
+  mTriangleObjectFactory = factory;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -131,6 +135,63 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
                      .arg(Layer::boardOutlines().getNameTr());
     }
 
+    // Start loading the STEP models of all devices in parallel already now,
+    // but publish the board first. Each distinct model is loaded only once.
+    // Note: A separate thread pool is used to avoid starving the global
+    // pool, and its destructor waits until all jobs are finished.
+    struct LoadedModel {
+      QString key;
+      StepModel model;
+      QString error;
+    };
+    QMutex loadedMutex;
+    QWaitCondition loadedCondition;
+    QQueue<LoadedModel> loadedModels;
+    QHash<QString, QList<const SceneData3D::DeviceData*>> devicesOfKey;
+    QThreadPool pool;
+    int pendingModels = 0;
+    if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
+      QHash<QString, QString> keysOfFile;
+      for (const auto& obj : data->getDevices()) {
+        auto keyIt = keysOfFile.find(obj.stepFile);
+        if (keyIt == keysOfFile.end()) {
+          const QByteArray content = fs->readIfExists(obj.stepFile);
+          const QString key = getStepModelKey(obj.stepFile, content);
+          if ((!key.isEmpty()) && (!mStepModels.contains(key)) &&
+              (!devicesOfKey.contains(key))) {
+            auto job = [this, key, content, &loadedMutex, &loadedCondition,
+                        &loadedModels]() {
+              LoadedModel loaded{key, StepModel(), QString()};
+              try {
+                if (!mAbort) {
+                  loaded.model = loadStepModel(key, content);
+                }
+              } catch (const Exception& e) {
+                loaded.error = e.getMsg();
+              }
+              QMutexLocker lock(&loadedMutex);
+              loadedModels.enqueue(loaded);
+              loadedCondition.wakeAll();
+            };
+            pool.start(job);
+            ++pendingModels;
+          }
+          keyIt = keysOfFile.insert(obj.stepFile, key);
+        }
+        if (!keyIt->isEmpty()) {
+          devicesOfKey[*keyIt].append(&obj);
+        }
+      }
+      for (auto it = mStepKeys.begin(); it != mStepKeys.end();) {
+        if (keysOfFile.contains(it.key())) {
+          ++it;
+        } else {
+          it = mStepKeys.erase(it);
+        }
+      }
+    }
+    if (mAbort) return;
+
     // Convert holes to areas.
     ClipperLib::Paths platedHoles =
         getPaths(data, {Layer::boardPlatedCutouts().getId()});
@@ -154,41 +215,59 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
                           ClipperLib::pftNonZero);
     if (mAbort) return;
 
+    // Triangulating the board layers is quite expensive, thus each layer is
+    // extruded in a worker thread while the geometry of the next layers is
+    // calculated. The layers are still published in their original order.
+    QList<std::tuple<QString, QColor, QFuture<QVector<QVector3D>>>> layerJobs;
+    auto publishLayers = [&](bool wait) {
+      while ((!layerJobs.isEmpty()) &&
+             (wait || std::get<2>(layerJobs.first()).isFinished())) {
+        const auto job = layerJobs.takeFirst();
+        publishTriangleData(std::get<0>(job), std::get<1>(job),
+                            std::get<2>(job).result());  // can throw
+        if (mAbort) return;
+      }
+    };
+    auto addLayer = [&](const QString& id, const QColor& color, auto func) {
+      layerJobs.append(std::make_tuple(id, color, QtConcurrent::run(func)));
+      publishLayers(false);
+    };
+
     // Board body.
     QStringList layers = {Layer::boardOutlines().getId()};
     const ClipperLib::Paths boardOutlines = getPaths(data, layers);
-    std::unique_ptr<ClipperLib::PolyTree> tree = ClipperHelpers::subtractToTree(
-        boardOutlines, allHoles, ClipperLib::pftNonZero,
-        ClipperLib::pftNonZero);
+    std::shared_ptr<ClipperLib::PolyTree> tree =
+        ClipperHelpers::subtractToTree(boardOutlines, allHoles,
+                                       ClipperLib::pftNonZero,
+                                       ClipperLib::pftNonZero);
     const ClipperLib::Paths boardArea = ClipperHelpers::flattenTree(*tree);
-    tree = ClipperHelpers::subtractToTree(boardOutlines, allHoles,
-                                          ClipperLib::pftNonZero,
-                                          ClipperLib::pftNonZero, false);
-    const ClipperLib::Paths boardEdges = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        Layer::boardOutlines().getId(), QColor(70, 80, 70),
-        extrude(boardArea, -d, 2 * d, scaleFactor, true, false) +
-            extrude(boardEdges, -d, 2 * d, scaleFactor, false, true, false));
+    const ClipperLib::Paths boardEdges = ClipperHelpers::treeToPaths(
+        *ClipperHelpers::subtractToTree(boardOutlines, allHoles,
+                                        ClipperLib::pftNonZero,
+                                        ClipperLib::pftNonZero, false));
+    addLayer(Layer::boardOutlines().getId(), QColor(70, 80, 70), [=]() {
+      return extrudeFaces(*tree, -d, 2 * d, scaleFactor) +
+          extrudeEdges(boardEdges, -d, 2 * d, scaleFactor, false);
+    });
     if (mAbort) return;
 
     // Plated holes.
-    tree = ClipperHelpers::intersectToTree(platedHoles, boardOutlines,
-                                           ClipperLib::pftNonZero,
-                                           ClipperLib::pftNonZero, false);
-    platedHoles = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        "pth", QColor(124, 104, 71),
-        extrude(platedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    platedHoles = ClipperHelpers::treeToPaths(*ClipperHelpers::intersectToTree(
+        platedHoles, boardOutlines, ClipperLib::pftNonZero,
+        ClipperLib::pftNonZero, false));
+    addLayer("pth", QColor(124, 104, 71), [=]() {
+      return extrudeEdges(platedHoles, -d, 2 * d, scaleFactor, false);
+    });
     if (mAbort) return;
 
     // Non-plated holes.
-    tree = ClipperHelpers::intersectToTree(nonPlatedHoles, boardOutlines,
-                                           ClipperLib::pftNonZero,
-                                           ClipperLib::pftNonZero, false);
-    nonPlatedHoles = ClipperHelpers::treeToPaths(*tree);
-    publishTriangleData(
-        "npth", QColor(50, 50, 50),
-        extrude(nonPlatedHoles, -d, 2 * d, scaleFactor, false, true, false));
+    nonPlatedHoles =
+        ClipperHelpers::treeToPaths(*ClipperHelpers::intersectToTree(
+            nonPlatedHoles, boardOutlines, ClipperLib::pftNonZero,
+            ClipperLib::pftNonZero, false));
+    addLayer("npth", QColor(50, 50, 50), [=]() {
+      return extrudeEdges(nonPlatedHoles, -d, 2 * d, scaleFactor, false);
+    });
     if (mAbort) return;
 
     for (bool top : {false, true}) {
@@ -206,10 +285,9 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
       tree = ClipperHelpers::intersectToTree(copperArea, getPaths(data, layers),
                                              ClipperLib::pftEvenOdd,
                                              ClipperLib::pftNonZero);
-      ClipperLib::Paths paths = ClipperHelpers::flattenTree(*tree);
-      publishTriangleData(
-          layers.first(), QColor(188, 156, 105),
-          extrude(paths, (d - epsilon) * side, 0.035 * side, scaleFactor));
+      addLayer(layers.first(), QColor(188, 156, 105), [=]() {
+        return extrude(*tree, (d - epsilon) * side, 0.035 * side, scaleFactor);
+      });
       if (mAbort) return;
 
       // Solder resist.
@@ -229,11 +307,13 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
         tree = ClipperHelpers::offsetToTree(solderResist, Length(-50),
                                             mMaxArcTolerance);
         solderResist = ClipperHelpers::flattenTree(*tree);
-        publishTriangleData(layers.first(), color->toSolderResistColor(),
-                            extrude(solderResist, (d + epsilon) * side,
-                                    0.05 * side, scaleFactor));
+        addLayer(layers.first(), color->toSolderResistColor(), [=]() {
+          return extrude(*tree, (d + epsilon) * side, 0.05 * side,
+                         scaleFactor);
+        });
       } else {
-        publishTriangleData(layers.first(), Qt::transparent, {});
+        addLayer(layers.first(), Qt::transparent,
+                 []() { return QVector<QVector3D>(); });
       }
       if (mAbort) return;
 
@@ -242,10 +322,9 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
       tree = ClipperHelpers::intersectToTree(boardArea, getPaths(data, layers),
                                              ClipperLib::pftEvenOdd,
                                              ClipperLib::pftNonZero);
-      paths = ClipperHelpers::flattenTree(*tree);
-      publishTriangleData(
-          layers.first(), Qt::darkGray,
-          extrude(paths, (d + 0.036) * side, 0.03 * side, scaleFactor));
+      addLayer(layers.first(), Qt::darkGray, [=]() {
+        return extrude(*tree, (d + 0.036) * side, 0.03 * side, scaleFactor);
+      });
       if (mAbort) return;
 
       // Silkscreen.
@@ -259,33 +338,58 @@ void OpenGlSceneBuilder::run(std::shared_ptr<SceneData3D> data) noexcept {
         tree = ClipperHelpers::intersectToTree(
             solderResist, getPaths(data, layers), ClipperLib::pftEvenOdd,
             ClipperLib::pftNonZero);
-        paths = ClipperHelpers::flattenTree(*tree);
-        publishTriangleData(
-            transform.map(Layer::topLegend()).getId(),
-            color->toSilkscreenColor(),
-            extrude(paths, (d + 0.052) * side, 0.01 * side, scaleFactor));
+        addLayer(transform.map(Layer::topLegend()).getId(),
+                 color->toSilkscreenColor(), [=]() {
+                   return extrude(*tree, (d + 0.052) * side, 0.01 * side,
+                                  scaleFactor);
+                 });
       } else {
-        publishTriangleData(transform.map(Layer::topLegend()).getId(),
-                            Qt::transparent, {});
+        addLayer(transform.map(Layer::topLegend()).getId(), Qt::transparent,
+                 []() { return QVector<QVector3D>(); });
       }
       if (mAbort) return;
     }
+    publishLayers(true);
+    if (mAbort) return;
 
-    // Add/update devices.
-    QSet<Uuid> deviceUuids;
-    if (std::shared_ptr<FileSystem> fs = data->getFileSystem()) {
-      for (const auto& obj : data->getDevices()) {
-        const QByteArray content = fs->readIfExists(obj.stepFile);
-        publishDevice(obj, content, d + 0.067, scaleFactor,
-                      data->getStepAlphaValue());
-        deviceUuids.insert(obj.uuid);
+    // Add/update devices, starting with those already loaded before.
+    const qreal deviceZ = d + 0.067;
+    const qreal alpha = data->getStepAlphaValue();
+    for (auto it = devicesOfKey.begin(); it != devicesOfKey.end(); it++) {
+      if (mStepModels.contains(it.key())) {
+        publishModel(it.key(), mStepModels.value(it.key()), it.value(),
+                     deviceZ, scaleFactor, alpha);
         if (mAbort) return;
       }
     }
 
-    // Remove all no longer existing devices.
-    foreach (const Uuid& uuid, Toolbox::toSet(mDevices.keys()) - deviceUuids) {
-      foreach (auto obj, mDevices.take(uuid)) {
+    // Publish all other devices as soon as their model is loaded.
+    for (int i = 0; i < pendingModels; ++i) {
+      LoadedModel loaded;
+      {
+        QMutexLocker lock(&loadedMutex);
+        while (loadedModels.isEmpty()) {
+          loadedCondition.wait(&loadedMutex);
+        }
+        loaded = loadedModels.dequeue();
+      }
+      if (mAbort) return;
+      const QList<const SceneData3D::DeviceData*> devices =
+          devicesOfKey.value(loaded.key);
+      if ((!loaded.error.isEmpty()) && (!devices.isEmpty())) {
+        qCritical().nospace() << "Failed to draw 3D model of "
+                              << devices.first()->name << ": " << loaded.error;
+      }
+      mStepModels.insert(loaded.key, loaded.model);
+      publishModel(loaded.key, loaded.model, devices, deviceZ, scaleFactor,
+                   alpha);
+    }
+
+    // Remove all no longer used models.
+    const QSet<QString> obsoleteKeys =
+        Toolbox::toSet(mModels.keys()) - Toolbox::toSet(devicesOfKey.keys());
+    foreach (const QString& key, obsoleteKeys) {
+      foreach (auto obj, mModels.take(key)) {
         emit objectRemoved(obj);
       }
     }
@@ -309,97 +413,65 @@ ClipperLib::Paths OpenGlSceneBuilder::getPaths(
   return paths;
 }
 
-QVector<QVector3D> OpenGlSceneBuilder::extrude(const ClipperLib::Paths& paths,
-                                               qreal z, qreal height,
-                                               qreal scaleFactor, bool faces,
-                                               bool edges, bool closed) const {
+QVector<QVector3D> OpenGlSceneBuilder::extrude(
+    const ClipperLib::PolyTree& tree, qreal z, qreal height,
+    qreal scaleFactor) {
+  ClipperLib::Paths contours;
+  ClipperLib::ClosedPathsFromPolyTree(tree, contours);
+  return extrudeFaces(tree, z, height, scaleFactor) +
+      extrudeEdges(contours, z, height, scaleFactor, true);
+}
+
+QVector<QVector3D> OpenGlSceneBuilder::extrudeFaces(
+    const ClipperLib::PolyTree& tree, qreal z, qreal height,
+    qreal scaleFactor) {
   const qreal z0 = z * scaleFactor;
   const qreal z1 = (z + height) * scaleFactor;
+  const ClipperLib::Path vertices = PolygonTriangulator::triangulate(tree);
 
   QVector<QVector3D> triangles;
-  for (const ClipperLib::Path& path : paths) {
-    if (faces) {
-      const QVector<QVector3D> newTriangles = tesselate(path, z0, scaleFactor);
-      triangles += newTriangles;
-      foreach (const QVector3D& vertex, newTriangles) {
-        triangles.append(QVector3D(vertex.x(), vertex.y(), z1));
-      }
-    }
-
-    if (edges) {
-      const std::size_t size = closed ? path.size() : (path.size() - 1);
-      for (std::size_t i = 0; i < size; ++i) {
-        const ClipperLib::IntPoint pos0 = path.at(i);
-        const ClipperLib::IntPoint pos1 = path.at((i + 1) % path.size());
-        const QVector3D p0(pos0.X * scaleFactor * 1e-6,
-                           pos0.Y * scaleFactor * 1e-6, z0);
-        const QVector3D p1(pos0.X * scaleFactor * 1e-6,
-                           pos0.Y * scaleFactor * 1e-6, z1);
-        const QVector3D p2(pos1.X * scaleFactor * 1e-6,
-                           pos1.Y * scaleFactor * 1e-6, z1);
-        const QVector3D p3(pos1.X * scaleFactor * 1e-6,
-                           pos1.Y * scaleFactor * 1e-6, z0);
-        triangles.append(p0);
-        triangles.append(p1);
-        triangles.append(p2);
-        triangles.append(p2);
-        triangles.append(p3);
-        triangles.append(p0);
-      }
+  triangles.reserve(vertices.size() * 2);
+  for (qreal faceZ : {z0, z1}) {
+    for (const ClipperLib::IntPoint& vertex : vertices) {
+      triangles.append(QVector3D(vertex.X * scaleFactor * 1e-6,
+                                 vertex.Y * scaleFactor * 1e-6, faceZ));
     }
   }
   return triangles;
 }
 
-#if USE_GLU
-
-#ifndef CALLBACK
-#define CALLBACK
-#endif
-
-static void CALLBACK tessVertexCallback(const GLvoid* data, GLvoid* context) {
-  const GLdouble* vertex = static_cast<const GLdouble*>(data);
-  QVector<QVector3D>* triangles = static_cast<QVector<QVector3D>*>(context);
-  triangles->append(QVector3D(vertex[0], vertex[1], vertex[2]));
-}
-
-static void CALLBACK tessEdgeFlagCallback(GLboolean) {
-}
+QVector<QVector3D> OpenGlSceneBuilder::extrudeEdges(
+    const ClipperLib::Paths& paths, qreal z, qreal height, qreal scaleFactor,
+    bool closed) {
+  const qreal z0 = z * scaleFactor;
+  const qreal z1 = (z + height) * scaleFactor;
 
-#endif
-
-QVector<QVector3D> OpenGlSceneBuilder::tesselate(const ClipperLib::Path& path,
-                                                 qreal z, qreal scaleFactor) {
-  QVector<QVector3D> result;
-#if USE_GLU
-  QVector<GLdouble> input;
-  for (const ClipperLib::IntPoint& point : path) {
-    input.push_back(point.X * scaleFactor * 1e-6);
-    input.push_back(point.Y * scaleFactor * 1e-6);
-    input.push_back(z);
-  }
-  GLUtesselator* tess = gluNewTess();
-  gluTessCallback(tess, GLU_TESS_VERTEX_DATA,
-                  (void(CALLBACK*)())tessVertexCallback);
-  gluTessCallback(tess, GLU_TESS_EDGE_FLAG,
-                  (void(CALLBACK*)())tessEdgeFlagCallback);
-  gluTessNormal(tess, 0.0, 0.0, 1.0);
-  gluTessBeginPolygon(tess, &result);
-  gluTessBeginContour(tess);
-  for (std::size_t i = 0; i < path.size(); ++i) {
-    gluTessVertex(tess, &input[i * 3], &input[i * 3]);
+  QVector<QVector3D> triangles;
+  for (const ClipperLib::Path& path : paths) {
+    if (path.empty()) {
+      continue;
+    }
+    const std::size_t size = closed ? path.size() : (path.size() - 1);
+    for (std::size_t i = 0; i < size; ++i) {
+      const ClipperLib::IntPoint pos0 = path.at(i);
+      const ClipperLib::IntPoint pos1 = path.at((i + 1) % path.size());
+      const QVector3D p0(pos0.X * scaleFactor * 1e-6,
+                         pos0.Y * scaleFactor * 1e-6, z0);
+      const QVector3D p1(pos0.X * scaleFactor * 1e-6,
+                         pos0.Y * scaleFactor * 1e-6, z1);
+      const QVector3D p2(pos1.X * scaleFactor * 1e-6,
+                         pos1.Y * scaleFactor * 1e-6, z1);
+      const QVector3D p3(pos1.X * scaleFactor * 1e-6,
+                         pos1.Y * scaleFactor * 1e-6, z0);
+      triangles.append(p0);
+      triangles.append(p1);
+      triangles.append(p2);
+      triangles.append(p2);
+      triangles.append(p3);
+      triangles.append(p0);
+    }
   }
-  gluTessEndContour(tess);
-  gluTessEndPolygon(tess);
-  gluDeleteTess(tess);
-#else
-  Q_UNUSED(path);
-  Q_UNUSED(z);
-  Q_UNUSED(scaleFactor);
-  qWarning() << "Could not tesselate 3D surface because LibrePCB was compiled "
-                "without GLU library.";
-#endif
-  return result;
+  return triangles;
 }
 
 void OpenGlSceneBuilder::publishTriangleData(
@@ -410,60 +482,73 @@ void OpenGlSceneBuilder::publishTriangleData(
     obj->setData(color, triangles);
     emit objectUpdated(obj);
   } else {
-    obj = std::make_shared<OpenGlTriangleObject>();
+    obj = mTriangleObjectFactory();
     obj->setData(color, triangles);
     mBoardObjects[id] = obj;
     emit objectAdded(obj);
   }
 }
 
-void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
-                                       const QByteArray& stepContent, qreal z,
-                                       qreal scaleFactor, qreal alpha) {
-  StepModel model;
-  if (mStepModels.contains(stepContent)) {
-    model = mStepModels.value(stepContent);
-  } else {
-    if (stepContent.size()) {
-      try {
-        std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
-        model = occModel->tesselate();
-      } catch (const Exception& e) {
-        qCritical().nospace()
-            << "Failed to draw 3D model of " << obj.name << ": " << e.getMsg();
-      }
-    }
-    mStepModels.insert(stepContent, model);
+QString OpenGlSceneBuilder::getStepModelKey(const QString& stepFile,
+                                            const QByteArray& content) {
+  // Calculating the digest of big STEP files is expensive, thus it is
+  // calculated only once per file as long as its content does not change.
+  if (content.isEmpty()) {
+    mStepKeys.remove(stepFile);
+    return QString();
+  }
+  auto it = mStepKeys.find(stepFile);
+  if ((it == mStepKeys.end()) || (it->first != content)) {
+    it = mStepKeys.insert(
+        stepFile, std::make_pair(content, StepMeshCache::calcKey(content)));
   }
+  return it->second;
+}
 
-  QMatrix4x4 m;
-  m.scale(scaleFactor);
-  m.translate(obj.transform.getPosition().getX().toMm(),
-              obj.transform.getPosition().getY().toMm(),
-              obj.transform.getMirrored() ? -z : z);
-  m.rotate(obj.transform.getRotation().toDeg(), 0, 0, 1);
-  if (obj.transform.getMirrored()) {
-    m.rotate(Angle::deg180().toDeg(), 0, 1, 0);
+OpenGlSceneBuilder::StepModel OpenGlSceneBuilder::loadStepModel(
+    const QString& key, const QByteArray& stepContent) const {
+  if (std::optional<StepModel> cached = mMeshCache.load(key)) {
+    return *cached;
   }
-  m.translate(std::get<0>(obj.stepPosition).toMm(),
-              std::get<1>(obj.stepPosition).toMm(),
-              std::get<2>(obj.stepPosition).toMm());
-  m.rotate(std::get<2>(obj.stepRotation).toDeg(), 0, 0, 1);
-  m.rotate(std::get<1>(obj.stepRotation).toDeg(), 0, 1, 0);
-  m.rotate(std::get<0>(obj.stepRotation).toDeg(), 1, 0, 0);
-
-  QMap<Color, std::shared_ptr<OpenGlTriangleObject>>& items =
-      mDevices[obj.uuid];
+  std::unique_ptr<OccModel> occModel = OccModel::loadStep(stepContent);
+  const StepModel model = occModel->tesselate();
+  mMeshCache.store(key, model);
+  return model;
+}
+
+void OpenGlSceneBuilder::publishModel(
+    const QString& key, const StepModel& model,
+    const QList<const SceneData3D::DeviceData*>& devices, qreal z,
+    qreal scaleFactor, qreal alpha) {
+  // All devices with the same model share the same vertex buffers, the
+  // device transformations are applied when drawing the instances.
+  QVector<QMatrix4x4> instances;
+  for (const SceneData3D::DeviceData* obj : devices) {
+    QMatrix4x4 m;
+    m.scale(scaleFactor);
+    m.translate(obj->transform.getPosition().getX().toMm(),
+                obj->transform.getPosition().getY().toMm(),
+                obj->transform.getMirrored() ? -z : z);
+    m.rotate(obj->transform.getRotation().toDeg(), 0, 0, 1);
+    if (obj->transform.getMirrored()) {
+      m.rotate(Angle::deg180().toDeg(), 0, 1, 0);
+    }
+    m.translate(std::get<0>(obj->stepPosition).toMm(),
+                std::get<1>(obj->stepPosition).toMm(),
+                std::get<2>(obj->stepPosition).toMm());
+    m.rotate(std::get<2>(obj->stepRotation).toDeg(), 0, 0, 1);
+    m.rotate(std::get<1>(obj->stepRotation).toDeg(), 0, 1, 0);
+    m.rotate(std::get<0>(obj->stepRotation).toDeg(), 1, 0, 0);
+    instances.append(m);
+  }
+
+  QMap<Color, std::shared_ptr<OpenGlTriangleObject>>& items = mModels[key];
   foreach (const Color& color, items.keys()) {
     if (!model.contains(color)) {
       emit objectRemoved(items.take(color));
     }
   }
   for (auto it = model.begin(); it != model.end(); it++) {
-    QVector<QVector3D> vertices = it.value();
-    for (auto& vertex : vertices) {
-      vertex = m.map(vertex);
-    }
     std::shared_ptr<OpenGlTriangleObject> obj = items.value(it.key());
     QColor color = QColor::fromRgbF(
         std::get<0>(it.key()), std::get<1>(it.key()), std::get<2>(it.key()));
@@ -471,11 +556,13 @@ void OpenGlSceneBuilder::publishDevice(const SceneData3D::DeviceData& obj,
       color.setAlphaF(alpha);
     }
     if (obj) {
-      obj->setData(color, vertices);
+      obj->setColor(color);
+      obj->setInstances(instances);
       emit objectUpdated(obj);
     } else {
-      obj = std::make_shared<OpenGlTriangleObject>();
-      obj->setData(color, vertices);
+      obj = mTriangleObjectFactory();
+      obj->setData(color, it.value());
+      obj->setInstances(instances);
       items[it.key()] = obj;
       emit objectAdded(obj);
     }
@@ -24,10 +24,12 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/core/3d/scenedata3d.h>
+#include <librepcb/core/3d/stepmeshcache.h>
 #include <polyclipping/clipper.hpp>
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -53,12 +55,29 @@ public:
   // Types
   typedef std::tuple<qreal, qreal, qreal> Color;
   typedef QMap<Color, QVector<QVector3D>> StepModel;
+  typedef std::function<std::shared_ptr<OpenGlTriangleObject>()>
+      TriangleObjectFactory;
 
   // Constructors / Destructor
-  OpenGlSceneBuilder(QObject* parent = nullptr) noexcept;
+  OpenGlSceneBuilder() = delete;
+  explicit OpenGlSceneBuilder(const FilePath& meshCacheDir,
+                              QObject* parent = nullptr) noexcept;
   OpenGlSceneBuilder(const OpenGlSceneBuilder& other) = delete;
   ~OpenGlSceneBuilder() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Set the factory to create the published triangle objects with
+   *
+   * By default, plain ::librepcb::editor::OpenGlTriangleObject instances
+   * are created. Tests may pass a factory creating objects which record the
+   * published data. Must not be called while a build is in progress.
+   *
+   * @param factory   Factory to create new objects.
+   */
+  void setTriangleObjectFactory(TriangleObjectFactory factory) noexcept;
+
   // General Methods
 
   /**
@@ -98,26 +117,35 @@ private:  // Methods
   void run(std::shared_ptr<SceneData3D> data) noexcept;
   ClipperLib::Paths getPaths(const std::shared_ptr<SceneData3D>& data,
                              const QStringList layers) const;
-  QVector<QVector3D> extrude(const ClipperLib::Paths& paths, qreal z,
-                             qreal height, qreal scaleFactor, bool faces = true,
-                             bool edges = true, bool closed = true) const;
-  static QVector<QVector3D> tesselate(const ClipperLib::Path& path, qreal z,
-                                      qreal scaleFactor);
+  static QVector<QVector3D> extrude(const ClipperLib::PolyTree& tree, qreal z,
+                                    qreal height, qreal scaleFactor);
+  static QVector<QVector3D> extrudeFaces(const ClipperLib::PolyTree& tree,
+                                         qreal z, qreal height,
+                                         qreal scaleFactor);
+  static QVector<QVector3D> extrudeEdges(const ClipperLib::Paths& paths,
+                                         qreal z, qreal height,
+                                         qreal scaleFactor, bool closed);
   void publishTriangleData(const QString& id, const QColor& color,
                            const QVector<QVector3D>& triangles);
-  void publishDevice(const SceneData3D::DeviceData& obj,
-                     const QByteArray& stepContent, qreal z, qreal scaleFactor,
-                     qreal alpha);
+  QString getStepModelKey(const QString& stepFile, const QByteArray& content);
+  StepModel loadStepModel(const QString& key,
+                          const QByteArray& stepContent) const;
+  void publishModel(const QString& key, const StepModel& model,
+                    const QList<const SceneData3D::DeviceData*>& devices,
+                    qreal z, qreal scaleFactor, qreal alpha);
 
 private:  // Data
   const PositiveLength mMaxArcTolerance;
   QFuture<void> mFuture;
   bool mAbort;
+  TriangleObjectFactory mTriangleObjectFactory;
 
   // Thread data.
   QHash<QString, std::shared_ptr<OpenGlTriangleObject>> mBoardObjects;
-  QHash<Uuid, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mDevices;
-  QHash<QByteArray, StepModel> mStepModels;  ///< Cache
+  QHash<QString, QMap<Color, std::shared_ptr<OpenGlTriangleObject>>> mModels;
+  StepMeshCache mMeshCache;  ///< On-disk cache
+  QHash<QString, StepModel> mStepModels;  ///< In-memory cache
+  QHash<QString, std::pair<QByteArray, QString>> mStepKeys;  ///< By file
 };
 
 /*******************************************************************************
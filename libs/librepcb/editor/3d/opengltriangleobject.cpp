@@ -40,6 +40,7 @@ OpenGlTriangleObject::OpenGlTriangleObject() noexcept
     mCount(0),
     mMutex(),
     mColor(Qt::black),
+    mInstances{QMatrix4x4()},
     mNewTriangles() {
 }
 
@@ -58,9 +59,22 @@ void OpenGlTriangleObject::setData(const QColor& color,
   mNewTriangles = data;
 }
 
+void OpenGlTriangleObject::setColor(const QColor& color) noexcept {
+  QMutexLocker lock(&mMutex);
+  mColor = color;
+}
+
+void OpenGlTriangleObject::setInstances(
+    const QVector<QMatrix4x4>& instances) noexcept {
+  QMutexLocker lock(&mMutex);
+  mInstances = instances;
+}
+
 void OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
                                 QOpenGLShaderProgram& program) noexcept {
   // Update buffer, if needed.
+  QColor color;
+  QVector<QMatrix4x4> instances;
   {
     QMutexLocker lock(&mMutex);
     if (!mBuffer.isCreated()) {
@@ -73,15 +87,20 @@ void OpenGlTriangleObject::draw(QOpenGLFunctions& gl,
       mCount = mNewTriangles->count();
       mNewTriangles = std::nullopt;
     }
+    color = mColor;
+    instances = mInstances;
   }
 
-  program.setAttributeValue("a_color", mColor);
+  program.setAttributeValue("a_color", color);
 
   mBuffer.bind();
   int vertexLocation = program.attributeLocation("a_position");
   program.enableAttributeArray(vertexLocation);
   program.setAttributeBuffer(vertexLocation, GL_FLOAT, 0, 3, sizeof(QVector3D));
-  gl.glDrawArrays(GL_TRIANGLES, 0, mCount);
+  for (const QMatrix4x4& matrix : instances) {
+    program.setUniformValue("model_matrix", matrix);
+    gl.glDrawArrays(GL_TRIANGLES, 0, mCount);
+  }
 }
 
 /*******************************************************************************
@@ -43,7 +43,7 @@ namespace editor {
 /**
  * @brief Asynchronously generates a 3D board scene for OpenGL rendering
  */
-class OpenGlTriangleObject final : public OpenGlObject {
+class OpenGlTriangleObject : public OpenGlObject {
 public:
   // Constructors / Destructor
   OpenGlTriangleObject() noexcept;
@@ -51,7 +51,20 @@ public:
   virtual ~OpenGlTriangleObject() noexcept;
 
   // General Methods
-  void setData(const QColor& color, const QVector<QVector3D>& data) noexcept;
+  virtual void setData(const QColor& color,
+                       const QVector<QVector3D>& data) noexcept;
+  virtual void setColor(const QColor& color) noexcept;
+
+  /**
+   * @brief Set the transformations of all instances to draw
+   *
+   * The triangles are uploaded only once and drawn once per instance with
+   * the given model matrix. By default, there is exactly one instance with
+   * the identity matrix.
+   *
+   * @param instances   Model matrices of all instances.
+   */
+  virtual void setInstances(const QVector<QMatrix4x4>& instances) noexcept;
   virtual void draw(QOpenGLFunctions& gl,
                     QOpenGLShaderProgram& program) noexcept override;
 
@@ -64,6 +77,7 @@ private:  // Data
 
   QMutex mMutex;
   QColor mColor;
+  QVector<QMatrix4x4> mInstances;
   std::optional<QVector<QVector3D>> mNewTriangles;
 };
 
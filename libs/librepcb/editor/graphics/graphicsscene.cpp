@@ -38,7 +38,10 @@ namespace editor {
  ******************************************************************************/
 
 GraphicsScene::GraphicsScene(QObject* parent) noexcept
-  : QGraphicsScene(parent), mSelectionRectItem(nullptr) {
+  : QGraphicsScene(parent),
+    mSelectionRectItem(nullptr),
+    mLiveZValue(),
+    mLiveItems() {
   mSelectionRectItem = new QGraphicsRectItem();
   mSelectionRectItem->setPen(QPen(QColor(120, 170, 255, 255), 0));
   mSelectionRectItem->setBrush(QColor(150, 200, 255, 80));
@@ -52,6 +55,23 @@ GraphicsScene::~GraphicsScene() noexcept {
   mSelectionRectItem = nullptr;
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void GraphicsScene::setLiveZValue(const std::optional<qreal>& zValue) noexcept {
+  if (zValue != mLiveZValue) {
+    mLiveZValue = zValue;
+    mLiveItems.clear();
+    foreach (QGraphicsItem* item, items()) {
+      if ((!item->parentItem()) && isLiveItem(*item)) {
+        mLiveItems.insert(item);
+      }
+    }
+    update();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -59,10 +79,14 @@ GraphicsScene::~GraphicsScene() noexcept {
 void GraphicsScene::addItem(QGraphicsItem& item) noexcept {
   Q_ASSERT(!items().contains(&item));
   QGraphicsScene::addItem(&item);
+  if ((!item.parentItem()) && isLiveItem(item)) {
+    mLiveItems.insert(&item);
+  }
 }
 
 void GraphicsScene::removeItem(QGraphicsItem& item) noexcept {
   Q_ASSERT(items().contains(&item));
+  mLiveItems.remove(&item);
   QGraphicsScene::removeItem(&item);
 }
 
@@ -82,6 +106,44 @@ void GraphicsScene::clearSelectionRect() noexcept {
   mSelectionRectItem->setRect(QRectF());
 }
 
+bool GraphicsScene::isCacheable(const QGraphicsItem& item) const noexcept {
+  QGraphicsItem* topLevelItem = item.topLevelItem();
+  return mLiveZValue && (!mLiveItems.contains(topLevelItem)) &&
+      (!topLevelItem->isSelected()) && (topLevelItem != mSelectionRectItem);
+}
+
+QList<QGraphicsItem*> GraphicsScene::getLiveItems(
+    const QRectF& rect) const noexcept {
+  // Querying the item index on every paint would be expensive for big
+  // scenes, thus only the few tracked live top-level items are considered.
+  QSet<QGraphicsItem*> topLevelItems = mLiveItems;
+  topLevelItems.insert(mSelectionRectItem);
+  foreach (QGraphicsItem* item, selectedItems()) {
+    if (!item->parentItem()) {
+      topLevelItems.insert(item);
+    }
+  }
+  QList<QGraphicsItem*> sorted;
+  foreach (QGraphicsItem* item, topLevelItems) {
+    const QRectF itemRect = item->mapRectToScene(
+        item->boundingRect() | item->childrenBoundingRect());
+    if (item->isVisible() &&
+        (item->flags().testFlag(QGraphicsItem::ItemIgnoresTransformations) ||
+         itemRect.intersects(rect))) {
+      sorted.append(item);
+    }
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const QGraphicsItem* a, const QGraphicsItem* b) {
+                     return a->zValue() < b->zValue();
+                   });
+  QList<QGraphicsItem*> result;
+  foreach (QGraphicsItem* item, sorted) {
+    collectItemTree(item, result);
+  }
+  return result;
+}
+
 QPixmap GraphicsScene::toPixmap(int dpi, const QColor& background) noexcept {
   QRectF rect = itemsBoundingRect();
   return toPixmap(QSize(qCeil(dpi * Length::fromPx(rect.width()).toInch()),
@@ -101,6 +163,35 @@ QPixmap GraphicsScene::toPixmap(const QSize& size,
   return pixmap;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool GraphicsScene::isLiveItem(const QGraphicsItem& item) const noexcept {
+  return mLiveZValue &&
+      ((item.zValue() >= (*mLiveZValue)) ||
+       item.flags().testFlag(QGraphicsItem::ItemIgnoresTransformations));
+}
+
+void GraphicsScene::collectItemTree(QGraphicsItem* item,
+                                    QList<QGraphicsItem*>& items) noexcept {
+  // Children are sorted by stacking order, the ones behind the parent first.
+  const QList<QGraphicsItem*> children = item->childItems();
+  int i = 0;
+  for (; i < children.count(); ++i) {
+    const QGraphicsItem* child = children.at(i);
+    if ((child->zValue() >= 0) &&
+        (!child->flags().testFlag(QGraphicsItem::ItemStacksBehindParent))) {
+      break;
+    }
+    collectItemTree(children.at(i), items);
+  }
+  items.append(item);
+  for (; i < children.count(); ++i) {
+    collectItemTree(children.at(i), items);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
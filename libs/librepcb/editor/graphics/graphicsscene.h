@@ -26,6 +26,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <optional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -50,7 +52,63 @@ public:
   explicit GraphicsScene(QObject* parent = nullptr) noexcept;
   virtual ~GraphicsScene() noexcept;
 
+  // Getters
+  const std::optional<qreal>& getLiveZValue() const noexcept {
+    return mLiveZValue;
+  }
+
+  // Setters
+
+  /**
+   * @brief Allow views to paint the scene from a tile cache
+   *
+   * @param zValue  Top-level items with this Z value or higher are overlays
+   *                which are always painted live, all items below are
+   *                cacheable. If `std::nullopt`, nothing is cacheable.
+   *
+   * @note  The Z value of an item is only evaluated when it is added with
+   *        #addItem() or when this method is called, so overlay items must
+   *        have their final Z value before being added.
+   *
+   * @see ::librepcb::editor::GraphicsTileCache
+   */
+  void setLiveZValue(const std::optional<qreal>& zValue) noexcept;
+
   // General Methods
+
+  /**
+   * @brief Check whether an item may be painted from a tile cache
+   *
+   * Items are cacheable if their top-level item was below the live Z value
+   * when added, is not selected and is not the selection rect. Items ignoring
+   * transformations are never cacheable.
+   *
+   * @param item    Any item of this scene.
+   * @return Whether the item is cacheable or not.
+   */
+  bool isCacheable(const QGraphicsItem& item) const noexcept;
+
+  /**
+   * @brief Get all items which need to be painted on top of a tile cache
+   *
+   * The live items are tracked by the scene, so this does not query the
+   * item index. Note that selected items are painted on top of the cached
+   * content, thus they are raised above cacheable items with a higher Z
+   * value while being selected. This is accepted since it only affects the
+   * selected, i.e. highlighted, items.
+   *
+   * @param rect    Scene area to get the items of.
+   * @return All non-cacheable items within the area, including their
+   *         children, sorted by stacking order.
+   */
+  QList<QGraphicsItem*> getLiveItems(const QRectF& rect) const noexcept;
+
+  /**
+   * @brief Add an item to the scene
+   *
+   * @param item    The item to add. It must be removed with #removeItem()
+   *                before it is deleted.
+   */
   void addItem(QGraphicsItem& item) noexcept;
   void removeItem(QGraphicsItem& item) noexcept;
   void setSelectionRectColors(const QColor& line, const QColor& fill) noexcept;
@@ -61,8 +119,17 @@ public:
   QPixmap toPixmap(const QSize& size,
                    const QColor& background = Qt::transparent) noexcept;
 
-private:
+private:  // Methods
+  bool isLiveItem(const QGraphicsItem& item) const noexcept;
+  static void collectItemTree(QGraphicsItem* item,
+                              QList<QGraphicsItem*>& items) noexcept;
+
+private:  // Data
   QGraphicsRectItem* mSelectionRectItem;
+  std::optional<qreal> mLiveZValue;
+
+  /// Top-level items which are always painted live (excluding selection)
+  QSet<QGraphicsItem*> mLiveItems;
 };
 
 /*******************************************************************************
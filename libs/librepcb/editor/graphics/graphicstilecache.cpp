@@ -0,0 +1,210 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "graphicstilecache.h"
+
+#include "graphicsscene.h"
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+// Edge length of the tiles, in device independent pixels.
+static constexpr int sTileSize = 256;
+
+// Memory limit for all tiles, in kB.
+static constexpr int sMaxCostKb = 128 * 1024;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+GraphicsTileCache::GraphicsTileCache() noexcept
+  : mTiles(sMaxCostKb), mDevicePixelRatio(1) {
+}
+
+GraphicsTileCache::~GraphicsTileCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool GraphicsTileCache::isSupportedTransform(
+    const QTransform& transform) noexcept {
+  return (transform.type() <= QTransform::TxScale) &&
+      (transform.m11() > 0) && (transform.m11() == transform.m22()) &&
+      (transform.dx() == std::round(transform.dx())) &&
+      (transform.dy() == std::round(transform.dy()));
+}
+
+void GraphicsTileCache::invalidate(const QList<QRectF>& sceneRects) noexcept {
+  if (sceneRects.isEmpty()) {
+    return;
+  }
+  foreach (const TileKey& key, mTiles.keys()) {
+    // Antialiasing may touch pixels slightly outside of the bounding rects,
+    // thus invalidate neighbouring tiles as well if a rect is close to them.
+    const qreal margin = 2 / key.scale;
+    const QRectF tile =
+        getTileSceneRect(key).adjusted(-margin, -margin, margin, margin);
+    foreach (const QRectF& rect, sceneRects) {
+      // Note: QRectF::intersects() doesn't work for zero-sized rects.
+      const QRectF r = rect.normalized();
+      if ((r.left() <= tile.right()) && (r.right() >= tile.left()) &&
+          (r.top() <= tile.bottom()) && (r.bottom() >= tile.top())) {
+        mTiles.remove(key);
+        break;
+      }
+    }
+  }
+}
+
+void GraphicsTileCache::clear() noexcept {
+  mTiles.clear();
+}
+
+void GraphicsTileCache::paint(QPainter& painter, const GraphicsScene& scene,
+                              const QTransform& transform,
+                              const QRect& deviceRect) noexcept {
+  Q_ASSERT(isSupportedTransform(transform));
+
+  const qreal dpr =
+      painter.device() ? painter.device()->devicePixelRatio() : qreal(1);
+  if (dpr != mDevicePixelRatio) {
+    clear();
+    mDevicePixelRatio = dpr;
+  }
+
+  // Tiles are aligned to the scene origin, so the scroll position doesn't
+  // matter for the tile contents.
+  const int dx = qRound(transform.dx());
+  const int dy = qRound(transform.dy());
+  const int xMin = qFloor(qreal(deviceRect.left() - dx) / sTileSize);
+  const int xMax = qFloor(qreal(deviceRect.right() - dx) / sTileSize);
+  const int yMin = qFloor(qreal(deviceRect.top() - dy) / sTileSize);
+  const int yMax = qFloor(qreal(deviceRect.bottom() - dy) / sTileSize);
+
+  painter.save();
+  painter.resetTransform();
+  painter.setOpacity(1);
+  for (int y = yMin; y <= yMax; ++y) {
+    for (int x = xMin; x <= xMax; ++x) {
+      const TileKey key{transform.m11(), x, y};
+      // Note: Draw the pixmap immediately since rendering further tiles may
+      // evict it from the cache.
+      QPixmap* pixmap = mTiles.object(key);
+      if (!pixmap) {
+        pixmap = renderTile(key, scene, painter.renderHints());
+      }
+      if (pixmap && (!pixmap->isNull())) {
+        painter.drawPixmap(QPoint(x * sTileSize + dx, y * sTileSize + dy),
+                           *pixmap);
+      }
+    }
+  }
+  painter.restore();
+}
+
+void GraphicsTileCache::paintItems(QPainter& painter,
+                                   const QList<QGraphicsItem*>& items,
+                                   const QTransform& transform,
+                                   QWidget* widget) noexcept {
+  QStyleOptionGraphicsItem option;
+  foreach (QGraphicsItem* item, items) {
+    if ((!item->isVisible()) ||
+        item->flags().testFlag(QGraphicsItem::ItemHasNoContents)) {
+      continue;
+    }
+    option.state = QStyle::State_None;
+    if (item->isEnabled()) {
+      option.state |= QStyle::State_Enabled;
+    }
+    if (item->isSelected()) {
+      option.state |= QStyle::State_Selected;
+    }
+    option.exposedRect = item->boundingRect();
+    option.rect = option.exposedRect.toAlignedRect();
+    painter.setWorldTransform(item->deviceTransform(transform));
+    painter.setOpacity(item->effectiveOpacity());
+    item->paint(&painter, &option, widget);
+  }
+  painter.setOpacity(1);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QPixmap* GraphicsTileCache::renderTile(const TileKey& key,
+                                       const GraphicsScene& scene,
+                                       QPainter::RenderHints hints) noexcept {
+  QList<QGraphicsItem*> items;
+  foreach (QGraphicsItem* item,
+           scene.items(getTileSceneRect(key), Qt::IntersectsItemBoundingRect,
+                       Qt::AscendingOrder)) {
+    if (item->isVisible() && scene.isCacheable(*item)) {
+      items.append(item);
+    }
+  }
+
+  // Empty tiles are cached as null pixmaps to avoid querying the scene
+  // again each time they are painted.
+  QPixmap* pixmap = new QPixmap();
+  if (!items.isEmpty()) {
+    *pixmap = QPixmap(QSize(sTileSize, sTileSize) * mDevicePixelRatio);
+    pixmap->setDevicePixelRatio(mDevicePixelRatio);
+    pixmap->fill(Qt::transparent);
+    QPainter painter(pixmap);
+    painter.setRenderHints(hints);
+    const QTransform transform(key.scale, 0, 0, key.scale, -key.x * sTileSize,
+                               -key.y * sTileSize);
+    paintItems(painter, items, transform, nullptr);
+  }
+  const qint64 bytes =
+      qint64(pixmap->width()) * pixmap->height() * pixmap->depth() / 8;
+  const int cost = std::max(int(bytes / 1024), 1);
+  if (!mTiles.insert(key, pixmap, cost)) {
+    return nullptr;  // Pixmap has already been deleted by QCache.
+  }
+  return pixmap;
+}
+
+QRectF GraphicsTileCache::getTileSceneRect(const TileKey& key) noexcept {
+  const qreal size = sTileSize / key.scale;
+  return QRectF(key.x * size, key.y * size, size, size);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
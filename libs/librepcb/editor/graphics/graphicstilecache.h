@@ -0,0 +1,154 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_GRAPHICSTILECACHE_H
+#define LIBREPCB_EDITOR_GRAPHICSTILECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+class GraphicsScene;
+
+/*******************************************************************************
+ *  Class GraphicsTileCache
+ ******************************************************************************/
+
+/**
+ * @brief Raster cache of the static content of a graphics scene
+ *
+ * The scene content is rendered into square tiles, aligned to the scene
+ * origin in device coordinates. Tiles are kept per zoom level, so panning
+ * the view or zooming back to a previous zoom level only blits pixmaps
+ * instead of painting all items again. Only the tiles touched by the
+ * changed areas of the scene are invalidated.
+ *
+ * Only items accepted by ::librepcb::editor::GraphicsScene::isCacheable()
+ * are rendered into the tiles, all others need to be painted live on top.
+ * The least recently used tiles are discarded if the memory limit is
+ * reached.
+ */
+class GraphicsTileCache final {
+public:
+  // Constructors / Destructor
+  GraphicsTileCache() noexcept;
+  GraphicsTileCache(const GraphicsTileCache& other) = delete;
+  ~GraphicsTileCache() noexcept;
+
+  // Getters
+  int getTileCount() const noexcept { return mTiles.count(); }
+
+  // General Methods
+
+  /**
+   * @brief Check whether the cache can paint with a particular transform
+   *
+   * @param transform   Viewport transform to check.
+   * @return True if the transform only consists of a positive, uniform
+   *         scaling and an integer translation.
+   */
+  static bool isSupportedTransform(const QTransform& transform) noexcept;
+
+  /**
+   * @brief Discard all tiles intersecting any of the passed scene areas
+   *
+   * @param sceneRects  Changed areas, e.g. from QGraphicsScene::changed().
+   */
+  void invalidate(const QList<QRectF>& sceneRects) noexcept;
+
+  /**
+   * @brief Discard all tiles
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Paint the cached scene content, rendering missing tiles first
+   *
+   * @param painter     Painter of the viewport.
+   * @param scene       The scene to paint.
+   * @param transform   Viewport transform, see #isSupportedTransform().
+   * @param deviceRect  Area of the viewport to paint.
+   */
+  void paint(QPainter& painter, const GraphicsScene& scene,
+             const QTransform& transform, const QRect& deviceRect) noexcept;
+
+  /**
+   * @brief Paint graphics items the same way QGraphicsView would do
+   *
+   * The items are painted in the passed order. When painting live items on
+   * top of the cached tiles, Z order is only kept among the live items, e.g.
+   * selected items appear above cached items with a higher Z value.
+   *
+   * @param painter     Painter to paint with.
+   * @param items       Items to paint, sorted by stacking order. Invisible
+   *                    items are skipped.
+   * @param transform   Transformation from scene to device coordinates.
+   * @param widget      Widget being painted on, if any.
+   */
+  static void paintItems(QPainter& painter, const QList<QGraphicsItem*>& items,
+                         const QTransform& transform,
+                         QWidget* widget) noexcept;
+
+  // Operator Overloadings
+  GraphicsTileCache& operator=(const GraphicsTileCache& rhs) = delete;
+
+private:  // Types
+  struct TileKey {
+    qreal scale;
+    int x;
+    int y;
+
+    bool operator==(const TileKey& rhs) const noexcept {
+      return (scale == rhs.scale) && (x == rhs.x) && (y == rhs.y);
+    }
+    friend size_t qHash(const TileKey& key, size_t seed = 0) noexcept {
+      return qHashMulti(seed, key.scale, key.x, key.y);
+    }
+  };
+
+private:  // Methods
+  QPixmap* renderTile(const TileKey& key, const GraphicsScene& scene,
+                      QPainter::RenderHints hints) noexcept;
+  static QRectF getTileSceneRect(const TileKey& key) noexcept;
+
+private:  // Data
+  /// Rendered tiles, a null pixmap means the tile has no content
+  QCache<TileKey, QPixmap> mTiles;
+
+  /// Device pixel ratio the tiles have been rendered with
+  qreal mDevicePixelRatio;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
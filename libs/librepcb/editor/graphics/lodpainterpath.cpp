@@ -0,0 +1,198 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "lodpainterpath.h"
+
+#include <QtCore>
+#include <QtGui>
+
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+// Number of cached zoom levels. Level n is used for a level of detail in the
+// range (2^-(n+1), 2^-n], the last level for anything below.
+static constexpr int sLevelCount = 16;
+
+// Paths with less elements are always painted as-is.
+static constexpr int sMinElementCount = 64;
+
+// Maximum deviation of simplified paths, in device pixels.
+static constexpr qreal sTolerancePx = 0.4;
+
+// Cached levels further away from the current level than this are released.
+static constexpr int sKeptLevelDistance = 1;
+
+// Paths smaller than this (in device pixels) are painted as rectangles.
+static constexpr qreal sTinySizePx = 1.5;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+LodPainterPath::LodPainterPath() noexcept
+  : mPath(), mBoundingRect(), mSimplifiedPaths() {
+}
+
+LodPainterPath::LodPainterPath(const QPainterPath& path) noexcept
+  : LodPainterPath() {
+  setPath(path);
+}
+
+LodPainterPath::~LodPainterPath() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const QPainterPath& LodPainterPath::getPath(qreal lod) const noexcept {
+  if ((lod >= 1) || (mPath.elementCount() < sMinElementCount)) {
+    return mPath;
+  }
+
+  const int level = static_cast<int>(
+      std::min(std::floor(std::log2(1 / lod)), qreal(sLevelCount - 1)));
+  if (mSimplifiedPaths.isEmpty()) {
+    mSimplifiedPaths.resize(sLevelCount);
+  }
+  for (int i = 0; i < sLevelCount; ++i) {
+    if (std::abs(i - level) > sKeptLevelDistance) {
+      mSimplifiedPaths[i].reset();
+    }
+  }
+  std::optional<QPainterPath>& simplified = mSimplifiedPaths[level];
+  if (!simplified) {
+    // The tolerance in scene pixels is at most sTolerancePx / lod.
+    const qreal tolerance = std::ldexp(sTolerancePx, level);
+    QPainterPath path;
+    path.setFillRule(mPath.fillRule());
+    foreach (const QPolygonF& polygon, mPath.toSubpathPolygons()) {
+      path.addPolygon(simplify(polygon, tolerance));
+    }
+    simplified = path;
+  }
+  return *simplified;
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void LodPainterPath::setPath(const QPainterPath& path) noexcept {
+  mPath = path;
+  mBoundingRect = path.boundingRect();
+  mSimplifiedPaths.clear();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool LodPainterPath::isTiny(const QRectF& rect, qreal lod) noexcept {
+  return (std::max(rect.width(), rect.height()) * lod) < sTinySizePx;
+}
+
+void LodPainterPath::paint(QPainter& painter, qreal lod) const noexcept {
+  if (mPath.isEmpty()) {
+    return;
+  }
+
+  const QPen& pen = painter.pen();
+  const bool hasPen = (pen.style() != Qt::NoPen);
+  const qreal margin = hasPen ? (pen.widthF() / 2) : 0;
+  const QRectF rect = mBoundingRect.adjusted(-margin, -margin, margin, margin);
+  if (isTiny(rect, lod)) {
+    const QBrush brush = hasPen ? pen.brush() : painter.brush();
+    if (brush.style() != Qt::NoBrush) {
+      painter.fillRect(rect, brush);
+    }
+  } else {
+    painter.drawPath(getPath(lod));
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QPolygonF LodPainterPath::simplify(const QPolygonF& polygon,
+                                   qreal tolerance) noexcept {
+  // Douglas-Peucker algorithm. The first and last point are always kept, so
+  // closed polygons stay closed.
+  const int count = polygon.count();
+  if (count < 3) {
+    return polygon;
+  }
+  QVector<bool> keep(count, false);
+  keep[0] = true;
+  keep[count - 1] = true;
+  const qreal toleranceSq = tolerance * tolerance;
+  QVector<std::pair<int, int>> ranges = {std::make_pair(0, count - 1)};
+  while (!ranges.isEmpty()) {
+    const auto [first, last] = ranges.takeLast();
+    const QPointF start = polygon.at(first);
+    const QPointF segment = polygon.at(last) - start;
+    const qreal segmentLengthSq = QPointF::dotProduct(segment, segment);
+    qreal maxDistanceSq = 0;
+    int index = -1;
+    for (int i = first + 1; i < last; ++i) {
+      QPointF delta = polygon.at(i) - start;
+      if (segmentLengthSq > 0) {
+        const qreal t = qBound(
+            qreal(0), QPointF::dotProduct(delta, segment) / segmentLengthSq,
+            qreal(1));
+        delta -= segment * t;
+      }
+      const qreal distanceSq = QPointF::dotProduct(delta, delta);
+      if (distanceSq > maxDistanceSq) {
+        maxDistanceSq = distanceSq;
+        index = i;
+      }
+    }
+    if ((index >= 0) && (maxDistanceSq > toleranceSq)) {
+      keep[index] = true;
+      ranges.append(std::make_pair(first, index));
+      ranges.append(std::make_pair(index, last));
+    }
+  }
+
+  QPolygonF result;
+  result.reserve(count);
+  for (int i = 0; i < count; ++i) {
+    if (keep.at(i)) {
+      result.append(polygon.at(i));
+    }
+  }
+  return result;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_LODPAINTERPATH_H
+#define LIBREPCB_EDITOR_LODPAINTERPATH_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Class LodPainterPath
+ ******************************************************************************/
+
+/**
+ * @brief A QPainterPath with simplified versions for low zoom levels
+ *
+ * Painting big paths like plane fragments with full vertex detail is
+ * expensive when zoomed out, although most vertices are then closer
+ * together than a device pixel. This class lazily builds and caches
+ * simplified versions of the path, one per zoom level, with a tolerance
+ * below half a device pixel. Only the levels next to the current zoom level
+ * are kept in memory. At a zoom level of 1:1 or more, the original path is
+ * painted, so the appearance doesn't change.
+ *
+ * If the path is smaller than about a device pixel, it is painted as a
+ * filled rectangle instead.
+ */
+class LodPainterPath final {
+public:
+  // Constructors / Destructor
+  LodPainterPath() noexcept;
+  LodPainterPath(const LodPainterPath& other) = default;
+  explicit LodPainterPath(const QPainterPath& path) noexcept;
+  ~LodPainterPath() noexcept;
+
+  // Getters
+  const QPainterPath& getPath() const noexcept { return mPath; }
+  const QRectF& getBoundingRect() const noexcept { return mBoundingRect; }
+
+  /**
+   * @brief Get the path to paint at a particular level of detail
+   *
+   * @param lod   Level of detail, as returned by
+   *              QStyleOptionGraphicsItem::levelOfDetailFromTransform().
+   * @return The original path or a cached, simplified version of it.
+   */
+  const QPainterPath& getPath(qreal lod) const noexcept;
+
+  // Setters
+  void setPath(const QPainterPath& path) noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Check whether an area is painted smaller than about a device pixel
+   *
+   * Such items can be painted as a filled rectangle, without any visible
+   * difference.
+   *
+   * @param rect      Bounding rect of the painted area (including pen width).
+   * @param lod       Level of detail of the painter's transform.
+   * @return Whether the area is tiny at the given level of detail.
+   */
+  static bool isTiny(const QRectF& rect, qreal lod) noexcept;
+
+  /**
+   * @brief Paint the path with the current pen and brush of a painter
+   *
+   * @param painter   The painter to paint with.
+   * @param lod       Level of detail of the painter's transform.
+   */
+  void paint(QPainter& painter, qreal lod) const noexcept;
+
+  // Operator Overloadings
+  LodPainterPath& operator=(const LodPainterPath& rhs) = default;
+
+private:  // Methods
+  static QPolygonF simplify(const QPolygonF& polygon,
+                            qreal tolerance) noexcept;
+
+private:  // Data
+  QPainterPath mPath;
+  QRectF mBoundingRect;
+
+  /// Simplified paths, built on demand, indexed by the level
+  mutable QVector<std::optional<QPainterPath>> mSimplifiedPaths;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
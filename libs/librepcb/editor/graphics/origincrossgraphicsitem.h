@@ -55,6 +55,11 @@ public:
   explicit OriginCrossGraphicsItem(QGraphicsItem* parent = nullptr) noexcept;
   virtual ~OriginCrossGraphicsItem() noexcept;
 
+  // Getters
+  const std::shared_ptr<GraphicsLayer>& getLayer() const noexcept {
+    return mLayer;
+  }
+
   // Setters
   void setPosition(const Point& pos) noexcept;
   void setRotation(const Angle& rot) noexcept;
@@ -59,6 +59,7 @@ PrimitiveFootprintPadGraphicsItem::PrimitiveFootprintPadGraphicsItem(
     mOriginCrossGraphicsItem(new OriginCrossGraphicsItem(this)),
     mTextGraphicsItem(new PrimitivePathGraphicsItem(this)),
     mPathGraphicsItems(),
+    mShapeCache(*this, [this]() { return buildShape(); }),
     mOnLayerEditedSlot(*this, &PrimitiveFootprintPadGraphicsItem::layerEdited) {
   setFlag(QGraphicsItem::ItemHasNoContents, true);
   setFlag(QGraphicsItem::ItemIsSelectable, true);
@@ -100,6 +101,7 @@ void PrimitiveFootprintPadGraphicsItem::setRotation(
     item.item->setRotation(rotation);
   }
   // Keep the text always at 0° for readability.
+  mShapeCache.invalidate();
 }
 
 void PrimitiveFootprintPadGraphicsItem::setMirrored(bool mirrored) noexcept {
@@ -107,6 +109,7 @@ void PrimitiveFootprintPadGraphicsItem::setMirrored(bool mirrored) noexcept {
   foreach (auto& item, mPathGraphicsItems) {
     item.item->setMirrored(mirrored);
   }
+  mShapeCache.invalidate();
 }
 
 void PrimitiveFootprintPadGraphicsItem::setText(const QString& text) noexcept {
@@ -135,6 +138,7 @@ void PrimitiveFootprintPadGraphicsItem::setLayer(
     mTextGraphicsItem->setLineLayer(mCopperLayer);
     updateRegisteredLayers();
     updatePathLayers();
+    mShapeCache.invalidate();
   }
 }
 
@@ -198,6 +202,7 @@ void PrimitiveFootprintPadGraphicsItem::setGeometries(
   updatePathLayers();
   updateTextHeight();
   updateRegisteredLayers();
+  mShapeCache.invalidate();
 }
 
 /*******************************************************************************
@@ -205,19 +210,7 @@ void PrimitiveFootprintPadGraphicsItem::setGeometries(
  ******************************************************************************/
 
 QPainterPath PrimitiveFootprintPadGraphicsItem::shape() const noexcept {
-  Q_ASSERT(mOriginCrossGraphicsItem);
-  QPainterPath p = mOriginCrossGraphicsItem->shape();
-  if (mCopperLayer && mCopperLayer->isVisible()) {
-    for (auto it = mShapes.begin(); it != mShapes.end(); it++) {
-      if (it.key()->isVisible()) {
-        QTransform t;
-        t.rotate(mOriginCrossGraphicsItem->rotation());
-        if (mMirror) t.scale(qreal(-1), qreal(1));
-        p |= t.map(it.value());
-      }
-    }
-  }
-  return p;
+  return mShapeCache.getShape();
 }
 
 QVariant PrimitiveFootprintPadGraphicsItem::itemChange(
@@ -244,6 +237,7 @@ void PrimitiveFootprintPadGraphicsItem::layerEdited(
     case GraphicsLayer::Event::VisibleChanged:
     case GraphicsLayer::Event::EnabledChanged:
       updatePathLayers();
+      mShapeCache.invalidate();
       break;
     default:
       break;
@@ -285,6 +279,26 @@ void PrimitiveFootprintPadGraphicsItem::updateRegisteredLayers() noexcept {
       item.layer->onEdited.attach(mOnLayerEditedSlot);
     }
   }
+  // The origin cross is part of the shape as well.
+  if (auto layer = mOriginCrossGraphicsItem->getLayer()) {
+    layer->onEdited.attach(mOnLayerEditedSlot);
+  }
+}
+
+QPainterPath PrimitiveFootprintPadGraphicsItem::buildShape() const noexcept {
+  Q_ASSERT(mOriginCrossGraphicsItem);
+  QPainterPath p = mOriginCrossGraphicsItem->shape();
+  if (mCopperLayer && mCopperLayer->isVisible()) {
+    for (auto it = mShapes.begin(); it != mShapes.end(); it++) {
+      if (it.key()->isVisible()) {
+        QTransform t;
+        t.rotate(mOriginCrossGraphicsItem->rotation());
+        if (mMirror) t.scale(qreal(-1), qreal(1));
+        p |= t.map(it.value());
+      }
+    }
+  }
+  return p;
 }
 
 /*******************************************************************************
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "graphicslayer.h"
+#include "shapecache.h"
 
 #include <QtCore>
 #include <QtWidgets>
@@ -64,6 +65,9 @@ public:
                                     QGraphicsItem* parent = nullptr) noexcept;
   ~PrimitiveFootprintPadGraphicsItem() noexcept;
 
+  // Getters
+  const ShapeCache& getShapeCache() const noexcept { return mShapeCache; }
+
   // Setters
   void setPosition(const Point& position) noexcept;
   void setRotation(const Angle& rotation) noexcept;
@@ -89,6 +93,7 @@ private:  // Methods
   void updatePathLayers() noexcept;
   void updateTextHeight() noexcept;
   void updateRegisteredLayers() noexcept;
+  QPainterPath buildShape() const noexcept;
 
 private:  // Data
   const IF_GraphicsLayerProvider& mLayerProvider;
@@ -105,6 +110,7 @@ private:  // Data
   QVector<PathItem> mPathGraphicsItems;
   QMap<std::shared_ptr<GraphicsLayer>, QPainterPath> mShapes;
   QRectF mShapesBoundingRect;
+  ShapeCache mShapeCache;
 
   // Slots
   GraphicsLayer::OnEditedSlot mOnLayerEditedSlot;
@@ -81,7 +81,7 @@ void PrimitivePathGraphicsItem::setMirrored(bool mirrored) noexcept {
 }
 
 void PrimitivePathGraphicsItem::setPath(const QPainterPath& path) noexcept {
-  mPainterPath = path;
+  mPainterPath.setPath(path);
   updateBoundingRectAndShape();
 }
 
@@ -147,6 +147,8 @@ void PrimitivePathGraphicsItem::paint(QPainter* painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
 
   if (mMirror) {
     painter->scale(-1, 1);
@@ -154,7 +156,7 @@ void PrimitivePathGraphicsItem::paint(QPainter* painter,
 
   painter->setPen(isSelected ? mPenHighlighted : mPen);
   painter->setBrush(isSelected ? mBrushHighlighted : mBrush);
-  painter->drawPath(mPainterPath);
+  mPainterPath.paint(*painter, lod);
 }
 
 /*******************************************************************************
@@ -206,13 +208,13 @@ void PrimitivePathGraphicsItem::updateColors() noexcept {
 void PrimitivePathGraphicsItem::updateBoundingRectAndShape() noexcept {
   prepareGeometryChange();
   if (mShapeMode == ShapeMode::FilledOutline) {
-    mShape = mPainterPath;
+    mShape = mPainterPath.getPath();
   } else if (mShapeMode == ShapeMode::StrokeAndAreaByLayer) {
-    mShape = Toolbox::shapeFromPath(mPainterPath, mPen, mBrush);
+    mShape = Toolbox::shapeFromPath(mPainterPath.getPath(), mPen, mBrush);
   } else {
     mShape = QPainterPath();
   }
-  mBoundingRect = mPainterPath.boundingRect() +
+  mBoundingRect = mPainterPath.getBoundingRect() +
       QMarginsF(mPen.widthF(), mPen.widthF(), mPen.widthF(), mPen.widthF());
   update();
 }
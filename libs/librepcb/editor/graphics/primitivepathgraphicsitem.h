@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "graphicslayer.h"
+#include "lodpainterpath.h"
 
 #include <librepcb/core/types/length.h>
 
@@ -113,7 +114,7 @@ protected:  // Data
   QPen mPenHighlighted;
   QBrush mBrush;
   QBrush mBrushHighlighted;
-  QPainterPath mPainterPath;
+  LodPainterPath mPainterPath;
   QRectF mBoundingRect;
   qreal mBoundingRectMarginPx;
   QPainterPath mShape;
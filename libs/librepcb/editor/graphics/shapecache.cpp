@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "shapecache.h"
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ShapeCache::ShapeCache(const QGraphicsItem& item, Builder builder) noexcept
+  : mItem(item),
+    mBuilder(std::move(builder)),
+    mRevision(0),
+    mShape(),
+    mSceneRevision(),
+    mSceneTransform(),
+    mSceneShape(),
+    mSceneBoundingRect() {
+}
+
+ShapeCache::~ShapeCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const QPainterPath& ShapeCache::getShape() const noexcept {
+  if (!mShape) {
+    mShape = mBuilder();
+  }
+  return *mShape;
+}
+
+const QPainterPath& ShapeCache::getSceneShape() const noexcept {
+  updateSceneShape();
+  return mSceneShape;
+}
+
+const QRectF& ShapeCache::getSceneBoundingRect() const noexcept {
+  updateSceneShape();
+  return mSceneBoundingRect;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ShapeCache::invalidate() noexcept {
+  ++mRevision;
+  mShape = std::nullopt;
+}
+
+bool ShapeCache::intersects(const QRectF& sceneRect) const noexcept {
+  updateSceneShape();
+  if (mSceneShape.isEmpty() ||
+      (!boundsIntersect(mSceneBoundingRect, sceneRect))) {
+    return false;
+  } else if (sceneRect.normalized().contains(mSceneBoundingRect)) {
+    return true;
+  } else {
+    return mSceneShape.intersects(sceneRect);
+  }
+}
+
+bool ShapeCache::contains(const QPointF& scenePos) const noexcept {
+  updateSceneShape();
+  return boundsIntersect(mSceneBoundingRect, QRectF(scenePos, QSizeF())) &&
+      mSceneShape.contains(scenePos);
+}
+
+bool ShapeCache::boundsIntersect(const QRectF& a, const QRectF& b) noexcept {
+  const QRectF r1 = a.normalized();
+  const QRectF r2 = b.normalized();
+  return (r1.left() <= r2.right()) && (r1.right() >= r2.left()) &&
+      (r1.top() <= r2.bottom()) && (r1.bottom() >= r2.top());
+}
+
+QRectF ShapeCache::calcSceneBounds(const QGraphicsItem& item) noexcept {
+  return item.mapRectToScene(item.boundingRect() | item.childrenBoundingRect());
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ShapeCache::updateSceneShape() const noexcept {
+  const QTransform transform = mItem.sceneTransform();
+  if ((mSceneRevision != mRevision) || (transform != mSceneTransform)) {
+    mSceneShape = transform.map(getShape());
+    mSceneBoundingRect = mSceneShape.boundingRect();
+    mSceneTransform = transform;
+    mSceneRevision = mRevision;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,151 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EDITOR_SHAPECACHE_H
+#define LIBREPCB_EDITOR_SHAPECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+#include <functional>
+#include <optional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+
+/*******************************************************************************
+ *  Class ShapeCache
+ ******************************************************************************/
+
+/**
+ * @brief Lazily built shape of a graphics item, in local and scene coordinates
+ *
+ * Items with an expensive QGraphicsItem::shape() (e.g. unions of several
+ * paths) build their shape with a builder function passed to this cache, and
+ * call #invalidate() whenever the shape changes. This increments the geometry
+ * revision, and the shape is rebuilt on the next access.
+ *
+ * The shape mapped to scene coordinates is cached too, and is rebuilt only if
+ * the revision or the scene transform of the item changed. Hit tests check
+ * the scene bounding rect first, so the exact shape is only needed for items
+ * close to the tested area.
+ */
+class ShapeCache final {
+public:
+  // Types
+  using Builder = std::function<QPainterPath()>;
+
+  // Constructors / Destructor
+  ShapeCache() = delete;
+  ShapeCache(const ShapeCache& other) = delete;
+  ShapeCache(const QGraphicsItem& item, Builder builder) noexcept;
+  ~ShapeCache() noexcept;
+
+  // Getters
+  quint64 getRevision() const noexcept { return mRevision; }
+  const QPainterPath& getShape() const noexcept;
+  const QPainterPath& getSceneShape() const noexcept;
+  const QRectF& getSceneBoundingRect() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Mark the shape as changed
+   *
+   * Must be called whenever the result of the builder changes. Changes of
+   * the item's position or transform are detected automatically.
+   */
+  void invalidate() noexcept;
+
+  /**
+   * @brief Check whether the shape intersects a scene area
+   *
+   * @param sceneRect   Area in scene coordinates, may have a zero size.
+   * @return Same as QPainterPath::intersects() on the scene shape.
+   */
+  bool intersects(const QRectF& sceneRect) const noexcept;
+
+  /**
+   * @brief Check whether the shape contains a scene position
+   *
+   * @param scenePos    Position in scene coordinates.
+   * @return Same as QPainterPath::contains() on the scene shape.
+   */
+  bool contains(const QPointF& scenePos) const noexcept;
+
+  /**
+   * @brief Check whether two rects overlap, including their edges
+   *
+   * Unlike QRectF::intersects(), this also works for rects with a zero
+   * width or height.
+   *
+   * @param a   First rect.
+   * @param b   Second rect.
+   * @return Whether the rects overlap or touch each other.
+   */
+  static bool boundsIntersect(const QRectF& a, const QRectF& b) noexcept;
+
+  /**
+   * @brief Get a scene rect containing the shape of any item
+   *
+   * Unlike QGraphicsItem::sceneBoundingRect(), this also considers the
+   * children, since the bounding rect of a QGraphicsItemGroup only covers
+   * items added with QGraphicsItemGroup::addToGroup().
+   *
+   * @param item  The item to get the bounds of.
+   * @return Bounding rect of the item and its children in scene coordinates.
+   */
+  static QRectF calcSceneBounds(const QGraphicsItem& item) noexcept;
+
+  // Operator Overloadings
+  ShapeCache& operator=(const ShapeCache& rhs) = delete;
+
+private:  // Methods
+  void updateSceneShape() const noexcept;
+
+private:  // Data
+  const QGraphicsItem& mItem;
+  Builder mBuilder;
+  quint64 mRevision;
+
+  // Local shape, built on demand
+  mutable std::optional<QPainterPath> mShape;
+
+  // Scene shape, valid only for the stored revision and scene transform
+  mutable std::optional<quint64> mSceneRevision;
+  mutable QTransform mSceneTransform;
+  mutable QPainterPath mSceneShape;
+  mutable QRectF mSceneBoundingRect;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace librepcb
+
+#endif
@@ -1364,7 +1364,8 @@ void PackageEditorWidget::toggle3DMode(bool enable) noexcept {
     mUi->btnToggle3d->setArrowType(Qt::RightArrow);
     mOpenGlView.reset(new OpenGlView(this));
     mUi->mainLayout->insertWidget(0, mOpenGlView.data(), 2);
-    mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder());
+    mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder(
+        mContext.workspace.getCachePath().getPathTo("meshes")));
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::started,
             mOpenGlView.data(), &OpenGlView::startSpinning);
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::finished,
@@ -1363,8 +1363,8 @@ void BoardEditor::runDrc(bool quick) noexcept {
     mDockDrc->setMessages(result.messages);
 
     // Detect & remove disappeared messages.
-    const QSet<SExpression> approvals =
-        RuleCheckMessage::getAllApprovals(result.messages);
+    const QSet<RuleCheckMessage::ApprovalKey> approvals =
+        RuleCheckMessage::getAllApprovalKeys(result.messages);
     if (board->updateDrcMessageApprovals(approvals, quick)) {
       mDockDrc->setApprovals(board->getDrcMessageApprovals());
       mProjectEditor.setManualModificationsMade();
@@ -1383,7 +1383,8 @@ void BoardEditor::highlightDrcMessage(const RuleCheckMessage& msg,
   if (msg.getLocations().isEmpty()) {
     // Position on board not known.
     clearDrcMarker();
-  } else if (QGraphicsScene* scene = mUi->graphicsView->scene()) {
+  } else if (GraphicsScene* scene = mUi->graphicsView->getScene()) {
+    clearDrcMarker();
     const ThemeColor& color =
         mProjectEditor.getWorkspace().getSettings().themes.getActive().getColor(
             Theme::Color::sBoardOverlays);
@@ -1393,7 +1394,7 @@ void BoardEditor::highlightDrcMessage(const RuleCheckMessage& msg,
     mDrcLocationGraphicsItem->setPen(QPen(color.getPrimaryColor(), 0));
     mDrcLocationGraphicsItem->setBrush(color.getSecondaryColor());
     mDrcLocationGraphicsItem->setPath(path);
-    scene->addItem(mDrcLocationGraphicsItem.data());
+    scene->addItem(*mDrcLocationGraphicsItem);
 
     qreal margin = Length(1000000).toPx();
     QRectF rect = path.boundingRect();
@@ -1415,6 +1416,12 @@ void BoardEditor::setDrcMessageApproved(const RuleCheckMessage& msg,
 }
 
 void BoardEditor::clearDrcMarker() noexcept {
+  if (mDrcLocationGraphicsItem) {
+    if (auto scene =
+            qobject_cast<GraphicsScene*>(mDrcLocationGraphicsItem->scene())) {
+      scene->removeItem(*mDrcLocationGraphicsItem);
+    }
+  }
   mDrcLocationGraphicsItem.reset();
   mUi->graphicsView->setSceneRectMarker(QRectF());
 }
@@ -1923,7 +1930,8 @@ bool BoardEditor::show3DView() noexcept {
   if (!mOpenGlView) {
     mOpenGlView.reset(new OpenGlView(this));
     mUi->mainLayout->insertWidget(2, mOpenGlView.data(), 1);
-    mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder());
+    mOpenGlSceneBuilder.reset(new OpenGlSceneBuilder(
+        mProjectEditor.getWorkspace().getCachePath().getPathTo("meshes")));
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::started,
             mOpenGlView.data(), &OpenGlView::startSpinning);
     connect(mOpenGlSceneBuilder.data(), &OpenGlSceneBuilder::finished,
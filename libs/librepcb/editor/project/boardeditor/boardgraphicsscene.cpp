@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardgraphicsscene.h"
 
+#include "../../graphics/shapecache.h"
 #include "graphicsitems/bgi_airwire.h"
 #include "graphicsitems/bgi_device.h"
 #include "graphicsitems/bgi_footprintpad.h"
@@ -71,6 +72,10 @@ BoardGraphicsScene::BoardGraphicsScene(
     mBoard(board),
     mLayerProvider(lp),
     mHighlightedNetSignals(highlightedNetSignals) {
+  // Air wires are painted live on top of the cached board content since they
+  // change frequently while editing.
+  setLiveZValue(ZValue_AirWires);
+
   foreach (BI_Device* obj, mBoard.getDeviceInstances()) {
     addDevice(*obj);
   }
@@ -201,10 +206,14 @@ void BoardGraphicsScene::selectItemsInRect(const Point& p1,
                                            const Point& p2) noexcept {
   GraphicsScene::setSelectionRect(p1, p2);
   const QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+  // Check the cheap scene bounding rect before mapping the exact shape.
+  auto intersects = [&rectPx](const QGraphicsItem& item) {
+    return ShapeCache::boundsIntersect(ShapeCache::calcSceneBounds(item),
+                                       rectPx) &&
+        item.mapToScene(item.shape()).intersects(rectPx);
+  };
   foreach (auto item, mDevices) {
-    const bool selectSymbol =
-        item->mapToScene(item->shape()).intersects(rectPx);
-    item->setSelected(selectSymbol);
+    item->setSelected(item->getShapeCache().intersects(rectPx));
   }
   foreach (auto item, mFootprintPads) {
     bool deviceSelected = false;
@@ -212,35 +221,35 @@ void BoardGraphicsScene::selectItemsInRect(const Point& p1,
       deviceSelected = device->isSelected();
     }
     item->setSelected(deviceSelected ||
-                      item->mapToScene(item->shape()).intersects(rectPx));
+                      item->getShapeCache().intersects(rectPx));
   }
   foreach (auto item, mVias) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mNetPoints) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mNetLines) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mPlanes) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mZones) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mPolygons) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
   foreach (auto item, mStrokeTexts) {
     if (auto device = item->getDeviceGraphicsItem().lock()) {
       item->setSelected(device->isSelected());
     } else {
-      item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+      item->setSelected(intersects(*item));
     }
   }
   foreach (auto item, mHoles) {
-    item->setSelected(item->mapToScene(item->shape()).intersects(rectPx));
+    item->setSelected(intersects(*item));
   }
 }
 
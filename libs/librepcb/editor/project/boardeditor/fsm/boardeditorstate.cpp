@@ -23,6 +23,7 @@
 #include "boardeditorstate.h"
 
 #include "../../../graphics/graphicslayer.h"
+#include "../../../graphics/shapecache.h"
 #include "../../../undostack.h"
 #include "../../../widgets/graphicsview.h"
 #include "../boardeditor.h"
@@ -181,6 +182,13 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
   const QPainterPath posAreaLarge =
       mContext.editorGraphicsView.calcPosWithTolerance(pos, 1.5);
 
+  // Items not even touching this area can be skipped without mapping their
+  // exact grab area to scene coordinates.
+  QRectF searchRect = posAreaLarge.boundingRect();
+  if (flags.testFlag(FindFlag::AcceptNextGridMatch)) {
+    searchRect |= QRectF(posOnGrid - QPointF(1, 1), QSizeF(2, 2));
+  }
+
   // Note: The order of adding the items is very important (the top most item
   // must appear as the first item in the list)! For that, we work with
   // priorities (0 = highest priority):
@@ -248,9 +256,10 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
     }
   };
   auto processItem = [&pos, &posExact, &posOnGrid, &posArea, &posAreaLarge,
-                      flags, &except, &addItem, &canSkip](
+                      &searchRect, flags, &except, &addItem, &canSkip](
                          std::shared_ptr<QGraphicsItem> item,
-                         const Point& nearestPos, int priority, bool large) {
+                         const Point& nearestPos, int priority, bool large,
+                         const ShapeCache* shapeCache = nullptr) {
     if (except.contains(item)) {
       return;
     }
@@ -258,7 +267,13 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
     if (canSkip(prio)) {
       return;
     }
-    const QPainterPath grabArea = item->mapToScene(item->shape());
+    const QRectF bounds = shapeCache ? shapeCache->getSceneBoundingRect()
+                                     : ShapeCache::calcSceneBounds(*item);
+    if (!ShapeCache::boundsIntersect(bounds, searchRect)) {
+      return;
+    }
+    const QPainterPath grabArea = shapeCache ? shapeCache->getSceneShape()
+                                             : item->mapToScene(item->shape());
     if (grabArea.isEmpty()) {
       return;
     }
@@ -385,7 +400,8 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
     for (auto it = scene->getDevices().begin(); it != scene->getDevices().end();
          it++) {
       processItem(it.value(), it.key()->getPosition(),
-                  40 + (it.key()->getMirrored() ? 300 : 100), false);
+                  40 + (it.key()->getMirrored() ? 300 : 100), false,
+                  &it.value()->getShapeCache());
     }
   }
 
@@ -400,7 +416,8 @@ QList<std::shared_ptr<QGraphicsItem>> BoardEditorState::findItemsAtPos(
           const int priority = it.key()->getLibPad().isTht()
               ? 1
               : (50 + (it.key()->getMirrored() ? 300 : 100));
-          processItem(it.value(), it.key()->getPosition(), priority, false);
+          processItem(it.value(), it.key()->getPosition(), priority, false,
+                      &it.value()->getShapeCache());
         }
       }
     }
@@ -57,6 +57,7 @@ BGI_Device::BGI_Device(BI_Device& device,
     mDevice(device),
     mLayerProvider(lp),
     mGrabAreaLayer(nullptr),
+    mShapeCache(*this, [this]() { return buildShape(); }),
     mOnEditedSlot(*this, &BGI_Device::deviceEdited),
     mOnLayerEditedSlot(*this, &BGI_Device::layerEdited) {
   setFlag(QGraphicsItem::ItemHasNoContents, true);
@@ -124,11 +125,7 @@ BGI_Device::~BGI_Device() noexcept {
  ******************************************************************************/
 
 QPainterPath BGI_Device::shape() const noexcept {
-  QPainterPath p = mOriginCrossGraphicsItem->shape();
-  if (mGrabAreaLayer && mGrabAreaLayer->isVisible()) {
-    p |= mShape;
-  }
-  return p;
+  return mShapeCache.getShape();
 }
 
 /*******************************************************************************
@@ -172,6 +169,7 @@ void BGI_Device::layerEdited(const GraphicsLayer& layer,
     case GraphicsLayer::Event::VisibleChanged:
     case GraphicsLayer::Event::EnabledChanged:
       prepareGeometryChange();
+      mShapeCache.invalidate();
       break;
     default:
       qWarning() << "Unhandled switch-case in BGI_Device::layerEdited():"
@@ -227,14 +225,8 @@ void BGI_Device::updateBoardSide() noexcept {
       mLayerProvider.getLayer(top ? Theme::Color::sBoardGrabAreasTop
                                   : Theme::Color::sBoardGrabAreasBot);
   if (grabAreaLayer != mGrabAreaLayer) {
-    if (mGrabAreaLayer) {
-      mGrabAreaLayer->onEdited.detach(mOnLayerEditedSlot);
-    }
     prepareGeometryChange();
     mGrabAreaLayer = grabAreaLayer;
-    if (mGrabAreaLayer) {
-      mGrabAreaLayer->onEdited.attach(mOnLayerEditedSlot);
-    }
   }
 
   // Update origin cross layer.
@@ -242,6 +234,16 @@ void BGI_Device::updateBoardSide() noexcept {
       mLayerProvider.getLayer(top ? Theme::Color::sBoardReferencesTop
                                   : Theme::Color::sBoardReferencesBot));
 
+  // The shape depends on the visibility of both layers.
+  mOnLayerEditedSlot.detachAll();
+  if (mGrabAreaLayer) {
+    mGrabAreaLayer->onEdited.attach(mOnLayerEditedSlot);
+  }
+  if (auto layer = mOriginCrossGraphicsItem->getLayer()) {
+    layer->onEdited.attach(mOnLayerEditedSlot);
+  }
+  mShapeCache.invalidate();
+
   // Update circle layers.
   const CircleList& circles = mDevice.getLibFootprint().getCircles();
   for (int i = 0;
@@ -314,6 +316,14 @@ void BGI_Device::updateZoneLayers() noexcept {
   }
 }
 
+QPainterPath BGI_Device::buildShape() const noexcept {
+  QPainterPath p = mOriginCrossGraphicsItem->shape();
+  if (mGrabAreaLayer && mGrabAreaLayer->isVisible()) {
+    p |= mShape;
+  }
+  return p;
+}
+
 std::shared_ptr<GraphicsLayer> BGI_Device::getLayer(
     const Layer& layer) const noexcept {
   return mLayerProvider.getLayer(mDevice.getMirrored()
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../../graphics/graphicslayer.h"
+#include "../../../graphics/shapecache.h"
 
 #include <librepcb/core/project/board/items/bi_device.h>
 
@@ -72,6 +73,7 @@ public:
 
   // General Methods
   BI_Device& getDevice() noexcept { return mDevice; }
+  const ShapeCache& getShapeCache() const noexcept { return mShapeCache; }
 
   // Inherited from QGraphicsItem
   QPainterPath shape() const noexcept override;
@@ -90,6 +92,7 @@ private:  // Methods
   void updateBoardSide() noexcept;
   void updateHoleStopMaskOffsets() noexcept;
   void updateZoneLayers() noexcept;
+  QPainterPath buildShape() const noexcept;
   std::shared_ptr<GraphicsLayer> getLayer(const Layer& layer) const noexcept;
 
 private:  // Data
@@ -102,6 +105,7 @@ private:  // Data
   QVector<std::shared_ptr<PrimitiveZoneGraphicsItem>> mZoneGraphicsItems;
   QVector<std::shared_ptr<PrimitiveHoleGraphicsItem>> mHoleGraphicsItems;
   QPainterPath mShape;
+  ShapeCache mShapeCache;
 
   // Slots
   BI_Device::OnEditedSlot mOnEditedSlot;
@@ -84,6 +84,12 @@ BGI_FootprintPad::~BGI_FootprintPad() noexcept {
  *  General Methods
  ******************************************************************************/
 
+const ShapeCache& BGI_FootprintPad::getShapeCache() const noexcept {
+  // Note: The pad item has the same shape in scene coordinates.
+  Q_ASSERT(mGraphicsItem);
+  return mGraphicsItem->getShapeCache();
+}
+
 void BGI_FootprintPad::updateHighlightedNetSignals() noexcept {
   updateHightlighted(isSelected());
 }
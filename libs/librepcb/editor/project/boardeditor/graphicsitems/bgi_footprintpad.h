@@ -69,6 +69,7 @@ public:
   const std::weak_ptr<BGI_Device>& getDeviceGraphicsItem() noexcept {
     return mDeviceGraphicsItem;
   }
+  const ShapeCache& getShapeCache() const noexcept;
   void updateHighlightedNetSignals() noexcept;
 
   // Inherited from QGraphicsItem
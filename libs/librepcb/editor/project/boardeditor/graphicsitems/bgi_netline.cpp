@@ -23,6 +23,7 @@
 #include "bgi_netline.h"
 
 #include "../../../graphics/graphicslayer.h"
+#include "../../../graphics/lodpainterpath.h"
 #include "../boardgraphicsscene.h"
 
 #include <librepcb/core/project/board/items/bi_netline.h>
@@ -84,7 +85,12 @@ void BGI_NetLine::paint(QPainter* painter,
       mHighlightedNetSignals->contains(netsignal);
 
   // draw line
-  if (mLayer->isVisible()) {
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
+  if (mLayer->isVisible() && LodPainterPath::isTiny(mBoundingRect, lod)) {
+    // Smaller than a device pixel, a rectangle looks the same but is faster.
+    painter->fillRect(mBoundingRect, mLayer->getColor(highlight));
+  } else if (mLayer->isVisible()) {
     QPen pen(mLayer->getColor(highlight), mNetLine.getWidth()->toPx(),
              Qt::SolidLine, Qt::RoundCap);
     painter->setPen(pen);
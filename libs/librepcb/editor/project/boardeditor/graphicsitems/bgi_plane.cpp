@@ -180,8 +180,8 @@ void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     if (mPlane.isVisible()) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(mLayer->getColor(highlight));
-      foreach (const QPainterPath& area, mAreas) {
-        painter->drawPath(area);
+      foreach (const LodPainterPath& area, mAreas) {
+        area.paint(*painter, lod);
       }
     }
   }
@@ -265,8 +265,8 @@ void BGI_Plane::updateOutlineAndFragments() noexcept {
   // get areas
   mAreas.clear();
   for (const Path& r : mPlane.getFragments()) {
-    mAreas.append(r.toQPainterPathPx());
-    mBoundingRect = mBoundingRect.united(mAreas.last().boundingRect());
+    mAreas.append(LodPainterPath(r.toQPainterPathPx()));
+    mBoundingRect = mBoundingRect.united(mAreas.last().getBoundingRect());
   }
 
   updateBoundingRectMargin();
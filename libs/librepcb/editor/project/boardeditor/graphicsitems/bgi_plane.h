@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../../graphics/graphicslayer.h"
+#include "../../../graphics/lodpainterpath.h"
 
 #include <librepcb/core/project/board/items/bi_plane.h>
 #include <librepcb/core/types/point.h>
@@ -117,7 +118,7 @@ private:  // Data
   qreal mBoundingRectMarginPx;
   QPainterPath mShape;
   QPainterPath mOutline;
-  QVector<QPainterPath> mAreas;
+  QVector<LodPainterPath> mAreas;
   qreal mLineWidthPx;
   qreal mVertexHandleRadiusPx;
   struct VertexHandle {
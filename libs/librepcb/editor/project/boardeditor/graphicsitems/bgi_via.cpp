@@ -107,23 +107,26 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
   const NetSignal* netsignal = mVia.getNetSegment().getNetSignal();
   const bool highlight = option->state.testFlag(QStyle::State_Selected) ||
       mHighlightedNetSignals->contains(netsignal);
+  const qreal lod =
+      option->levelOfDetailFromTransform(painter->worldTransform());
 
   if (mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible() &&
-      (!mStopMaskBottom.isEmpty())) {
+      (!mStopMaskBottom.getPath().isEmpty())) {
     // draw bottom stop mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mBottomStopMaskLayer->getColor(highlight));
-    painter->drawPath(mStopMaskBottom);
+    mStopMaskBottom.paint(*painter, lod);
   }
 
   if (mViaLayer && mViaLayer->isVisible()) {
     // Draw through-hole via.
     painter->setPen(Qt::NoPen);
     painter->setBrush(mViaLayer->getColor(highlight));
-    painter->drawPath(mCopper);
+    mCopper.paint(*painter, lod);
 
-    // Draw copper layers of blind or buried via.
-    if (!mBlindBuriedCopperLayers.isEmpty()) {
+    // Draw copper layers of blind or buried via (invisible if tiny).
+    if ((!mBlindBuriedCopperLayers.isEmpty()) &&
+        (!LodPainterPath::isTiny(mBoundingRect, lod))) {
       const qreal innerRadius = mVia.getDrillDiameter()->toPx() / 2;
       const qreal outerRadius = mVia.getSize()->toPx() / 2;
       const qreal lineRadius = (innerRadius + outerRadius) / 2;
@@ -144,11 +147,11 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
   }
 
   if (mTopStopMaskLayer && mTopStopMaskLayer->isVisible() &&
-      (!mStopMaskTop.isEmpty())) {
+      (!mStopMaskTop.getPath().isEmpty())) {
     // draw top stop mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mTopStopMaskLayer->getColor(highlight));
-    painter->drawPath(mStopMaskTop);
+    mStopMaskTop.paint(*painter, lod);
   }
 }
 
@@ -223,19 +226,19 @@ void BGI_Via::updateShapes() noexcept {
   prepareGeometryChange();
 
   mShape = mVia.getVia().getOutline().toQPainterPathPx();
-  mCopper = mVia.getVia().toQPainterPathPx();
+  mCopper.setPath(mVia.getVia().toQPainterPathPx());
   if (auto diameter = mVia.getStopMaskDiameterBottom()) {
-    mStopMaskBottom = Path::circle(*diameter).toQPainterPathPx();
+    mStopMaskBottom.setPath(Path::circle(*diameter).toQPainterPathPx());
   } else {
-    mStopMaskBottom = QPainterPath();
+    mStopMaskBottom.setPath(QPainterPath());
   }
   if (auto diameter = mVia.getStopMaskDiameterTop()) {
-    mStopMaskTop = Path::circle(*diameter).toQPainterPathPx();
+    mStopMaskTop.setPath(Path::circle(*diameter).toQPainterPathPx());
   } else {
-    mStopMaskTop = QPainterPath();
+    mStopMaskTop.setPath(QPainterPath());
   }
-  mBoundingRect = mShape.boundingRect() | mStopMaskBottom.boundingRect() |
-      mStopMaskTop.boundingRect();
+  mBoundingRect = mShape.boundingRect() | mStopMaskBottom.getBoundingRect() |
+      mStopMaskTop.getBoundingRect();
 
   update();
 }
@@ -284,9 +287,9 @@ void BGI_Via::updateTextHeight() noexcept {
 void BGI_Via::updateVisibility() noexcept {
   // Check stop masks visibility.
   bool visible = (mTopStopMaskLayer && mTopStopMaskLayer->isVisible() &&
-                  (!mStopMaskTop.isEmpty())) ||
+                  (!mStopMaskTop.getPath().isEmpty())) ||
       (mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible() &&
-       (!mStopMaskBottom.isEmpty()));
+       (!mStopMaskBottom.getPath().isEmpty()));
   if (!visible) {
     // Check copper visibility.
     for (auto layer : mBlindBuriedCopperLayers) {
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../../../graphics/graphicslayer.h"
+#include "../../../graphics/lodpainterpath.h"
 
 #include <librepcb/core/project/board/items/bi_via.h>
 
@@ -103,9 +104,9 @@ private:  // Data
 
   // Cached Attributes
   QPainterPath mShape;
-  QPainterPath mCopper;
-  QPainterPath mStopMaskTop;
-  QPainterPath mStopMaskBottom;
+  LodPainterPath mCopper;
+  LodPainterPath mStopMaskTop;
+  LodPainterPath mStopMaskBottom;
   QRectF mBoundingRect;
   QString mText;
 
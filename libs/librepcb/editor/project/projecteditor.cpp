@@ -64,6 +64,7 @@ ProjectEditor::ProjectEditor(
   : QObject(nullptr),
     mWorkspace(workspace),
     mProject(project),
+    mErc(new ElectricalRuleCheck()),
     mHighlightedNetSignals(new QSet<const NetSignal*>()),
     mUndoStack(nullptr),
     mSchematicEditor(nullptr),
@@ -105,9 +106,17 @@ ProjectEditor::ProjectEditor(
     throw;  // ...and rethrow the exception
   }
 
-  // Run the ERC after opening and after every modification.
-  QTimer::singleShot(200, this, &ProjectEditor::runErc);
-  connect(mUndoStack, &UndoStack::stateModified, this, &ProjectEditor::runErc);
+  // Run the ERC after opening and after every modification. The ERC runs in
+  // a worker thread, but is delayed to avoid running it many times during
+  // a sequence of modifications.
+  mErcDelayTimer.setSingleShot(true);
+  mErcDelayTimer.setInterval(200);
+  connect(&mErcDelayTimer, &QTimer::timeout, this, &ProjectEditor::runErc);
+  connect(mErc.data(), &ElectricalRuleCheck::finished, this,
+          &ProjectEditor::handleErcResult, Qt::QueuedConnection);
+  connect(mUndoStack, &UndoStack::stateModified, this,
+          [this]() { mErcDelayTimer.start(); });
+  mErcDelayTimer.start();
 
   // setup the timer for automatic backups, if enabled in the settings
   int intervalSecs =
@@ -607,25 +616,33 @@ void ProjectEditor::clearHighlightedNetSignals() noexcept {
  ******************************************************************************/
 
 void ProjectEditor::runErc() noexcept {
-  try {
-    QElapsedTimer timer;
-    timer.start();
-    ElectricalRuleCheck erc(mProject);
-    mErcMessages = erc.runChecks();
-
-    // Detect disappeared messages & remove their approvals.
-    QSet<SExpression> approvals =
-        RuleCheckMessage::getAllApprovals(mErcMessages);
-    mSupportedErcApprovals |= approvals;
-    mDisappearedErcApprovals = mSupportedErcApprovals - approvals;
-    approvals = mProject.getErcMessageApprovals() - mDisappearedErcApprovals;
-    saveErcMessageApprovals(approvals);
+  mErc->start(mProject);
+}
 
-    emit ercFinished(mErcMessages);
-    qDebug() << "ERC succeeded after" << timer.elapsed() << "ms.";
-  } catch (const Exception& e) {
-    qCritical() << "ERC failed:" << e.getMsg();
+void ProjectEditor::handleErcResult(
+    const RuleCheckMessageList& messages) noexcept {
+  mErcMessages = messages;
+
+  // Detect disappeared messages & remove their approvals.
+  const QSet<RuleCheckMessage::ApprovalKey> keys =
+      RuleCheckMessage::getAllApprovalKeys(mErcMessages);
+  mSupportedErcApprovals |= keys;
+  mDisappearedErcApprovals = mSupportedErcApprovals - keys;
+  QSet<SExpression> approvals = mProject.getErcMessageApprovals();
+  bool modified = false;
+  const QHash<RuleCheckMessage::ApprovalKey, SExpression>& approvalKeys =
+      mProject.getErcMessageApprovalKeys();
+  for (auto it = approvalKeys.begin(); it != approvalKeys.end(); ++it) {
+    if (mDisappearedErcApprovals.contains(it.key())) {
+      approvals.remove(it.value());
+      modified = true;
+    }
   }
+  if (modified) {
+    saveErcMessageApprovals(approvals);
+  }
+
+  emit ercFinished(mErcMessages);
 }
 
 void ProjectEditor::saveErcMessageApprovals(
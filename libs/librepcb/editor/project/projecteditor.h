@@ -44,6 +44,7 @@ namespace librepcb {
 
 class Board;
 class ComponentInstance;
+class ElectricalRuleCheck;
 class FilePath;
 class LengthUnit;
 class Project;
@@ -270,6 +271,7 @@ signals:
 
 private:  // Methods
   void runErc() noexcept;
+  void handleErcResult(const RuleCheckMessageList& messages) noexcept;
   void saveErcMessageApprovals(const QSet<SExpression>& approvals) noexcept;
   int getCountOfVisibleEditorWindows() const noexcept;
   void searchAndOpenDatasheet(const QString& mpn, const QString& manufacturer,
@@ -285,8 +287,12 @@ private:  // Data
   /// functionality (see also @ref doc_project_save)
   QTimer mAutoSaveTimer;
 
-  QSet<SExpression> mSupportedErcApprovals;
-  QSet<SExpression> mDisappearedErcApprovals;
+  /// Delays the ERC after modifications to coalesce multiple modifications
+  QTimer mErcDelayTimer;
+
+  QScopedPointer<ElectricalRuleCheck> mErc;
+  QSet<RuleCheckMessage::ApprovalKey> mSupportedErcApprovals;
+  QSet<RuleCheckMessage::ApprovalKey> mDisappearedErcApprovals;
   RuleCheckMessageList mErcMessages;
 
   std::shared_ptr<QSet<const NetSignal*>> mHighlightedNetSignals;
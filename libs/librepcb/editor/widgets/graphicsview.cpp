@@ -23,6 +23,7 @@
 #include "graphicsview.h"
 
 #include "../graphics/graphicsscene.h"
+#include "../graphics/graphicstilecache.h"
 #include "QtOpenGL"
 #include "if_graphicsvieweventhandler.h"
 #include "waitingspinnerwidget.h"
@@ -55,6 +56,7 @@ GraphicsView::GraphicsView(QWidget* parent,
     mInfoBoxLabel(new QLabel(this)),
     mEventHandlerObject(eventHandler),
     mScene(nullptr),
+    mTileCache(new GraphicsTileCache()),
     mZoomAnimation(nullptr),
     mGridStyle(Theme::GridStyle::None),
     mGridInterval(2540000),
@@ -188,9 +190,21 @@ void GraphicsView::setGridInterval(const PositiveLength& interval) noexcept {
 
 void GraphicsView::setScene(GraphicsScene* scene) noexcept {
   mSceneRectMarker = QRectF();  // clear marker
-  if (mScene) mScene->removeEventFilter(this);
+  if (mScene) {
+    mScene->removeEventFilter(this);
+    disconnect(mScene, &QGraphicsScene::changed, this, nullptr);
+  }
+  mTileCache->clear();
   mScene = scene;
-  if (mScene) mScene->installEventFilter(this);
+  if (mScene) {
+    mScene->installEventFilter(this);
+    // Note: This connection must be made before QGraphicsView connects to
+    // the same signal to schedule repaints, so tiles are invalidated first.
+    connect(mScene, &QGraphicsScene::changed, this,
+            [this](const QList<QRectF>& rects) {
+              mTileCache->invalidate(rects);
+            });
+  }
   QGraphicsView::setScene(mScene);
 }
 
@@ -353,6 +367,31 @@ void GraphicsView::wheelEvent(QWheelEvent* event) {
   }
 }
 
+void GraphicsView::paintEvent(QPaintEvent* event) {
+  // The tile cache is only used for the software rasterizer, and not while
+  // zooming smoothly since intermediate zoom levels would never be reused.
+  const QTransform transform = viewportTransform();
+  if ((!mScene) || (!mScene->getLiveZValue()) || mUseOpenGl ||
+      (mZoomAnimation->state() == QAbstractAnimation::Running) ||
+      (!GraphicsTileCache::isSupportedTransform(transform))) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
+
+  const QRect deviceRect = event->rect();
+  const QRectF sceneRect = transform.inverted().mapRect(QRectF(deviceRect));
+  QPainter painter(viewport());
+  painter.setRenderHints(renderHints());
+  painter.setClipRect(deviceRect);
+  painter.setWorldTransform(transform);
+  drawBackground(&painter, sceneRect);
+  mTileCache->paint(painter, *mScene, transform, deviceRect);
+  GraphicsTileCache::paintItems(painter, mScene->getLiveItems(sceneRect),
+                                transform, viewport());
+  painter.setWorldTransform(transform);
+  drawForeground(&painter, sceneRect);
+}
+
 bool GraphicsView::eventFilter(QObject* obj, QEvent* event) {
   auto resetIdleTime = scopeGuard([this]() { mIdleTimeMs = 0; });
 
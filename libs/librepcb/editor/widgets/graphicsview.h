@@ -39,6 +39,7 @@ namespace librepcb {
 namespace editor {
 
 class GraphicsScene;
+class GraphicsTileCache;
 class IF_GraphicsViewEventHandler;
 class WaitingSpinnerWidget;
 
@@ -146,6 +147,7 @@ private slots:
 private:
   // Inherited Methods
   void wheelEvent(QWheelEvent* event);
+  void paintEvent(QPaintEvent* event);
   bool eventFilter(QObject* obj, QEvent* event);
   void drawBackground(QPainter* painter, const QRectF& rect);
   void drawForeground(QPainter* painter, const QRectF& rect);
@@ -155,6 +157,7 @@ private:
   QScopedPointer<QLabel> mInfoBoxLabel;
   IF_GraphicsViewEventHandler* mEventHandlerObject;
   GraphicsScene* mScene;
+  QScopedPointer<GraphicsTileCache> mTileCache;
   QVariantAnimation* mZoomAnimation;
   Theme::GridStyle mGridStyle;
   PositiveLength mGridInterval;
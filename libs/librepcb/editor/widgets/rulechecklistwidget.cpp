@@ -42,6 +42,7 @@ RuleCheckListWidget::RuleCheckListWidget(QWidget* parent) noexcept
     mReadOnly(false),
     mHandler(nullptr),
     mApprovals(),
+    mApprovalKeys(),
     mUnapprovedMessageCount(std::nullopt) {
   QVBoxLayout* layout = new QVBoxLayout(this);
   layout->setContentsMargins(0, 0, 0, 0);
@@ -83,6 +84,7 @@ void RuleCheckListWidget::setApprovals(
     const QSet<SExpression>& approvals) noexcept {
   if (approvals != mApprovals) {
     mApprovals = approvals;
+    mApprovalKeys = RuleCheckMessage::calcApprovalKeys(mApprovals);
     updateList();
   }
 }
@@ -100,8 +102,10 @@ void RuleCheckListWidget::updateList() noexcept {
              const std::shared_ptr<const RuleCheckMessage>& lhs,
              const std::shared_ptr<const RuleCheckMessage>& rhs) {
         if (lhs && rhs) {
-          const bool lhsApproved = mApprovals.contains(lhs->getApproval());
-          const bool rhsApproved = mApprovals.contains(rhs->getApproval());
+          const bool lhsApproved =
+              mApprovalKeys.contains(lhs->getApprovalKey());
+          const bool rhsApproved =
+              mApprovalKeys.contains(rhs->getApprovalKey());
           if (lhsApproved != rhsApproved) {
             return rhsApproved;
           } else if (lhs->getSeverity() != rhs->getSeverity()) {
@@ -123,7 +127,7 @@ void RuleCheckListWidget::updateList() noexcept {
   foreach (const auto& msg, mDisplayedMessages) {
     QListWidgetItem* item = new QListWidgetItem();
     mListWidget->addItem(item);
-    const bool approved = mApprovals.contains(msg->getApproval());
+    const bool approved = mApprovalKeys.contains(msg->getApprovalKey());
     RuleCheckListItemWidget* widget =
         new RuleCheckListItemWidget(msg, *this, approved);
     mListWidget->setItemWidget(item, widget);
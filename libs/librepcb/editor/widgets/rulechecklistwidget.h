@@ -214,6 +214,7 @@ private:  // Data
   std::optional<RuleCheckMessageList> mMessages;
   RuleCheckMessageList mDisplayedMessages;
   QSet<SExpression> mApprovals;
+  QSet<RuleCheckMessage::ApprovalKey> mApprovalKeys;
   std::optional<int> mUnapprovedMessageCount;
 };
 
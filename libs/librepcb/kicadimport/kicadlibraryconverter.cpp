@@ -82,8 +82,11 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
     const FilePath& libFp, const KiCadFootprint& kiFpt,
     const QString& generatedBy, const QMap<QString, FilePath>& models,
     MessageLogger& log) {
-  if (mPackageMap.contains(generatedBy)) {
-    throw LogicError(__FILE__, __LINE__, "Duplicate import.");
+  {
+    QMutexLocker lock(&mPackageMapMutex);
+    if (mPackageMap.contains(generatedBy)) {
+      throw LogicError(__FILE__, __LINE__, "Duplicate import.");
+    }
   }
   if (kiFpt.layer != KiCadLayer::FrontCopper) {
     throw RuntimeError(__FILE__, __LINE__, "Unsupported footprint board side.");
@@ -196,6 +199,7 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
   }
 
   // Pads.
+  QMap<QString, std::optional<Uuid>> padMap;
   for (const KiCadFootprintPad& obj : kiFpt.pads) {
     tryOrLogError(
         [&]() {
@@ -209,8 +213,7 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
               pkgPad = std::make_shared<PackagePad>(
                   res.fptPad->getUuid(), CircuitIdentifier(obj.number));
               package->getPads().append(pkgPad);
-              mPackagePadMap[generatedBy][*pkgPad->getName()] =
-                  pkgPad->getUuid();
+              padMap[*pkgPad->getName()] = pkgPad->getUuid();
             }
             if (pkgPad) {
               res.fptPad->setPackagePadUuid(pkgPad->getUuid());
@@ -259,6 +262,11 @@ std::unique_ptr<Package> KiCadLibraryConverter::createPackage(
         log);
   }
 
+  QMutexLocker lock(&mPackageMapMutex);
+  if (mPackageMap.contains(generatedBy)) {
+    throw LogicError(__FILE__, __LINE__, "Duplicate import.");
+  }
+  mPackagePadMap[generatedBy] = padMap;
   mPackageMap[generatedBy] = package->getUuid();
   return package;
 }
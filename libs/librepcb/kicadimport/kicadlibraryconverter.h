@@ -87,6 +87,8 @@ public:
 
   // General Methods
   void reset() noexcept;
+  // Note: createPackage() may be called from several threads in parallel,
+  // but not in parallel to any other method.
   std::unique_ptr<Package> createPackage(const FilePath& libFp,
                                          const KiCadFootprint& kiFpt,
                                          const QString& generatedBy,
@@ -124,6 +126,9 @@ private:  // Data
   WorkspaceLibraryDb& mLibraryDb;
   KiCadLibraryConverterSettings mSettings;
 
+  /// Protects the package maps during parallel calls to createPackage()
+  QMutex mPackageMapMutex;
+
   /// Key: generatedBy
   /// Value: LibrePCB Package UUID
   QHash<QString, std::optional<Uuid>> mPackageMap;
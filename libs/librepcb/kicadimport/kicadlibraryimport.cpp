@@ -616,36 +616,73 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::parse(
     emit progressPercent(5 + (45 * (++i) / result->symbolLibs.count()));
   }
 
-  // Load footprints.
+  // Load footprints. Reading and parsing the files is done in parallel, but
+  // the results (including log messages) are processed in the original order
+  // to keep the output deterministic. The parsed footprints are kept in the
+  // result to avoid parsing them again during the import.
+  struct ParsedFootprint {
+    std::shared_ptr<const KiCadFootprint> footprint;
+    QList<MessageLogger::Message> messages;
+    QString error;
+  };
+  auto parseFootprint = [](const FilePath& fp) {
+    ParsedFootprint parsed;
+    MessageLogger log;
+    try {
+      std::unique_ptr<SExpression> root = SExpression::parse(
+          FileUtils::readFile(fp), fp, SExpression::Mode::Permissive);
+      parsed.footprint =
+          std::make_shared<KiCadFootprint>(KiCadFootprint::parse(*root, log));
+    } catch (const Exception& e) {
+      parsed.error = e.getMsg();
+    }
+    parsed.messages = log.getMessages();
+    return parsed;
+  };
+  QThreadPool pool;
+  QList<QList<QFuture<ParsedFootprint>>> futures;
+  for (const FootprintLibrary& lib : result->footprintLibs) {
+    QList<QFuture<ParsedFootprint>> libFutures;
+    for (const FilePath& fptFp : lib.files) {
+      libFutures.append(QtConcurrent::run(&pool, parseFootprint, fptFp));
+    }
+    futures.append(libFutures);
+  }
   i = 0;
   int footprintCount = 0;
   for (FootprintLibrary& lib : result->footprintLibs) {
     lib.footprints.clear();  // Might be a leftover from previous run.
-    for (const FilePath& fptFp : lib.files) {
-      if (mAbort) break;
+    for (int iFpt = 0; iFpt < lib.files.count(); ++iFpt) {
+      if (mAbort) {
+        pool.clear();
+        break;
+      }
 
+      const FilePath& fptFp = lib.files.at(iFpt);
+      const ParsedFootprint parsed = futures.at(i).at(iFpt).result();
       MessageLogger fptLog(
           log.get(),
           lib.dir.getCompleteBasename() + ":" + fptFp.getCompleteBasename());
-      try {
-        std::unique_ptr<SExpression> root = SExpression::parse(
-            FileUtils::readFile(fptFp), fptFp, SExpression::Mode::Permissive);
-        KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
+      for (const MessageLogger::Message& msg : parsed.messages) {
+        fptLog.log(msg.type, msg.message);
+      }
+      if (parsed.footprint) {
         const QString pkgGeneratedBy = generatedBy(
             lib.dir.getCompleteBasename(), {fptFp.getCompleteBasename()});
         lib.footprints.append(Footprint{
             fptFp,
-            kiFpt.name,
+            parsed.footprint->name,
             pkgGeneratedBy,
             isAlreadyImported<librepcb::Package>(pkgGeneratedBy),
             Qt::Checked,
+            parsed.footprint,
         });
         ++footprintCount;
-      } catch (const Exception& e) {
+      } else {
         fptLog.critical(
             QString("Failed to parse footprint '%1':")
                 .arg(lib.dir.getFilename() + ":" + fptFp.getFilename()) %
-            " " % e.getMsg());
+            " " % parsed.error);
       }
     }
     emit progressPercent(50 + (45 * (++i) / result->footprintLibs.count()));
@@ -718,75 +755,121 @@ std::shared_ptr<KiCadLibraryImport::Result> KiCadLibraryImport::import(
     }
   }
 
-  // Import packages.
-  QSet<QString> missing3dShapeLibs;
-  for (const FootprintLibrary& lib : result->footprintLibs) {
-    for (const Footprint& fpt : lib.footprints) {
-      if (mAbort) {
-        break;
-      }
-      if ((fpt.checked == Qt::Unchecked) || fpt.alreadyImported) {
-        continue;
+  // Build a lookup table of all STEP files, by library and file name.
+  QHash<QString, QHash<QString, FilePath>> stepFiles;
+  for (const Package3DLibrary& lib : result->package3dLibs) {
+    QHash<QString, FilePath>& files = stepFiles[lib.dir.getFilename()];
+    for (const FilePath& fp : lib.stepFiles) {
+      files.insert(fp.getFilename(), fp);
+    }
+  }
+
+  // Import packages. The conversion is done in parallel, with only a limited
+  // number of packages in flight to bound the memory usage. The converted
+  // packages are written to the library by this thread, in the original
+  // order.
+  struct ConvertedPackage {
+    std::shared_ptr<librepcb::Package> package;
+    QList<MessageLogger::Message> messages;
+    QSet<QString> missing3dShapeLibs;
+    QString error;
+  };
+  auto convertPackage = [&converter, &stepFiles](const FootprintLibrary* lib,
+                                                 const Footprint* fpt) {
+    ConvertedPackage converted;
+    MessageLogger fptLog;
+    try {
+      if (!fpt->parsed) {
+        throw LogicError(__FILE__, __LINE__, "Footprint not parsed.");
       }
-      MessageLogger fptLog(
-          log.get(),
-          lib.dir.getCompleteBasename() % ":" % fpt.file.getCompleteBasename());
-      emit progressStatus(lib.dir.getCompleteBasename() % ":" %
-                          fpt.file.getCompleteBasename());
-      try {
-        std::unique_ptr<SExpression> root =
-            SExpression::parse(FileUtils::readFile(fpt.file), fpt.file,
-                               SExpression::Mode::Permissive);
-        KiCadFootprint kiFpt = KiCadFootprint::parse(*root, fptLog);
-
-        // Find 3D models.
-        QMap<QString, FilePath> models;
-        for (const KiCadFootprintModel& model : kiFpt.models) {
-          const QStringList pathSegments = model.path.split("/");
-          const QString libName = pathSegments.value(pathSegments.count() - 2);
-          const QString fileName = pathSegments.value(pathSegments.count() - 1)
-                                       .replace(".wrl", ".step");
-          if ((!libName.endsWith(".3dshapes")) ||
-              (!fileName.endsWith(".step"))) {
-            fptLog.warning(
-                QString("Unknown 3D model file: '%1'").arg(model.path));
-            continue;
-          }
-          bool libFound = false;
-          for (const Package3DLibrary& lib : result->package3dLibs) {
-            if (lib.dir.getFilename() == libName) {
-              libFound = true;
-              for (const FilePath& fp : lib.stepFiles) {
-                if (fp.getFilename() == fileName) {
-                  models.insert(model.path, fp);
-                }
-              }
-            }
-          }
-          if (!libFound) {
-            missing3dShapeLibs.insert(libName);
-          }
+
+      // Find 3D models.
+      QMap<QString, FilePath> models;
+      for (const KiCadFootprintModel& model : fpt->parsed->models) {
+        const QStringList pathSegments = model.path.split("/");
+        const QString libName = pathSegments.value(pathSegments.count() - 2);
+        const QString fileName = pathSegments.value(pathSegments.count() - 1)
+                                     .replace(".wrl", ".step");
+        if ((!libName.endsWith(".3dshapes")) ||
+            (!fileName.endsWith(".step"))) {
+          fptLog.warning(
+              QString("Unknown 3D model file: '%1'").arg(model.path));
+          continue;
+        }
+        auto libIt = stepFiles.constFind(libName);
+        if (libIt == stepFiles.constEnd()) {
+          converted.missing3dShapeLibs.insert(libName);
+          continue;
+        }
+        auto fileIt = libIt->constFind(fileName);
+        if (fileIt != libIt->constEnd()) {
+          models.insert(model.path, *fileIt);
         }
+      }
 
-        // Create package.
-        auto package =
-            converter.createPackage(lib.dir, kiFpt, fpt.generatedBy, models,
-                                    fptLog);  // can throw
-        TransactionalDirectory dir(TransactionalFileSystem::openRW(
-            mDestinationLibraryFp
-                .getPathTo(librepcb::Package::getShortElementName())
-                .getPathTo(package->getUuid().toStr())));
-        package->saveTo(dir);
-        dir.getFileSystem()->save();
-        ++importedCount;
-      } catch (const Exception& e) {
-        fptLog.critical(
-            tr("Skipped footprint due to error: %1").arg(e.getMsg()));
+      // Create package.
+      converted.package =
+          converter.createPackage(lib->dir, *fpt->parsed, fpt->generatedBy,
+                                  models, fptLog);  // can throw
+    } catch (const Exception& e) {
+      converted.error = e.getMsg();
+    }
+    converted.messages = fptLog.getMessages();
+    return converted;
+  };
+  QList<std::pair<const FootprintLibrary*, const Footprint*>> footprints;
+  for (const FootprintLibrary& lib : result->footprintLibs) {
+    for (const Footprint& fpt : lib.footprints) {
+      if ((fpt.checked != Qt::Unchecked) && (!fpt.alreadyImported)) {
+        footprints.append(std::make_pair(&lib, &fpt));
+      }
+    }
+  }
+  QSet<QString> missing3dShapeLibs;
+  QThreadPool pool;
+  QQueue<QFuture<ConvertedPackage>> futures;
+  const int maxFutures = std::max(pool.maxThreadCount(), 1) * 4;
+  for (int iFpt = 0; iFpt < footprints.count(); ++iFpt) {
+    while ((futures.count() < maxFutures) &&
+           ((iFpt + futures.count()) < footprints.count()) && (!mAbort)) {
+      const auto& item = footprints.at(iFpt + futures.count());
+      futures.enqueue(
+          QtConcurrent::run(&pool, convertPackage, item.first, item.second));
+    }
+    if (mAbort) {
+      break;
+    }
+    const FootprintLibrary& lib = *footprints.at(iFpt).first;
+    const Footprint& fpt = *footprints.at(iFpt).second;
+    MessageLogger fptLog(
+        log.get(),
+        lib.dir.getCompleteBasename() % ":" % fpt.file.getCompleteBasename());
+    emit progressStatus(lib.dir.getCompleteBasename() % ":" %
+                        fpt.file.getCompleteBasename());
+    const ConvertedPackage converted = futures.dequeue().result();
+    for (const MessageLogger::Message& msg : converted.messages) {
+      fptLog.log(msg.type, msg.message);
+    }
+    missing3dShapeLibs |= converted.missing3dShapeLibs;
+    try {
+      if (!converted.package) {
+        throw RuntimeError(__FILE__, __LINE__, converted.error);
       }
-      ++processedCount;
-      emit progressPercent((100 * processedCount) / std::max(totalCount, 1));
+      TransactionalDirectory dir(TransactionalFileSystem::openRW(
+          mDestinationLibraryFp
+              .getPathTo(librepcb::Package::getShortElementName())
+              .getPathTo(converted.package->getUuid().toStr())));
+      converted.package->saveTo(dir);
+      dir.getFileSystem()->save();
+      ++importedCount;
+    } catch (const Exception& e) {
+      fptLog.critical(tr("Skipped footprint due to error: %1").arg(e.getMsg()));
     }
+    ++processedCount;
+    emit progressPercent((100 * processedCount) / std::max(totalCount, 1));
   }
+  pool.clear();
+  pool.waitForDone();
 
   // Import symbols, components & devices.
   for (const SymbolLibrary& lib : result->symbolLibs) {
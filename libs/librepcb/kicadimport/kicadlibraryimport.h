@@ -40,6 +40,7 @@ class WorkspaceLibraryDb;
 
 namespace kicadimport {
 
+struct KiCadFootprint;
 struct KiCadLibraryConverterSettings;
 
 /*******************************************************************************
@@ -95,6 +96,7 @@ public:
     QString generatedBy;  // To be set as "generated_by" property.
     bool alreadyImported;
     Qt::CheckState checked;
+    std::shared_ptr<const KiCadFootprint> parsed;  // Kept for the import.
   };
 
   struct FootprintLibrary {
@@ -3,6 +3,7 @@
 
 import os
 import params
+import pytest
 import shutil
 
 """
@@ -28,13 +29,15 @@ def test_no_messages(cli):
     assert code == 0
 
 
-def test_messages(cli):
+@pytest.mark.parametrize("jobs", [[], ['--jobs', '1'], ['--jobs', '0'],
+                                  ['--jobs', '4']])
+def test_messages(cli, jobs):
     library = params.POPULATED_LIBRARY
     cli.add_library(library.dir)
     for subdir in ['sym', 'pkg', 'cmp']:
         shutil.rmtree(cli.abspath(os.path.join(library.dir, subdir)))
     code, stdout, stderr = cli.run('open-library', '--all', '--check',
-                                   library.dir)
+                                   *jobs, library.dir)
     assert stderr == \
         "  - R-0805 (078650d3-483c-4b9e-a848-b14f1aad2edc):\n" \
         "    - [HINT] No part numbers added\n" \
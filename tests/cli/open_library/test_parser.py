@@ -1,6 +1,8 @@
 #!/usr/bin/env python
 # -*- coding: utf-8 -*-
 
+import params
+
 """
 Test command "open-library" (basic parser tests)
 """
@@ -10,25 +12,28 @@ Usage: {executable} [options] open-library [command_options] library
 LibrePCB Command Line Interface
 
 Options:
-  -h, --help     Print this message.
-  -V, --version  Displays version information.
-  -v, --verbose  Verbose output.
-  --all          Perform the selected action(s) on all elements contained in
-                 the opened library.
-  --check        Run the library element check, print all non-approved messages
-                 and report failure (exit code = 1) if there are non-approved
-                 messages.
-  --minify-step  Minify the STEP models of all packages. Only works in
-                 conjunction with '--all'. Pass '--save' to write the minified
-                 files to disk.
-  --save         Save library (and contained elements if '--all' is given)
-                 before closing them (useful to upgrade file format).
-  --strict       Fail if the opened files are not strictly canonical, i.e.
-                 there would be changes when saving the library elements.
+  -h, --help      Print this message.
+  -V, --version   Displays version information.
+  -v, --verbose   Verbose output.
+  --all           Perform the selected action(s) on all elements contained in
+                  the opened library.
+  --check         Run the library element check, print all non-approved
+                  messages and report failure (exit code = 1) if there are
+                  non-approved messages.
+  --jobs <count>  Number of library elements to process in parallel with
+                  '--all'. Defaults to 1, pass 0 to use one job per CPU core.
+                  The console output is the same for any number of jobs.
+  --minify-step   Minify the STEP models of all packages. Only works in
+                  conjunction with '--all'. Pass '--save' to write the minified
+                  files to disk.
+  --save          Save library (and contained elements if '--all' is given)
+                  before closing them (useful to upgrade file format).
+  --strict        Fail if the opened files are not strictly canonical, i.e.
+                  there would be changes when saving the library elements.
 
 Arguments:
-  open-library   Open a library to execute library-related tasks.
-  library        Path to library directory (*.lplib).
+  open-library    Open a library to execute library-related tasks.
+  library         Path to library directory (*.lplib).
 """
 
 ERROR_TEXT = """\
@@ -63,3 +68,13 @@ def test_invalid_argument(cli):
     )
     assert stdout == ''
     assert code == 1
+
+
+def test_invalid_jobs(cli):
+    library = params.EMPTY_LIBRARY
+    cli.add_library(library.dir)
+    code, stdout, stderr = cli.run('open-library', '--all', '--jobs', 'foo',
+                                   library.dir)
+    assert stderr == "Invalid number of jobs: 'foo'\n"
+    assert stdout == "Finished with errors!\n"
+    assert code == 1
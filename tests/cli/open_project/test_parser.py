@@ -27,6 +27,11 @@ Options:
                                      file containing custom settings. If not
                                      set, the settings from the boards will be
                                      used instead.
+  --drc-jobs <count>                 Number of threads to use for the design
+                                     rule check. The checks of all selected
+                                     boards run in parallel and share these
+                                     threads. Defaults to 0, which uses one
+                                     thread per CPU core.
   --run-job <name>                   Run a particular output job. Can be given
                                      multiple times to run multiple jobs.
   --run-jobs                         Run all existing output jobs.
@@ -146,3 +151,11 @@ def test_invalid_argument(cli):
     )
     assert stdout == ''
     assert code == 1
+
+
+def test_invalid_drc_jobs(cli):
+    code, stdout, stderr = cli.run('open-project', '--drc', '--drc-jobs',
+                                   'foo', 'project.lpp')
+    assert stderr == "Invalid number of jobs: 'foo'\n"
+    assert stdout == "Finished with errors!\n"
+    assert code == 1
@@ -40,6 +40,27 @@ def test_project_with_two_boards_explicit_one(cli, project):
     assert code == 0
 
 
+@pytest.mark.parametrize("project", [params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM])
+@pytest.mark.parametrize("jobs", [[], ['--drc-jobs', '1'],
+                                  ['--drc-jobs', '0'], ['--drc-jobs', '4']])
+def test_project_with_two_boards_in_parallel(cli, project, jobs):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project', '--drc', *jobs,
+                                   project.path)
+    assert stderr == ''
+    assert stdout == \
+        "Open project '{project.path}'...\n" \
+        "Run DRC...\n" \
+        "  Board 'default':\n" \
+        "    Approved messages: 0\n" \
+        "    Non-approved messages: 0\n" \
+        "  Board 'copy':\n" \
+        "    Approved messages: 0\n" \
+        "    Non-approved messages: 0\n" \
+        "SUCCESS\n".format(project=project)
+    assert code == 0
+
+
 @pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
 def test_board_with_approved_message(cli, project):
     cli.add_project(project.dir, as_lppz=project.is_lppz)
@@ -28,6 +28,11 @@
 #include <librepcb/core/geometry/path.h>
 #include <librepcb/core/utils/transform.h>
 
+#include <QtCore>
+
+#include <iostream>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -38,7 +43,55 @@ namespace tests {
  *  Test Class
  ******************************************************************************/
 
-class OccModelTest : public ::testing::Test {};
+class OccModelTest : public ::testing::Test {
+protected:
+  /**
+   * @brief Generate a big STEP file with many duplicate entities
+   *
+   * Each grid point is written twice (once with a negative zero) and
+   * referenced by a line, and all lines share identical directions. After
+   * minification, one point and one line per grid point plus a single
+   * direction remain.
+   */
+  static QByteArray createLargeStep(int size) {
+    QByteArray content =
+        "ISO-10303-21;\nHEADER;\nFILE_NAME('large.step');\nENDSEC;\nDATA;\n";
+    int id = 0;
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        const QByteArray coords =
+            QByteArray::number(x) % ".," % QByteArray::number(y) % ".,";
+        content += "#" % QByteArray::number(++id) % " = CARTESIAN_POINT('', (" %
+            coords % "0.));\n";
+        content += "#" % QByteArray::number(++id) % " = CARTESIAN_POINT('', (" %
+            coords % "-0.));\n";
+        content += "#" % QByteArray::number(++id) %
+            " = DIRECTION('', (1., 0., 0.));\n";
+        content += "#" % QByteArray::number(id + 1) % " = LINE('', #" %
+            QByteArray::number(id - 1) % ", #" % QByteArray::number(id) %
+            ");\n";
+        ++id;
+      }
+    }
+    content += "ENDSEC;\nEND-ISO-10303-21;\n";
+    return content;
+  }
+
+  /**
+   * @brief Measure the fastest of several runs of a function
+   */
+  template <typename Fun>
+  static qint64 measureNs(int runs, Fun fun) {
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < runs; ++i) {
+      QElapsedTimer timer;
+      timer.start();
+      fun();
+      best = std::min(best, timer.nsecsElapsed());
+    }
+    return best;
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
@@ -279,6 +332,74 @@ TEST_F(OccModelTest, testMinifyStepColors) {
   EXPECT_EQ(result, result2);
 }
 
+TEST_F(OccModelTest, testMinifyStepQuotedStrings) {
+  const QByteArray input =
+      "header;\n"
+      "DATA;\n"
+      "#1 = NAME('a;#2 -0.');\n"
+      "#2 = NAME('a;#2 -0.');\n"
+      "#3 = FOO(#1, -0.);\n"
+      "#4 = FOO(#2, 0.);\n"
+      "ENDSEC;\n"
+      "footer;\n";
+  const QByteArray expected =
+      "header;\n"
+      "DATA;\n"
+      "#1=NAME('a;#2 -0.');\n"
+      "#2=FOO(#1, 0.);\n"
+      "ENDSEC;\n"
+      "footer;\n";
+  const QByteArray result = OccModel::minifyStep(input);
+  EXPECT_EQ(expected.toStdString(), result.toStdString());
+}
+
+// Two identical, deeply nested chains of entities must be merged into a
+// single chain.
+TEST_F(OccModelTest, testMinifyStepLarge) {
+  const int count = 200000;
+  QByteArray input = "header;\nDATA;\n";
+  QByteArray expected = input;
+  for (int i = 0; i < count; ++i) {
+    for (int k = 1; k <= 2; ++k) {
+      input += "#" % QByteArray::number(2 * i + k) % " = LINK('', #" %
+          QByteArray::number(2 * i + k + 2) % ");\n";
+    }
+    expected += "#" % QByteArray::number(i + 1) % "=LINK('', #" %
+        QByteArray::number(i + 2) % ");\n";
+  }
+  input += "#" % QByteArray::number(2 * count + 1) %
+      " = CARTESIAN_POINT('', (0., -0., 1.));\n";
+  input += "#" % QByteArray::number(2 * count + 2) %
+      " = CARTESIAN_POINT('', (0., 0., 1.));\n";
+  input += "ENDSEC;\nfooter;\n";
+  expected += "#" % QByteArray::number(count + 1) %
+      "=CARTESIAN_POINT('', (0., 0., 1.));\n";
+  expected += "ENDSEC;\nfooter;\n";
+
+  const QByteArray result = OccModel::minifyStep(input);
+  EXPECT_EQ(expected.toStdString(), result.toStdString());
+}
+
+// Not a strict performance test, but prints the minification time of a big
+// STEP file (~15MB) to compare implementations.
+TEST_F(OccModelTest, testMinifyStepBenchmark) {
+  const int size = 250;
+  const int runs = 3;
+  const QByteArray input = createLargeStep(size);
+
+  QByteArray result;
+  const qint64 ns =
+      measureNs(runs, [&]() { result = OccModel::minifyStep(input); });
+
+  RecordProperty("input_bytes", static_cast<int>(input.size()));
+  RecordProperty("output_bytes", static_cast<int>(result.size()));
+  RecordProperty("minify_us", static_cast<int>(ns / 1000));
+  std::cout << "[ BENCHMARK] minify " << (input.size() / 1024) << " kB: "
+            << (ns / 1000) << " us" << std::endl;
+  EXPECT_EQ(2 * size * size + 1, result.count("\n#"));
+  EXPECT_EQ(result, OccModel::minifyStep(result));
+}
+
 TEST_F(OccModelTest, testMinifyStepInvalid) {
   EXPECT_THROW(OccModel::minifyStep(QByteArray()), Exception);
 }
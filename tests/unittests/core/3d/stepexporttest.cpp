@@ -0,0 +1,160 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/3d/occmodel.h>
+#include <librepcb/core/3d/scenedata3d.h>
+#include <librepcb/core/3d/stepexport.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/transform.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StepExportTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  StepExportTest() : mTmpDir(FilePath::getRandomTempPath()) {}
+
+  virtual ~StepExportTest() { QDir(mTmpDir.toStr()).removeRecursively(); }
+
+  /**
+   * @brief Create a STEP file of a simple board with the given size
+   */
+  QByteArray createStepFile(int sizeMm) const {
+    const Length size(sizeMm * 1000000);
+    const std::unique_ptr<OccModel> model = OccModel::createBoard(
+        Path::rect(Point(0, 0), Point(size, size)), {},
+        PositiveLength(1000000), Qt::green);
+    const FilePath fp = mTmpDir.getPathTo(QString("board%1.step").arg(sizeMm));
+    model->saveAsStep("Board", fp);
+    return FileUtils::readFile(fp);
+  }
+
+  /**
+   * @brief Create scene data with many devices sharing a few STEP models
+   */
+  std::shared_ptr<SceneData3D> createSceneData(int modelCount,
+                                               int deviceCount) const {
+    const FilePath dir = mTmpDir.getPathTo("models");
+    for (int i = 0; i < modelCount; ++i) {
+      FileUtils::writeFile(dir.getPathTo(QString("%1.step").arg(i)),
+                           createStepFile(i + 1));
+    }
+    auto data = std::make_shared<SceneData3D>(
+        TransactionalFileSystem::openRO(dir));
+    data->setProjectName("Test");
+    data->addArea(Layer::boardOutlines(),
+                  Path::rect(Point(0, 0), Point(100000000, 100000000)),
+                  Transform());
+    for (int i = 0; i < deviceCount; ++i) {
+      data->addDevice(Uuid::createRandom(),
+                      Transform(Point(1000000 * i, 1000000 * i)),
+                      QString("%1.step").arg(i % modelCount), Point3D(),
+                      Angle3D(), QString("U%1").arg(i));
+    }
+    return data;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StepExportTest, testLoadStepConcurrently) {
+  if (!OccModel::isAvailable()) {
+    GTEST_SKIP();
+  }
+
+  // Documents are created and closed in parallel, which must be serialized
+  // internally.
+  const QByteArray content = createStepFile(10);
+  const QList<int> indices = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+  for (int run = 0; run < 3; ++run) {
+    QtConcurrent::blockingMap(indices, [&content](int) {
+      std::unique_ptr<OccModel> model = OccModel::loadStep(content);
+      EXPECT_TRUE(model != nullptr);
+    });
+  }
+}
+
+TEST_F(StepExportTest, testExportSharedModels) {
+  if (!OccModel::isAvailable()) {
+    GTEST_SKIP();
+  }
+
+  const FilePath fp = mTmpDir.getPathTo("out.step");
+  StepExport exp;
+  exp.start(createSceneData(3, 30), fp);
+  EXPECT_EQ("", exp.waitForFinished().toStdString());
+  EXPECT_FALSE(exp.isBusy());
+  EXPECT_TRUE(fp.isExistingFile());
+
+  // The exported file must be readable again.
+  EXPECT_TRUE(OccModel::loadStep(FileUtils::readFile(fp)) != nullptr);
+}
+
+TEST_F(StepExportTest, testCancelWaitsForLoadingModels) {
+  if (!OccModel::isAvailable()) {
+    GTEST_SKIP();
+  }
+
+  // Cancelling must not leave any model loading in the background. Since the
+  // exporter is destroyed right after cancelling, any left over thread would
+  // crash or be reported by sanitizers.
+  std::shared_ptr<SceneData3D> data = createSceneData(8, 16);
+  for (int i = 0; i < 5; ++i) {
+    std::unique_ptr<StepExport> exp(new StepExport());
+    exp->start(std::make_shared<SceneData3D>(*data),
+               mTmpDir.getPathTo("out.step"));
+    QThread::msleep(10 * i);
+    exp->cancel();
+    EXPECT_FALSE(exp->isBusy());
+  }
+
+  // A subsequent export must still work.
+  StepExport exp;
+  exp.start(std::make_shared<SceneData3D>(*data),
+            mTmpDir.getPathTo("out.step"));
+  EXPECT_EQ("", exp.waitForFinished().toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/3d/stepmeshcache.h>
+#include <librepcb/core/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StepMeshCacheTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+
+  StepMeshCacheTest() : mTmpDir(FilePath::getRandomTempPath()) {}
+
+  virtual ~StepMeshCacheTest() {
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StepMeshCacheTest, testCalcKey) {
+  const QString key1 = StepMeshCache::calcKey("foo");
+  const QString key2 = StepMeshCache::calcKey("foo");
+  const QString key3 = StepMeshCache::calcKey("bar");
+  EXPECT_EQ(64, key1.length());
+  EXPECT_EQ(key1.toStdString(), key2.toStdString());
+  EXPECT_NE(key1.toStdString(), key3.toStdString());
+}
+
+TEST_F(StepMeshCacheTest, testStoreAndLoad) {
+  StepMeshCache::Mesh mesh;
+  mesh[std::make_tuple(0.1, 0.2, 0.3)] = {
+      QVector3D(1, 2, 3),
+      QVector3D(4, 5, 6),
+      QVector3D(-7.5, 8.25, 9),
+  };
+  mesh[std::make_tuple(1.0, 1.0, 1.0)] = {};
+  mesh[std::make_tuple(0.0, 0.0, 0.0)] = {
+      QVector3D(0, 0, 0),
+      QVector3D(1, 0, 0),
+      QVector3D(0, 1, 0),
+  };
+
+  const StepMeshCache cache(mTmpDir);
+  const QString key = StepMeshCache::calcKey("content");
+  EXPECT_FALSE(cache.load(key).has_value());
+  cache.store(key, mesh);
+  const std::optional<StepMeshCache::Mesh> loaded = cache.load(key);
+  ASSERT_TRUE(loaded.has_value());
+  EXPECT_EQ(mesh, *loaded);
+  EXPECT_FALSE(cache.load(StepMeshCache::calcKey("other")).has_value());
+}
+
+TEST_F(StepMeshCacheTest, testLoadInvalid) {
+  const StepMeshCache cache(mTmpDir);
+  const QString key = StepMeshCache::calcKey("content");
+  StepMeshCache::Mesh mesh;
+  mesh[std::make_tuple(0.1, 0.2, 0.3)] = {QVector3D(1, 2, 3)};
+  cache.store(key, mesh);
+
+  // Truncated file.
+  const FilePath fp = mTmpDir.getPathTo(key % ".mesh");
+  const QByteArray content = FileUtils::readFile(fp);
+  FileUtils::writeFile(fp, content.left(content.size() - 1));
+  EXPECT_FALSE(cache.load(key).has_value());
+
+  // Wrong magic.
+  FileUtils::writeFile(fp, "LPMESH99" % content.mid(8));
+  EXPECT_FALSE(cache.load(key).has_value());
+
+  // Trailing data.
+  FileUtils::writeFile(fp, content % "x");
+  EXPECT_FALSE(cache.load(key).has_value());
+
+  // Empty file.
+  FileUtils::writeFile(fp, QByteArray());
+  EXPECT_FALSE(cache.load(key).has_value());
+}
+
+TEST_F(StepMeshCacheTest, testPruneLeastRecentlyUsed) {
+  // Each file has 16 bytes header, 32 bytes color and 120 bytes vertices,
+  // thus the cache can hold two files.
+  StepMeshCache::Mesh mesh;
+  mesh[std::make_tuple(0.1, 0.2, 0.3)] = QVector<QVector3D>(10);
+  const StepMeshCache cache(mTmpDir, 400);
+  EXPECT_EQ(400, cache.getMaxSize());
+  const QString key1 = StepMeshCache::calcKey("1");
+  const QString key2 = StepMeshCache::calcKey("2");
+  const QString key3 = StepMeshCache::calcKey("3");
+  auto setAge = [this](const QString& key, int seconds) {
+    QFile file(mTmpDir.getPathTo(key % ".mesh").toStr());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.setFileTime(
+        QDateTime::currentDateTime().addSecs(-seconds),
+        QFileDevice::FileModificationTime));
+  };
+  auto exists = [this](const QString& key) {
+    return mTmpDir.getPathTo(key % ".mesh").isExistingFile();
+  };
+
+  cache.store(key1, mesh);
+  setAge(key1, 200);
+  cache.store(key2, mesh);
+  setAge(key2, 100);
+  EXPECT_TRUE(exists(key1));
+  EXPECT_TRUE(exists(key2));
+
+  // Loading marks the file as recently used, so the other one gets removed.
+  EXPECT_TRUE(cache.load(key1).has_value());
+  cache.store(key3, mesh);
+  EXPECT_TRUE(exists(key1));
+  EXPECT_FALSE(exists(key2));
+  EXPECT_TRUE(exists(key3));
+  EXPECT_FALSE(cache.load(key2).has_value());
+  EXPECT_EQ(mesh, *cache.load(key3));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
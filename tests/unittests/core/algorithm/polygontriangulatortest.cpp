@@ -0,0 +1,155 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/algorithm/polygontriangulator.h>
+
+#include <QtCore>
+
+#include <algorithm>
+#include <cmath>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PolygonTriangulatorTest : public ::testing::Test {
+protected:
+  static double trianglesArea(const ClipperLib::Path& triangles) noexcept {
+    double area = 0;
+    for (std::size_t i = 0; (i + 2) < triangles.size(); i += 3) {
+      ClipperLib::Path triangle(triangles.begin() + i,
+                                triangles.begin() + i + 3);
+      area += std::abs(ClipperLib::Area(triangle));
+    }
+    return area;
+  }
+
+  static double treeArea(const ClipperLib::PolyNode& node) noexcept {
+    double area = 0;
+    for (const ClipperLib::PolyNode* child : node.Childs) {
+      const double childArea = std::abs(ClipperLib::Area(child->Contour));
+      area += child->IsHole() ? -childArea : childArea;
+      area += treeArea(*child);
+    }
+    return area;
+  }
+
+  static ClipperLib::Path circle(ClipperLib::cInt x, ClipperLib::cInt y,
+                                 ClipperLib::cInt radius,
+                                 int count) noexcept {
+    ClipperLib::Path path;
+    for (int i = 0; i < count; ++i) {
+      const qreal angle = 2 * M_PI * i / count;
+      path.push_back(ClipperLib::IntPoint(
+          x + static_cast<ClipperLib::cInt>(radius * std::cos(angle)),
+          y + static_cast<ClipperLib::cInt>(radius * std::sin(angle))));
+    }
+    return path;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PolygonTriangulatorTest, testEmpty) {
+  EXPECT_EQ(0, PolygonTriangulator::triangulate({}, {}).size());
+  EXPECT_EQ(0, PolygonTriangulator::triangulate(ClipperLib::PolyTree()).size());
+}
+
+TEST_F(PolygonTriangulatorTest, testDegenerated) {
+  ClipperLib::Path line = {{0, 0}, {100, 0}, {200, 0}};
+  EXPECT_EQ(0, PolygonTriangulator::triangulate(line, {}).size());
+}
+
+TEST_F(PolygonTriangulatorTest, testSquare) {
+  ClipperLib::Path square = {{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+  ClipperLib::Path triangles = PolygonTriangulator::triangulate(square, {});
+  EXPECT_EQ(6, triangles.size());
+  EXPECT_EQ(10000, trianglesArea(triangles));
+
+  // Orientation must not matter.
+  std::reverse(square.begin(), square.end());
+  triangles = PolygonTriangulator::triangulate(square, {});
+  EXPECT_EQ(6, triangles.size());
+  EXPECT_EQ(10000, trianglesArea(triangles));
+}
+
+TEST_F(PolygonTriangulatorTest, testSquareWithHole) {
+  ClipperLib::Path square = {{0, 0}, {100, 0}, {100, 100}, {0, 100}};
+  ClipperLib::Path hole = {{25, 25}, {75, 25}, {75, 75}, {25, 75}};
+  ClipperLib::Path triangles =
+      PolygonTriangulator::triangulate(square, {hole});
+  EXPECT_EQ(24, triangles.size());
+  EXPECT_EQ(7500, trianglesArea(triangles));
+}
+
+TEST_F(PolygonTriangulatorTest, testManyHoles) {
+  ClipperLib::Path outline = circle(0, 0, 100000000, 500);
+  ClipperLib::Paths holes;
+  double expectedArea = std::abs(ClipperLib::Area(outline));
+  for (int x = -5; x <= 5; ++x) {
+    for (int y = -5; y <= 5; ++y) {
+      holes.push_back(circle(x * 12000000, y * 12000000, 5000000, 32));
+      expectedArea -= std::abs(ClipperLib::Area(holes.back()));
+    }
+  }
+  ClipperLib::Path triangles = PolygonTriangulator::triangulate(outline, holes);
+  EXPECT_NEAR(expectedArea, trianglesArea(triangles), expectedArea * 1e-12);
+}
+
+TEST_F(PolygonTriangulatorTest, testTree) {
+  // Random-looking overlapping circles result in a tree of outlines, holes
+  // and outlines within holes.
+  ClipperLib::Paths subject, clip;
+  for (int i = 0; i < 50; ++i) {
+    subject.push_back(circle((i * 7919) % 10000 * 1000,
+                             (i * 104729) % 10000 * 1000, 1500000, 64));
+    clip.push_back(circle((i * 1299709) % 10000 * 1000,
+                          (i * 15485863) % 10000 * 1000, 800000, 48));
+  }
+  ClipperLib::Clipper c;
+  c.AddPaths(subject, ClipperLib::ptSubject, true);
+  c.AddPaths(clip, ClipperLib::ptClip, true);
+  ClipperLib::PolyTree tree;
+  c.Execute(ClipperLib::ctXor, tree, ClipperLib::pftNonZero,
+            ClipperLib::pftNonZero);
+  const double expectedArea = treeArea(tree);
+  ASSERT_GT(expectedArea, 0);
+  ClipperLib::Path triangles = PolygonTriangulator::triangulate(tree);
+  EXPECT_NEAR(expectedArea, trianglesArea(triangles), expectedArea * 1e-12);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
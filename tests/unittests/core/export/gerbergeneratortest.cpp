@@ -234,6 +234,23 @@ TEST_F(GerberGeneratorTest, testDoesNotContainZeroSizeApertures) {
   ASSERT_GE(checkedCircles, 3);  // Sanity check if test works.
 }
 
+// Check if coordinates are formatted correctly, including negative numbers and
+// numbers exceeding the 32-bit range.
+TEST_F(GerberGeneratorTest, testCoordinateFormatting) {
+  GerberGenerator gen(
+      QDateTime(QDate(2000, 2, 1), QTime(1, 2, 3, 4), Qt::OffsetFromUTC, 3600),
+      "Project Name", Uuid::fromString("bdf7bea5-b88e-41b2-be85-c1604e8ddfca"),
+      "rev-1.0");
+  gen.drawLine(Point(-123456789, 0), Point(Length(4294967296LL), Length(-1)),
+               UnsignedLength(100000), std::nullopt, std::nullopt, QString());
+  gen.generate();
+  const QString s = gen.toStr();
+  EXPECT_TRUE(s.contains("\nD10*\n")) << qPrintable(s);
+  EXPECT_TRUE(s.contains("\nX-123456789Y0D02*\nX4294967296Y-1D01*\n"))
+      << qPrintable(s);
+  EXPECT_EQ(s.toUtf8(), gen.toByteArray());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
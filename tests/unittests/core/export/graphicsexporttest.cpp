@@ -199,6 +199,42 @@ TEST_F(GraphicsExportTest, testExportMultipleImages) {
   EXPECT_EQ("600x300", str(getImageSize(getFilePath("out3.png"))));
 }
 
+TEST_F(GraphicsExportTest, testExportManyImages) {
+  // Many pages are rendered in parallel, but the result must still be in the
+  // original page order.
+  std::shared_ptr<GraphicsPagePainter> page =
+      std::make_shared<GraphicsPagePainterMock>(
+          Length(10000000), Length(20000000), Length(508000000),
+          Length(254000000));
+  GraphicsExport::Pages pages;
+  QVector<FilePath> expectedFiles;
+  for (int i = 1; i <= 60; ++i) {
+    std::shared_ptr<GraphicsExportSettings> settings =
+        std::make_shared<GraphicsExportSettings>();
+    settings->setPixmapDpi(i);
+    settings->setScale(std::nullopt);
+    settings->setMarginLeft(UnsignedLength(0));
+    settings->setMarginTop(UnsignedLength(0));
+    settings->setMarginRight(UnsignedLength(0));
+    settings->setMarginBottom(UnsignedLength(0));
+    pages.append(std::make_pair(page, settings));
+    expectedFiles.append(getFilePath(QString("out%1.png").arg(i)));
+  }
+
+  GraphicsExport e;
+  prepare(e);
+
+  e.startExport(pages, getFilePath("out.png"));
+  const GraphicsExport::Result result = e.waitForFinished();
+  EXPECT_EQ("", result.errorMsg.toStdString());
+  EXPECT_EQ(str(expectedFiles), str(result.writtenFiles));
+  EXPECT_EQ(str(expectedFiles), str(mSavedFiles));
+  for (int i = 1; i <= expectedFiles.count(); ++i) {
+    EXPECT_EQ(str(QSize(20 * i, 10 * i)),
+              str(getImageSize(expectedFiles.at(i - 1))));
+  }
+}
+
 TEST_F(GraphicsExportTest, testExportSvgWithAutoScaling) {
   std::shared_ptr<GraphicsPagePainter> page =
       std::make_shared<GraphicsPagePainterMock>(
@@ -0,0 +1,149 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/application.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/font/strokefont.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class StrokeFontTest : public ::testing::Test {
+protected:
+  struct Input {
+    QString text;
+    PositiveLength height;
+    Alignment align;
+  };
+
+  struct Output {
+    QVector<Path> paths;
+    Point bottomLeft;
+    Point topRight;
+
+    bool operator==(const Output& rhs) const noexcept {
+      return (paths == rhs.paths) && (bottomLeft == rhs.bottomLeft) &&
+          (topRight == rhs.topRight);
+    }
+  };
+
+  static std::unique_ptr<StrokeFont> createFont() {
+    const FilePath fp = Application::getResourcesDir().getPathTo(
+        "fontobene/" % Application::getDefaultStrokeFontName());
+    return std::make_unique<StrokeFont>(fp, FileUtils::readFile(fp));
+  }
+
+  static Output stroke(const StrokeFont& font, const Input& in) noexcept {
+    Output out;
+    out.paths = font.stroke(in.text, in.height, Length(0), Length(0),
+                            in.align, out.bottomLeft, out.topRight);
+    return out;
+  }
+
+  static QVector<Input> createInputs() noexcept {
+    const QStringList texts = {"R1", "C42", "Hello\nWorld", "R1", "", "äöü"};
+    const QList<Alignment> aligns = {
+        Alignment(HAlign::left(), VAlign::bottom()),
+        Alignment(HAlign::center(), VAlign::center()),
+    };
+    QVector<Input> inputs;
+    for (int i = 0; i < 3; ++i) {
+      for (const QString& text : texts) {
+        for (const Alignment& align : aligns) {
+          for (const PositiveLength& height :
+               {PositiveLength(1000000), PositiveLength(1500000)}) {
+            inputs.append(Input{text, height, align});
+          }
+        }
+      }
+    }
+    return inputs;
+  }
+
+  // Reference output without any cache hits: a new font for every input.
+  static QVector<Output> strokeUncached(const QVector<Input>& inputs) {
+    QVector<Output> outputs;
+    for (const Input& in : inputs) {
+      outputs.append(stroke(*createFont(), in));
+    }
+    return outputs;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(StrokeFontTest, testCachedOutputMatchesUncached) {
+  const QVector<Input> inputs = createInputs();
+  const QVector<Output> expected = strokeUncached(inputs);
+
+  std::unique_ptr<StrokeFont> font = createFont();
+  for (int i = 0; i < inputs.count(); ++i) {
+    EXPECT_EQ(expected.at(i), stroke(*font, inputs.at(i))) << i;
+  }
+}
+
+TEST_F(StrokeFontTest, testParallelOutputMatchesSerial) {
+  const QVector<Input> inputs = createInputs();
+  const QVector<Output> expected = strokeUncached(inputs);
+
+  std::unique_ptr<StrokeFont> font = createFont();
+  const QList<Output> actual = QtConcurrent::blockingMapped<QList<Output>>(
+      inputs, [&font](const Input& in) { return stroke(*font, in); });
+  ASSERT_EQ(expected.count(), actual.count());
+  for (int i = 0; i < inputs.count(); ++i) {
+    EXPECT_EQ(expected.at(i), actual.at(i)) << i;
+  }
+}
+
+TEST_F(StrokeFontTest, testGlyphCacheKeyedByHeight) {
+  std::unique_ptr<StrokeFont> font = createFont();
+  Length spacing1, spacing2;
+  const QVector<Path> small =
+      font->strokeGlyph(QChar('A'), PositiveLength(1000000), spacing1);
+  const QVector<Path> big =
+      font->strokeGlyph(QChar('A'), PositiveLength(2000000), spacing2);
+  EXPECT_NE(small, big);
+  EXPECT_NEAR(spacing1.toNm() * 2, spacing2.toNm(), 2);
+  EXPECT_EQ(small,
+            createFont()->strokeGlyph(QChar('A'), PositiveLength(1000000),
+                                      spacing1));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,179 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/geometry/polygon.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/library/pkg/packagecheck.h>
+#include <librepcb/core/library/pkg/packagecheckmessages.h>
+#include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/toolbox.h>
+#include <librepcb/core/utils/transform.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class PackageCheckTest : public ::testing::Test {
+protected:
+  static std::shared_ptr<FootprintPad> createPad(
+      const Point& pos, const Length& size, FootprintPad::ComponentSide side) {
+    return std::make_shared<FootprintPad>(
+        Uuid::createRandom(), std::nullopt, pos, Angle::deg0(),
+        FootprintPad::Shape::RoundedRect, PositiveLength(size),
+        PositiveLength(size), UnsignedLimitedRatio(Ratio::fromPercent(0)),
+        Path(), MaskConfig::automatic(), MaskConfig::off(), UnsignedLength(0),
+        side, FootprintPad::Function::StandardPad, PadHoleList());
+  }
+
+  static std::shared_ptr<Polygon> createLegend(const Layer& layer,
+                                               const Point& p1,
+                                               const Point& p2, bool fill,
+                                               const Length& lineWidth) {
+    return std::make_shared<Polygon>(Uuid::createRandom(), layer,
+                                     UnsignedLength(lineWidth), fill, false,
+                                     Path::rect(p1, p2));
+  }
+
+  /**
+   * @brief Reference implementation of the legend clearance check
+   *
+   * Checks each pad against the merged legend of the whole footprint.
+   */
+  static QSet<Uuid> findPadsOverlappingLegend(const Footprint& footprint) {
+    QPainterPath topLegend;
+    QPainterPath botLegend;
+    for (const Polygon& polygon : footprint.getPolygons()) {
+      QPen pen(Qt::NoPen);
+      if (polygon.getLineWidth() > 0) {
+        pen.setStyle(Qt::SolidLine);
+        pen.setWidthF(polygon.getLineWidth()->toPx());
+      }
+      QBrush brush(Qt::NoBrush);
+      if (polygon.isFilled() && polygon.getPath().isClosed()) {
+        brush.setStyle(Qt::SolidPattern);
+      }
+      const QPainterPath area = Toolbox::shapeFromPath(
+          polygon.getPath().toQPainterPathPx(), pen, brush);
+      if (polygon.getLayer() == Layer::topLegend()) {
+        topLegend.addPath(area);
+      } else if (polygon.getLayer() == Layer::botLegend()) {
+        botLegend.addPath(area);
+      }
+    }
+    QSet<Uuid> pads;
+    for (const FootprintPad& pad : footprint.getPads()) {
+      const Transform transform(pad.getPosition(), pad.getRotation());
+      const QPainterPath stopMask = transform.mapPx(
+          pad.getGeometry()
+              .withOffset(Length(150000) - Length(10))
+              .toFilledQPainterPathPx());
+      if ((pad.isOnLayer(Layer::topCopper()) &&
+           stopMask.intersects(topLegend)) ||
+          (pad.isOnLayer(Layer::botCopper()) &&
+           stopMask.intersects(botLegend))) {
+        pads.insert(pad.getUuid());
+      }
+    }
+    return pads;
+  }
+
+  static QSet<Uuid> getPadsOfMessages(const RuleCheckMessageList& msgs) {
+    QSet<Uuid> pads;
+    for (const auto& msg : msgs) {
+      if (auto m = std::dynamic_pointer_cast<const MsgPadOverlapsWithLegend>(
+              msg)) {
+        pads.insert(m->getPad()->getUuid());
+      }
+    }
+    return pads;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(PackageCheckTest, testPadsClearanceToLegendMatchesMergedLegend) {
+  Package pkg(Uuid::createRandom(), Version::fromString("0.1"), "test",
+              ElementName("Test"), "", "", Package::AssemblyType::Smt);
+  auto footprint = std::make_shared<Footprint>(Uuid::createRandom(),
+                                               ElementName("default"), "");
+  pkg.getFootprints().append(footprint);
+  const auto top = FootprintPad::ComponentSide::Top;
+  const auto bot = FootprintPad::ComponentSide::Bottom;
+
+  // Two overlapping filled legend areas on top. Since the merged legend uses
+  // the odd-even fill rule, their intersection does not count as legend.
+  footprint->getPolygons().append(createLegend(Layer::topLegend(), Point(0, 0),
+                                              Point(4000000, 4000000), true,
+                                              Length(0)));
+  footprint->getPolygons().append(
+      createLegend(Layer::topLegend(), Point(2000000, 0),
+                   Point(6000000, 4000000), true, Length(0)));
+  // A legend outline on top and a filled legend area on bottom.
+  footprint->getPolygons().append(
+      createLegend(Layer::topLegend(), Point(10000000, 0),
+                   Point(14000000, 4000000), false, Length(200000)));
+  footprint->getPolygons().append(
+      createLegend(Layer::botLegend(), Point(20000000, 0),
+                   Point(24000000, 4000000), true, Length(0)));
+
+  const Length size(200000);
+  auto padInOverlap = createPad(Point(3000000, 2000000), size, top);
+  auto padInFirst = createPad(Point(1000000, 2000000), size, top);
+  auto padAtEdge = createPad(Point(6100000, 2000000), size, top);
+  auto padInOutline = createPad(Point(12000000, 2000000), size, top);
+  auto padOnOutline = createPad(Point(10000000, 2000000), size, top);
+  auto padOnBot = createPad(Point(22000000, 2000000), size, bot);
+  auto padOnTop = createPad(Point(22000000, 1000000), size, top);
+  auto padFarAway = createPad(Point(50000000, 50000000), size, top);
+  for (auto pad : {padInOverlap, padInFirst, padAtEdge, padInOutline,
+                   padOnOutline, padOnBot, padOnTop, padFarAway}) {
+    footprint->getPads().append(pad);
+  }
+
+  const QSet<Uuid> expected = findPadsOverlappingLegend(*footprint);
+  EXPECT_EQ(
+      QSet<Uuid>({padInFirst->getUuid(), padAtEdge->getUuid(),
+                  padOnOutline->getUuid(), padOnBot->getUuid()}),
+      expected);
+
+  PackageCheck check(pkg);
+  EXPECT_EQ(expected, getPadsOfMessages(check.runChecks()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
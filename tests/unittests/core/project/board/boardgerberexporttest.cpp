@@ -30,6 +30,7 @@
 #include <librepcb/core/project/circuit/circuit.h>
 #include <librepcb/core/project/project.h>
 #include <librepcb/core/project/projectloader.h>
+#include <librepcb/core/utils/scopeguard.h>
 
 #include <QtCore>
 
@@ -125,6 +126,104 @@ TEST(BoardGerberExportTest, test) {
   }
 }
 
+TEST(BoardGerberExportTest, testParallelOutputMatchesSerial) {
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());
+  Board* board = project->getBoards().first();
+  BoardPlaneFragmentsBuilder builder;
+  builder.runAndApply(*board);  // can throw
+
+  // Use the same exporter for both runs to get identical creation dates.
+  BoardGerberExport grbExport(*board);
+  const FilePath outDir = FilePath::getRandomTempPath();
+  auto cleanup =
+      scopeGuard([&]() { QDir(outDir.toStr()).removeRecursively(); });
+  auto exportTo = [&](const QString& subDir) {
+    BoardFabricationOutputSettings config =
+        board->getFabricationOutputSettings();
+    config.setOutputBasePath(outDir.getPathTo(subDir).toStr() %
+                             "/{{PROJECT}}");
+    grbExport.exportPcbLayers(config);
+    QMap<QString, QByteArray> files;
+    foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+      files.insert(fp.getFilename(), FileUtils::readFile(fp));
+    }
+    return std::make_pair(grbExport.getWrittenFiles().count(), files);
+  };
+
+  // Generate the files serially by limiting the global thread pool to a
+  // single thread, then generate them again with the default thread count.
+  QThreadPool* pool = QThreadPool::globalInstance();
+  const int maxThreadCount = pool->maxThreadCount();
+  auto restoreThreadCount =
+      scopeGuard([&]() { pool->setMaxThreadCount(maxThreadCount); });
+  pool->setMaxThreadCount(1);
+  const auto serial = exportTo("serial");
+  pool->setMaxThreadCount(std::max(QThread::idealThreadCount(), 4));
+  const auto parallel = exportTo("parallel");
+
+  EXPECT_GT(serial.first, 0);
+  EXPECT_EQ(serial.first, parallel.first);
+  EXPECT_EQ(serial.second.keys(), parallel.second.keys());
+  foreach (const QString& fileName, serial.second.keys()) {
+    EXPECT_EQ(serial.second.value(fileName).toStdString(),
+              parallel.second.value(fileName).toStdString())
+        << qPrintable(fileName);
+  }
+}
+
+TEST(BoardGerberExportTest, testSnapshotOutputMatchesDirectExport) {
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  ProjectLoader loader;
+  std::unique_ptr<Project> project =
+      loader.open(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename());
+  Board* board = project->getBoards().first();
+  BoardPlaneFragmentsBuilder builder;
+  builder.runAndApply(*board);  // can throw
+
+  // Use the same exporter for both runs to get identical creation dates.
+  BoardGerberExport grbExport(*board);
+  const FilePath outDir = FilePath::getRandomTempPath();
+  auto cleanup =
+      scopeGuard([&]() { QDir(outDir.toStr()).removeRecursively(); });
+  auto exportTo = [&](const QString& subDir) {
+    BoardFabricationOutputSettings config =
+        board->getFabricationOutputSettings();
+    config.setOutputBasePath(outDir.getPathTo(subDir).toStr() %
+                             "/{{PROJECT}}");
+    grbExport.exportPcbLayers(config);
+    QMap<QString, QByteArray> files;
+    foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+      files.insert(fp.getFilename(), FileUtils::readFile(fp));
+    }
+    return files;
+  };
+
+  // Export once with a temporary snapshot, then again with a snapshot
+  // created by another exporter, as shared between output jobs.
+  const auto direct = exportTo("direct");
+  grbExport.setSnapshot(BoardGerberExport(*board).createSnapshot());
+  const auto shared = exportTo("shared");
+
+  EXPECT_FALSE(direct.isEmpty());
+  EXPECT_EQ(direct.keys(), shared.keys());
+  foreach (const QString& fileName, direct.keys()) {
+    EXPECT_EQ(direct.value(fileName).toStdString(),
+              shared.value(fileName).toStdString())
+        << qPrintable(fileName);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,231 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/project/erc/electricalrulecheck.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ElectricalRuleCheckTest : public ::testing::Test {
+protected:
+  using Data = ElectricalRuleCheckData;
+
+  const Uuid mSchematic = Uuid::createRandom();
+  const Uuid mNetGnd = Uuid::createRandom();
+  const Uuid mNetVcc = Uuid::createRandom();
+  const Uuid mComponent = Uuid::createRandom();
+  const Uuid mSignal1 = Uuid::createRandom();
+  const Uuid mSignal2 = Uuid::createRandom();
+  const Uuid mSymbol = Uuid::createRandom();
+  const Uuid mSegment = Uuid::createRandom();
+
+  /**
+   * @brief Create an unresolved snapshot with an open net (VCC) and a
+   *        connected symbol pin without wire (R1:2)
+   */
+  Data createData() const {
+    Data data;
+    data.netSignals.insert(mNetGnd, Data::NetSignal{mNetGnd, "GND", 2});
+    data.netSignals.insert(mNetVcc, Data::NetSignal{mNetVcc, "VCC", 1});
+    data.components.insert(
+        mComponent,
+        Data::Component{
+            mComponent,
+            "R1",
+            {
+                Data::ComponentSignal{mSignal1, "A", false, true, "GND",
+                                      std::nullopt},
+                Data::ComponentSignal{mSignal2, "B", false, true, "VCC",
+                                      std::nullopt},
+            },
+            {Data::Gate{Uuid::createRandom(), "", true, true}},
+        });
+    Data::Schematic schematic{mSchematic, {}, {}};
+    schematic.symbols.insert(
+        mSymbol,
+        Data::Symbol{
+            mSymbol,
+            mSchematic,
+            mComponent,
+            "",
+            {
+                Data::Pin{Uuid::createRandom(), mSignal1,
+                          CmpSigPinDisplayType::componentSignal(), "1", true,
+                          QString(), false},
+                Data::Pin{Uuid::createRandom(), mSignal2,
+                          CmpSigPinDisplayType::pinName(), "2", false,
+                          QString(), false},
+            },
+            QString(),
+        });
+    schematic.netSegments.insert(
+        mSegment,
+        Data::NetSegment{mSegment,
+                         mSchematic,
+                         mNetVcc,
+                         false,
+                         true,
+                         {Data::NetPoint{Uuid::createRandom(), true}},
+                         QString()});
+    data.schematics.append(schematic);
+    return data;
+  }
+
+  static RuleCheckMessageList run(ElectricalRuleCheck& erc, const Data& data) {
+    erc.start(std::make_shared<Data>(data));
+    return erc.waitForFinished();
+  }
+
+  static std::shared_ptr<const RuleCheckMessage> find(
+      const RuleCheckMessageList& msgs, const QString& text) {
+    for (const auto& msg : msgs) {
+      if (msg->getMessage() == text) {
+        return msg;
+      }
+    }
+    return nullptr;
+  }
+
+  static QStringList str(const RuleCheckMessageList& msgs) {
+    QStringList list;
+    for (const auto& msg : msgs) {
+      list.append(msg->getMessage());
+    }
+    list.sort();
+    return list;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ElectricalRuleCheckTest, testNetModification) {
+  ElectricalRuleCheck erc;
+  Data data = createData();
+  const RuleCheckMessageList msgs1 = run(erc, data);
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R1:2'",
+                         "Less than two pins in net: 'VCC'"}),
+            str(msgs1));
+
+  // Connect the net -> the open net message disappears and the segment, which
+  // was not modified itself, is checked again for open wires.
+  data.netSignals.find(mNetVcc)->realComponentSignals = 2;
+  const RuleCheckMessageList msgs2 = run(erc, data);
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R1:2'",
+                         "Open wire in net: 'VCC'"}),
+            str(msgs2));
+
+  // Messages of unmodified items are reused.
+  EXPECT_EQ(find(msgs1, "Connected pin without wire: 'R1:2'"),
+            find(msgs2, "Connected pin without wire: 'R1:2'"));
+
+  // Rename the net -> the segment message follows the new name.
+  data.netSignals.find(mNetVcc)->name = "3V3";
+  const RuleCheckMessageList msgs3 = run(erc, data);
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R1:2'",
+                         "Open wire in net: '3V3'"}),
+            str(msgs3));
+
+  // Open the net again -> back to the initial messages.
+  data = createData();
+  const RuleCheckMessageList msgs4 = run(erc, data);
+  EXPECT_EQ(str(msgs1), str(msgs4));
+}
+
+TEST_F(ElectricalRuleCheckTest, testPinModification) {
+  ElectricalRuleCheck erc;
+  Data data = createData();
+  const RuleCheckMessageList msgs1 = run(erc, data);
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R1:2'",
+                         "Less than two pins in net: 'VCC'"}),
+            str(msgs1));
+
+  // Add a wire to the pin -> its message disappears.
+  data.schematics[0].symbols.find(mSymbol)->pins[1].hasWires = true;
+  const RuleCheckMessageList msgs2 = run(erc, data);
+  EXPECT_EQ(QStringList({"Less than two pins in net: 'VCC'"}), str(msgs2));
+  EXPECT_EQ(find(msgs1, "Less than two pins in net: 'VCC'"),
+            find(msgs2, "Less than two pins in net: 'VCC'"));
+
+  // Remove the wire -> the message appears again.
+  data.schematics[0].symbols.find(mSymbol)->pins[1].hasWires = false;
+  const RuleCheckMessageList msgs3 = run(erc, data);
+  EXPECT_EQ(str(msgs1), str(msgs3));
+  EXPECT_EQ(find(msgs1, "Less than two pins in net: 'VCC'"),
+            find(msgs3, "Less than two pins in net: 'VCC'"));
+}
+
+TEST_F(ElectricalRuleCheckTest, testCircuitModificationOfSchematicItems) {
+  ElectricalRuleCheck erc;
+  Data data = createData();
+  run(erc, data);
+
+  // Rename the component -> the unmodified symbol snapshot gets the new name.
+  data.components.find(mComponent)->name = "R2";
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R2:2'",
+                         "Less than two pins in net: 'VCC'"}),
+            str(run(erc, data)));
+
+  // Disconnect the component signal -> the pin is not connected anymore.
+  data.components.find(mComponent)->componentSignals[1].connected = false;
+  data.components.find(mComponent)->componentSignals[1].netName = QString();
+  EXPECT_EQ(QStringList({"Less than two pins in net: 'VCC'"}),
+            str(run(erc, data)));
+}
+
+TEST_F(ElectricalRuleCheckTest, testStartDoesNotWaitForPreviousRun) {
+  ElectricalRuleCheck erc;
+  int signalCount = 0;
+  QObject::connect(&erc, &ElectricalRuleCheck::finished,
+                   [&signalCount]() { ++signalCount; });
+
+  // Start many runs without waiting, only the latest data is relevant.
+  Data data = createData();
+  for (int i = 0; i < 10; ++i) {
+    data.netSignals.find(mNetVcc)->name = QString("VCC%1").arg(i);
+    erc.start(std::make_shared<Data>(data));
+  }
+  const RuleCheckMessageList msgs = erc.waitForFinished();
+  EXPECT_EQ(QStringList({"Connected pin without wire: 'R1:2'",
+                         "Less than two pins in net: 'VCC9'"}),
+            str(msgs));
+  EXPECT_GE(signalCount, 1);
+  EXPECT_LE(signalCount, 10);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,201 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/job/archiveoutputjob.h>
+#include <librepcb/core/job/copyoutputjob.h>
+#include <librepcb/core/job/projectjsonoutputjob.h>
+#include <librepcb/core/project/outputjobrunner.h>
+#include <librepcb/core/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class OutputJobRunnerTest : public ::testing::Test {
+protected:
+  QList<FilePath> mTmpDirs;
+
+  virtual void TearDown() override {
+    foreach (const FilePath& dir, mTmpDirs) {
+      QDir(dir.toStr()).removeRecursively();
+    }
+  }
+
+  std::unique_ptr<Project> createProject() {
+    const FilePath dir = FilePath::getRandomTempPath();
+    mTmpDirs.append(dir);
+    std::unique_ptr<Project> project = Project::create(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRW(dir))),
+        "project.lpp");
+    project->getDirectory().write("input.txt", "Hello {{PROJECT}}!");
+    return project;
+  }
+
+  static std::shared_ptr<ProjectJsonOutputJob> createJsonJob(
+      const QString& output) {
+    auto job = std::make_shared<ProjectJsonOutputJob>();
+    job->setOutputPath(output);
+    return job;
+  }
+
+  static std::shared_ptr<CopyOutputJob> createCopyJob(const QString& input,
+                                                      const QString& output) {
+    auto job = std::make_shared<CopyOutputJob>();
+    job->setInputPath(input);
+    job->setOutputPath(output);
+    return job;
+  }
+
+  static std::shared_ptr<ArchiveOutputJob> createArchiveJob(
+      const QMap<Uuid, QString>& input, const QString& output) {
+    auto job = std::make_shared<ArchiveOutputJob>();
+    job->setInputJobs(input);
+    job->setOutputPath(output);
+    return job;
+  }
+
+  static QStringList getOutputFiles(const Project& project) {
+    const FilePath dir = project.getCurrentOutputDir();
+    QStringList files;
+    foreach (const FilePath& fp,
+             FileUtils::getFilesInDirectory(dir, {}, true, true)) {
+      files.append(fp.toRelative(dir));
+    }
+    files.sort();
+    return files;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(OutputJobRunnerTest, testDependentJobsWaitForProducers) {
+  std::unique_ptr<Project> project = createProject();
+  const QString outDir =
+      project->getCurrentOutputDir().toRelative(project->getPath());
+
+  // The copy job reads the output of the JSON job, and the archive job
+  // contains the output of both jobs, thus they must be run sequentially.
+  auto json = createJsonJob("project.json");
+  auto copy = createCopyJob(outDir % "/project.json", "copy.json");
+  auto archive = createArchiveJob({{json->getUuid(), "json"},
+                                   {copy->getUuid(), "copy"}},
+                                  "archive.zip");
+  OutputJobRunner runner(*project);
+  runner.run({json, copy, archive});
+
+  const FilePath dir = project->getCurrentOutputDir();
+  const QByteArray content = FileUtils::readFile(dir.getPathTo("project.json"));
+  EXPECT_FALSE(content.isEmpty());
+  EXPECT_EQ(content, FileUtils::readFile(dir.getPathTo("copy.json")));
+
+  mTmpDirs.append(FilePath::getRandomTempPath());
+  TransactionalFileSystem fs(mTmpDirs.last(), true);
+  fs.loadFromZip(dir.getPathTo("archive.zip"));
+  EXPECT_EQ(content, fs.read("json/project.json"));
+  EXPECT_EQ(content, fs.read("copy/copy.json"));
+}
+
+TEST_F(OutputJobRunnerTest, testFailedJobSkipsOnlyDependents) {
+  std::unique_ptr<Project> project = createProject();
+  auto json1 = createJsonJob("1.json");
+  auto copy = createCopyJob("missing.txt", "copy.txt");
+  auto archive = createArchiveJob({{copy->getUuid(), "copy"}}, "archive.zip");
+  auto json2 = createJsonJob("2.json");
+  OutputJobRunner runner(*project);
+  QList<std::shared_ptr<const OutputJob>> startedJobs;
+  QObject::connect(&runner, &OutputJobRunner::jobStarted,
+                   [&](std::shared_ptr<const OutputJob> job) {
+                     startedJobs.append(job);
+                   });
+  EXPECT_THROW(runner.run({json1, copy, archive, json2}), Exception);
+
+  const QList<std::shared_ptr<const OutputJob>> expectedJobs = {json1, copy,
+                                                                json2};
+  EXPECT_EQ(expectedJobs, startedJobs);
+  EXPECT_EQ(QStringList({"1.json", "2.json"}), getOutputFiles(*project));
+}
+
+TEST_F(OutputJobRunnerTest, testRemoveObsoleteFilesMatchesSerialRun) {
+  std::unique_ptr<Project> parallelProject = createProject();
+  std::unique_ptr<Project> serialProject = createProject();
+  auto json1 = createJsonJob("1.json");
+  auto copy = createCopyJob("input.txt", "copy.txt");
+  auto json2 = createJsonJob("2.json");
+  const QVector<std::shared_ptr<OutputJob>> jobs = {json1, copy, json2};
+
+  auto run = [&](Project& project, bool parallel) {
+    OutputJobRunner runner(project);
+    QStringList removedFiles;
+    QObject::connect(&runner, &OutputJobRunner::aboutToRemoveFile,
+                     [&](const FilePath& fp) {
+                       removedFiles.append(
+                           fp.toRelative(runner.getOutputDirectory()));
+                     });
+    if (parallel) {
+      runner.run(jobs);
+    } else {
+      foreach (const auto& job, jobs) {
+        runner.run({job});
+      }
+    }
+    removedFiles.sort();
+    return removedFiles;
+  };
+
+  // First run creates all files.
+  EXPECT_EQ(QStringList(), run(*parallelProject, true));
+  EXPECT_EQ(QStringList(), run(*serialProject, false));
+  EXPECT_EQ(getOutputFiles(*serialProject), getOutputFiles(*parallelProject));
+
+  // Second run with modified output paths removes the old files.
+  json1->setOutputPath("sub/1.json");
+  copy->setOutputPath("copy2.txt");
+  const QStringList removedFiles = run(*serialProject, false);
+  EXPECT_EQ(QStringList({"1.json", "copy.txt"}), removedFiles);
+  EXPECT_EQ(removedFiles, run(*parallelProject, true));
+  EXPECT_EQ(QStringList({"2.json", "copy2.txt", "sub/1.json"}),
+            getOutputFiles(*parallelProject));
+  EXPECT_EQ(getOutputFiles(*serialProject), getOutputFiles(*parallelProject));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,125 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/rulecheck/rulecheckmessage.h>
+#include <librepcb/core/serialization/sexpression.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class RuleCheckMessageTest : public ::testing::Test {
+protected:
+  static std::unique_ptr<SExpression> parse(const QByteArray& content) {
+    return SExpression::parse(content, FilePath());
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(RuleCheckMessageTest, testEqualApprovalsHaveEqualKeys) {
+  const QByteArray content =
+      "(approval missing_connection\n"
+      " (net 3a6c5d1e-8f0b-4f8e-9b3a-2d7c1e4f5a6b)\n"
+      " (from \"C1\" (pad 1)) (to \"C2\" (pad 2))\n"
+      ")";
+  std::unique_ptr<SExpression> a = parse(content);
+  std::unique_ptr<SExpression> b = parse(content);
+  std::unique_ptr<SExpression> c =
+      SExpression::parse(content, FilePath("/some/other/file.lp"));
+  ASSERT_EQ(*a, *b);
+  ASSERT_EQ(*a, *c);
+  EXPECT_EQ(RuleCheckMessage::calcApprovalKey(*a),
+            RuleCheckMessage::calcApprovalKey(*b));
+  EXPECT_EQ(RuleCheckMessage::calcApprovalKey(*a),
+            RuleCheckMessage::calcApprovalKey(*c));
+}
+
+TEST_F(RuleCheckMessageTest, testDifferentApprovalsHaveDifferentKeys) {
+  // Includes trees which differ only in their structure or node types, and
+  // trees whose concatenated values are identical.
+  const QList<QByteArray> contents = {
+      "(approval foo)",
+      "(approval bar)",
+      "(approval \"foo\")",
+      "(approval foo bar)",
+      "(approval foobar)",
+      "(approval fo obar)",
+      "(approvalfoo)",
+      "(approval (foo))",
+      "(approval (foo bar))",
+      "(approval (foo) bar)",
+      "(approval (foo (bar)))",
+      "(approval ((foo) bar))",
+      "(approval foo (net \"a\"))",
+      "(approval foo (net \"b\"))",
+      "(approval foo (net \"\"))",
+      "(approval foo (net \"a\") (net \"b\"))",
+      "(approval foo (net \"b\") (net \"a\"))",
+      "(approval foo (net \"a b\"))",
+      "(approval foo\n (net \"a\")\n)",
+  };
+  QList<std::unique_ptr<SExpression>> nodes;
+  for (const QByteArray& content : contents) {
+    nodes.append(parse(content));
+  }
+  for (int i = 0; i < nodes.count(); ++i) {
+    for (int k = i + 1; k < nodes.count(); ++k) {
+      ASSERT_NE(*nodes.at(i), *nodes.at(k))
+          << contents.at(i).toStdString() << " / "
+          << contents.at(k).toStdString();
+      EXPECT_NE(RuleCheckMessage::calcApprovalKey(*nodes.at(i)),
+                RuleCheckMessage::calcApprovalKey(*nodes.at(k)))
+          << contents.at(i).toStdString() << " / "
+          << contents.at(k).toStdString();
+    }
+  }
+}
+
+TEST_F(RuleCheckMessageTest, testCalcApprovalKeys) {
+  std::unique_ptr<SExpression> a = parse("(approval foo)");
+  std::unique_ptr<SExpression> b = parse("(approval bar)");
+  const QSet<RuleCheckMessage::ApprovalKey> keys =
+      RuleCheckMessage::calcApprovalKeys({*a, *b, *parse("(approval foo)")});
+  EXPECT_EQ(QSet<RuleCheckMessage::ApprovalKey>(
+                {RuleCheckMessage::calcApprovalKey(*a),
+                 RuleCheckMessage::calcApprovalKey(*b)}),
+            keys);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -379,6 +379,65 @@ TEST_F(SerializableObjectListTest, testOperatorMove) {
   EXPECT_EQ(mMocks[1], l2[1]);
 }
 
+TEST_F(SerializableObjectListTest, testIndexedLookupInBigList) {
+  const int size = List::sIndexThreshold * 3;
+  QList<std::shared_ptr<Mock>> mocks;
+  List l;
+  for (int i = 0; i < size; ++i) {
+    mocks.append(
+        std::make_shared<Mock>(Uuid::createRandom(), QString::number(i)));
+    EXPECT_FALSE(l.contains(mocks.last()->mUuid));
+    l.append(mocks.last());
+  }
+  for (int i = 0; i < size; ++i) {
+    EXPECT_EQ(i, l.indexOf(mocks[i].get()));
+    EXPECT_EQ(i, l.indexOf(mocks[i]->mUuid));
+    EXPECT_EQ(i, l.indexOf(QString::number(i)));
+  }
+  EXPECT_EQ(-1, l.indexOf(Uuid::createRandom()));
+  EXPECT_EQ(-1, l.indexOf(QString("foo")));
+
+  // Insert.
+  l.insert(0, mMocks[0]);
+  EXPECT_EQ(0, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(1, l.indexOf(mocks[0]->mUuid));
+  EXPECT_EQ(size, l.indexOf(QString::number(size - 1)));
+
+  // Remove.
+  l.remove(mMocks[0].get());
+  EXPECT_EQ(-1, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(0, l.indexOf(mocks[0].get()));
+  EXPECT_EQ(size - 1, l.indexOf(mocks[size - 1]->mUuid));
+
+  // Swap.
+  l.swap(0, size - 1);
+  EXPECT_EQ(size - 1, l.indexOf(mocks[0]->mUuid));
+  EXPECT_EQ(0, l.indexOf(QString::number(size - 1)));
+
+  // Edit.
+  mocks[5]->mName = "foo";
+  mocks[5]->onEdited.notify();
+  EXPECT_EQ(-1, l.indexOf(QString::number(5)));
+  EXPECT_EQ(5, l.indexOf(QString("foo")));
+
+  // Edit without changing keys.
+  mocks[6]->onEdited.notify();
+  EXPECT_EQ(6, l.indexOf(QString::number(6)));
+  EXPECT_EQ(6, l.indexOf(mocks[6]->mUuid));
+
+  // Rename to a name which already exists at a lower index.
+  mocks[7]->mName = "foo";
+  mocks[7]->onEdited.notify();
+  EXPECT_EQ(5, l.indexOf(QString("foo")));
+  EXPECT_EQ(-1, l.indexOf(QString::number(7)));
+
+  // Rename the first occurrence, the duplicate must be found then.
+  mocks[5]->mName = "bar";
+  mocks[5]->onEdited.notify();
+  EXPECT_EQ(7, l.indexOf(QString("foo")));
+  EXPECT_EQ(5, l.indexOf(QString("bar")));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
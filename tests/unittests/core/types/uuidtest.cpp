@@ -154,6 +154,23 @@ TEST(UuidTest, testCreateRandom) {
   }
 }
 
+TEST(UuidTest, testRandomRoundTripAndOrdering) {
+  QList<Uuid> uuids;
+  for (int i = 0; i < 1000; i++) {
+    const Uuid uuid = Uuid::createRandom();
+    const Uuid copy = Uuid::fromString(uuid.toStr());
+    EXPECT_EQ(uuid, copy);
+    EXPECT_EQ(qHash(uuid), qHash(copy));
+    uuids.append(uuid);
+  }
+  for (int i = 1; i < uuids.count(); i++) {
+    const Uuid& a = uuids.at(i - 1);
+    const Uuid& b = uuids.at(i);
+    EXPECT_EQ(a.toStr() < b.toStr(), a < b);
+    EXPECT_EQ(a.toStr() > b.toStr(), a > b);
+  }
+}
+
 TEST_P(UuidTest, testIsValid) {
   const UuidTestData& data = GetParam();
   EXPECT_EQ(data.valid, Uuid::isValid(data.uuid));
@@ -24,6 +24,11 @@
 #include <gtest/gtest.h>
 #include <librepcb/core/utils/clipperhelpers.h>
 
+#include <QtCore>
+
+#include <iostream>
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -34,7 +39,81 @@ namespace tests {
  *  Test Class
  ******************************************************************************/
 
-class ClipperHelpersTest : public ::testing::Test {};
+class ClipperHelpersTest : public ::testing::Test {
+protected:
+  static qreal calcArea(const ClipperLib::Paths& paths) noexcept {
+    qreal area = 0;
+    for (const ClipperLib::Path& path : paths) {
+      area += ClipperLib::Area(path);
+    }
+    return area;
+  }
+
+  /**
+   * @brief Create the copper of a synthetic board layer
+   *
+   * The layer consists of a grid of pads connected by traces, plus some
+   * round pads in between.
+   */
+  static QVector<ClipperLib::Paths> createCopperLayer() {
+    const PositiveLength maxArcTolerance(5000);
+    const Length pitch(2540000);
+    QVector<ClipperLib::Paths> areas;
+    for (int x = 0; x < 80; ++x) {
+      for (int y = 0; y < 80; ++y) {
+        const Point pos(pitch * x, pitch * y);
+        areas.append({ClipperHelpers::convert(
+            Path::centeredRect(PositiveLength(1600000),
+                               PositiveLength(1600000))
+                .translated(pos),
+            maxArcTolerance)});
+        if ((x + y) % 3 == 0) {
+          areas.append({ClipperHelpers::convert(
+              Path::obround(pos, pos + Point(pitch, pitch),
+                            PositiveLength(250000)),
+              maxArcTolerance)});
+        }
+        if (y % 4 == 0) {
+          areas.append({ClipperHelpers::convert(
+              Path::circle(PositiveLength(800000))
+                  .translated(pos + Point(pitch / 2, 0)),
+              maxArcTolerance)});
+        }
+      }
+    }
+    return areas;
+  }
+
+  /**
+   * @brief Reference implementation: Unite everything in a single sweep
+   */
+  static ClipperLib::Paths uniteSingleSweep(
+      const QVector<ClipperLib::Paths>& areas) {
+    ClipperLib::Paths result;
+    for (const ClipperLib::Paths& area : areas) {
+      ClipperLib::Paths normalized = area;
+      ClipperHelpers::unite(normalized, ClipperLib::pftNonZero);
+      result.insert(result.end(), normalized.begin(), normalized.end());
+    }
+    ClipperHelpers::unite(result, ClipperLib::pftNonZero);
+    return result;
+  }
+
+  /**
+   * @brief Measure the fastest of several runs of a function
+   */
+  template <typename Fun>
+  static qint64 measureNs(int runs, Fun fun) {
+    qint64 best = std::numeric_limits<qint64>::max();
+    for (int i = 0; i < runs; ++i) {
+      QElapsedTimer timer;
+      timer.start();
+      fun();
+      best = std::min(best, timer.nsecsElapsed());
+    }
+    return best;
+  }
+};
 
 /*******************************************************************************
  *  Test Methods
@@ -59,6 +138,70 @@ TEST_F(ClipperHelpersTest, testConvertPathWithApproximate) {
       outputStr.toStdString());
 }
 
+TEST_F(ClipperHelpersTest, testUniteBatchedEmpty) {
+  EXPECT_TRUE(ClipperHelpers::uniteBatched({}, ClipperLib::pftNonZero).empty());
+  EXPECT_EQ(0, ClipperHelpers::uniteBatchedToTree({}, ClipperLib::pftNonZero)
+                   ->Total());
+}
+
+TEST_F(ClipperHelpersTest, testUniteBatchedEvaluatesEachAreaOnItsOwn) {
+  // Two overlapping squares with opposite orientation. With a single non-zero
+  // sweep, the overlap would cancel out.
+  ClipperLib::Path square = ClipperHelpers::convert(
+      Path::centeredRect(PositiveLength(2000000), PositiveLength(2000000)),
+      PositiveLength(1000));
+  ClipperLib::Path reversed = ClipperHelpers::convert(
+      Path::centeredRect(PositiveLength(2000000), PositiveLength(2000000))
+          .translated(Point(1000000, 0)),
+      PositiveLength(1000));
+  std::reverse(reversed.begin(), reversed.end());
+  const ClipperLib::Paths result = ClipperHelpers::uniteBatched(
+      {{square}, {reversed}}, ClipperLib::pftNonZero);
+  ASSERT_EQ(1, result.size());
+  EXPECT_EQ(6e12, std::abs(calcArea(result)));
+}
+
+TEST_F(ClipperHelpersTest, testUniteBatchedCopperLayer) {
+  const QVector<ClipperLib::Paths> areas = createCopperLayer();
+
+  const ClipperLib::Paths expected = uniteSingleSweep(areas);
+  const ClipperLib::Paths result =
+      ClipperHelpers::uniteBatched(areas, ClipperLib::pftNonZero);
+  EXPECT_EQ(expected.size(), result.size());
+  // The intermediate results may round intersection points differently.
+  EXPECT_NEAR(calcArea(expected), calcArea(result), 1e-6 * calcArea(expected));
+
+  std::unique_ptr<ClipperLib::PolyTree> tree =
+      ClipperHelpers::uniteBatchedToTree(areas, ClipperLib::pftNonZero);
+  EXPECT_EQ(expected.size(), static_cast<std::size_t>(tree->Total()));
+}
+
+// Micro-benchmark comparing the single sweep union with the batched union on
+// the synthetic copper layer. The timings are reported as test properties
+// (e.g. with --gtest_output=xml) and are not checked since they depend on the
+// machine, only the results of both implementations are.
+TEST_F(ClipperHelpersTest, testUniteBatchedCopperLayerBenchmark) {
+  const QVector<ClipperLib::Paths> areas = createCopperLayer();
+  const int runs = 3;
+
+  ClipperLib::Paths expected;
+  const qint64 singleSweepNs =
+      measureNs(runs, [&]() { expected = uniteSingleSweep(areas); });
+  ClipperLib::Paths result;
+  const qint64 batchedNs = measureNs(runs, [&]() {
+    result = ClipperHelpers::uniteBatched(areas, ClipperLib::pftNonZero);
+  });
+
+  RecordProperty("areas", static_cast<int>(areas.count()));
+  RecordProperty("single_sweep_us", static_cast<int>(singleSweepNs / 1000));
+  RecordProperty("batched_us", static_cast<int>(batchedNs / 1000));
+  std::cout << "[ BENCHMARK] single sweep: " << (singleSweepNs / 1000)
+            << " us, batched: " << (batchedNs / 1000) << " us ("
+            << QThreadPool::globalInstance()->maxThreadCount() << " threads)"
+            << std::endl;
+  EXPECT_EQ(expected.size(), result.size());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,107 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/core/exceptions.h>
+#include <librepcb/core/utils/concurrentcache.h>
+
+#include <QtConcurrent>
+#include <QtCore>
+
+#include <atomic>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ConcurrentCacheTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ConcurrentCacheTest, testCreatesValueOnlyOnce) {
+  ConcurrentCache<QString, int> cache;
+  int calls = 0;
+  auto create = [&calls]() { return ++calls; };
+  EXPECT_EQ(1, cache.get("a", create));
+  EXPECT_EQ(1, cache.get("a", create));
+  EXPECT_EQ(2, cache.get("b", create));
+  EXPECT_EQ(2, calls);
+  EXPECT_EQ(2, cache.count());
+}
+
+TEST_F(ConcurrentCacheTest, testClear) {
+  ConcurrentCache<QString, int> cache;
+  int calls = 0;
+  auto create = [&calls]() { return ++calls; };
+  EXPECT_EQ(1, cache.get("a", create));
+  cache.clear();
+  EXPECT_EQ(0, cache.count());
+  EXPECT_EQ(2, cache.get("a", create));
+}
+
+TEST_F(ConcurrentCacheTest, testExceptionIsCachedAndRethrown) {
+  ConcurrentCache<int, int> cache;
+  int calls = 0;
+  auto create = [&calls]() -> int {
+    ++calls;
+    throw RuntimeError(__FILE__, __LINE__, "Failed!");
+  };
+  EXPECT_THROW(cache.get(1, create), RuntimeError);
+  EXPECT_THROW(cache.get(1, create), RuntimeError);
+  EXPECT_EQ(1, calls);
+}
+
+TEST_F(ConcurrentCacheTest, testConcurrentAccess) {
+  ConcurrentCache<int, int> cache;
+  std::atomic_int calls(0);
+  auto create = [&calls]() {
+    ++calls;
+    QThread::msleep(10);  // Give other threads the chance to collide.
+    return 42;
+  };
+  QThreadPool pool;
+  pool.setMaxThreadCount(8);
+  QList<QFuture<int>> futures;
+  for (int i = 0; i < 32; ++i) {
+    futures.append(QtConcurrent::run(
+        &pool, [&cache, &create, i]() { return cache.get(i % 4, create); }));
+  }
+  for (QFuture<int>& future : futures) {
+    EXPECT_EQ(42, future.result());
+  }
+  EXPECT_EQ(4, calls);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
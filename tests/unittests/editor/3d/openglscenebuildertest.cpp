@@ -0,0 +1,321 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/core/3d/scenedata3d.h>
+#include <librepcb/core/3d/stepmeshcache.h>
+#include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/geometry/path.h>
+#include <librepcb/core/types/layer.h>
+#include <librepcb/core/utils/transform.h>
+#include <librepcb/editor/3d/openglscenebuilder.h>
+#include <librepcb/editor/3d/opengltriangleobject.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Class RecordingTriangleObject
+ ******************************************************************************/
+
+/**
+ * @brief Triangle object keeping a copy of the data published to it
+ */
+class RecordingTriangleObject final : public OpenGlTriangleObject {
+public:
+  QColor getColor() const noexcept {
+    QMutexLocker lock(&mMutex);
+    return mColor;
+  }
+  QVector<QVector3D> getTriangles() const noexcept {
+    QMutexLocker lock(&mMutex);
+    return mTriangles;
+  }
+  QVector<QMatrix4x4> getInstances() const noexcept {
+    QMutexLocker lock(&mMutex);
+    return mInstances;
+  }
+
+  void setData(const QColor& color,
+               const QVector<QVector3D>& data) noexcept override {
+    OpenGlTriangleObject::setData(color, data);
+    QMutexLocker lock(&mMutex);
+    mColor = color;
+    mTriangles = data;
+  }
+  void setColor(const QColor& color) noexcept override {
+    OpenGlTriangleObject::setColor(color);
+    QMutexLocker lock(&mMutex);
+    mColor = color;
+  }
+  void setInstances(const QVector<QMatrix4x4>& instances) noexcept override {
+    OpenGlTriangleObject::setInstances(instances);
+    QMutexLocker lock(&mMutex);
+    mInstances = instances;
+  }
+
+private:
+  mutable QMutex mMutex;
+  QColor mColor = Qt::black;
+  QVector<QVector3D> mTriangles;
+  QVector<QMatrix4x4> mInstances = {QMatrix4x4()};
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class OpenGlSceneBuilderTest : public ::testing::Test {
+protected:
+  FilePath mTmpDir;
+  FilePath mMeshCacheDir;
+  QList<QByteArray> mStepContents;
+
+  OpenGlSceneBuilderTest()
+    : mTmpDir(FilePath::getRandomTempPath()),
+      mMeshCacheDir(mTmpDir.getPathTo("meshes")) {}
+
+  virtual ~OpenGlSceneBuilderTest() {
+    QDir(mTmpDir.toStr()).removeRecursively();
+  }
+
+  /**
+   * @brief Create a mesh with two colors, unique for each model index
+   */
+  static StepMeshCache::Mesh createMesh(int index) {
+    StepMeshCache::Mesh mesh;
+    for (int c = 0; c < 2; ++c) {
+      QVector<QVector3D> vertices;
+      for (int i = 0; i < 30; ++i) {
+        vertices.append(QVector3D(index + i, c - i, 0.1 * (index + c)));
+      }
+      mesh[std::make_tuple(0.1 * c, 0.5, 0.01 * index)] = vertices;
+    }
+    return mesh;
+  }
+
+  /**
+   * @brief Create scene data with many devices sharing a few models
+   *
+   * The meshes of the models are put into the mesh cache, thus loading them
+   * does not require OpenCascade.
+   */
+  std::shared_ptr<SceneData3D> createSceneData(int modelCount,
+                                               int deviceCount) {
+    const FilePath dir = mTmpDir.getPathTo("models");
+    const StepMeshCache cache(mMeshCacheDir);
+    for (int i = 0; i < modelCount; ++i) {
+      const QByteArray content = "model " % QByteArray::number(i);
+      FileUtils::writeFile(dir.getPathTo(QString("%1.step").arg(i)), content);
+      cache.store(StepMeshCache::calcKey(content), createMesh(i));
+      mStepContents.append(content);
+    }
+    auto data = std::make_shared<SceneData3D>(
+        TransactionalFileSystem::openRO(dir));
+    data->addArea(Layer::boardOutlines(),
+                  Path::rect(Point(0, 0), Point(100000000, 80000000)),
+                  Transform());
+    for (int i = 0; i < deviceCount; ++i) {
+      data->addDevice(Uuid::createRandom(),
+                      Transform(Point(1000000 * i, 2000000 * (i % 7)),
+                                Angle::deg90() * (i % 4), (i % 3) == 0),
+                      QString("%1.step").arg(i % modelCount),
+                      Point3D(Length(100000 * i), Length(0), Length(50000)),
+                      Angle3D(Angle::deg90() * (i % 2), Angle(), Angle()),
+                      QString("U%1").arg(i));
+    }
+    return data;
+  }
+
+  /**
+   * @brief Build the scene and return all objects added to it
+   */
+  static QList<std::shared_ptr<RecordingTriangleObject>> build(
+      OpenGlSceneBuilder& builder, std::shared_ptr<SceneData3D> data) {
+    QList<std::shared_ptr<RecordingTriangleObject>> objects;
+    const QMetaObject::Connection connection = QObject::connect(
+        &builder, &OpenGlSceneBuilder::objectAdded,
+        [&objects](std::shared_ptr<OpenGlObject> obj) {
+          objects.append(
+              std::dynamic_pointer_cast<RecordingTriangleObject>(obj));
+        });
+    builder.setTriangleObjectFactory(
+        []() { return std::make_shared<RecordingTriangleObject>(); });
+    builder.start(data);
+    builder.waitForFinished();
+    QObject::disconnect(connection);
+    return objects;
+  }
+
+  /**
+   * @brief Transform the vertices of a device model like before instancing
+   *
+   * Each device used to get its own copy of the model vertices, transformed
+   * by the device placement on the CPU.
+   */
+  static QVector<QVector3D> bakeDevice(const SceneData3D::DeviceData& dev,
+                                       const QVector<QVector3D>& vertices,
+                                       qreal z, qreal scaleFactor) {
+    QMatrix4x4 m;
+    m.scale(scaleFactor);
+    m.translate(dev.transform.getPosition().getX().toMm(),
+                dev.transform.getPosition().getY().toMm(),
+                dev.transform.getMirrored() ? -z : z);
+    m.rotate(dev.transform.getRotation().toDeg(), 0, 0, 1);
+    if (dev.transform.getMirrored()) {
+      m.rotate(180, 0, 1, 0);
+    }
+    m.translate(std::get<0>(dev.stepPosition).toMm(),
+                std::get<1>(dev.stepPosition).toMm(),
+                std::get<2>(dev.stepPosition).toMm());
+    m.rotate(std::get<2>(dev.stepRotation).toDeg(), 0, 0, 1);
+    m.rotate(std::get<1>(dev.stepRotation).toDeg(), 0, 1, 0);
+    m.rotate(std::get<0>(dev.stepRotation).toDeg(), 1, 0, 0);
+    QVector<QVector3D> result = vertices;
+    for (QVector3D& vertex : result) {
+      vertex = m.map(vertex);
+    }
+    return result;
+  }
+
+  /**
+   * @brief Find the object containing the given triangles
+   */
+  static std::shared_ptr<RecordingTriangleObject> findObject(
+      const QList<std::shared_ptr<RecordingTriangleObject>>& objects,
+      const QVector<QVector3D>& triangles) {
+    std::shared_ptr<RecordingTriangleObject> result;
+    for (const auto& obj : objects) {
+      if (obj && (obj->getTriangles() == triangles)) {
+        EXPECT_FALSE(result) << "Object found multiple times.";
+        result = obj;
+      }
+    }
+    return result;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+// Models are loaded concurrently, the result must be the same as loading them
+// one after another from the mesh cache.
+TEST_F(OpenGlSceneBuilderTest, testParallelLoadingMatchesSerial) {
+  const int modelCount = 12;
+  const int deviceCount = 60;
+  std::shared_ptr<SceneData3D> data = createSceneData(modelCount, deviceCount);
+  auto dataCopy = std::make_shared<SceneData3D>(*data);
+  OpenGlSceneBuilder builder(mMeshCacheDir);
+  const QList<std::shared_ptr<RecordingTriangleObject>> objects =
+      build(builder, data);
+
+  // Serial reference.
+  const StepMeshCache cache(mMeshCacheDir);
+  int modelObjectCount = 0;
+  for (int i = 0; i < modelCount; ++i) {
+    const std::optional<StepMeshCache::Mesh> mesh =
+        cache.load(StepMeshCache::calcKey(mStepContents.at(i)));
+    ASSERT_TRUE(mesh.has_value());
+    EXPECT_EQ(createMesh(i), *mesh);
+    for (auto it = mesh->begin(); it != mesh->end(); it++) {
+      std::shared_ptr<RecordingTriangleObject> obj = findObject(objects, *it);
+      ASSERT_TRUE(obj) << "Model " << i << " not published.";
+      const QColor color = obj->getColor();
+      EXPECT_NEAR(std::get<0>(it.key()), color.redF(), 1e-3);
+      EXPECT_NEAR(std::get<1>(it.key()), color.greenF(), 1e-3);
+      EXPECT_NEAR(std::get<2>(it.key()), color.blueF(), 1e-3);
+      // Devices are assigned round-robin to the models.
+      EXPECT_EQ(deviceCount / modelCount, obj->getInstances().count());
+      ++modelObjectCount;
+    }
+  }
+
+  // Besides the models, only the board layers must have been published.
+  const int boardObjectCount = objects.count() - modelObjectCount;
+  EXPECT_EQ(2 * modelCount, modelObjectCount);
+  EXPECT_EQ(3 + 2 * 4, boardObjectCount);
+
+  // Rebuilding the same scene reuses the already loaded models and must not
+  // add any new model objects.
+  const QList<std::shared_ptr<RecordingTriangleObject>> added =
+      build(builder, dataCopy);
+  EXPECT_EQ(0, added.count());
+}
+
+// Drawing the shared model once per instance must result in the same vertices
+// as the previous per-device copies with baked-in transformation.
+TEST_F(OpenGlSceneBuilderTest, testInstancesMatchBakedDevices) {
+  const int modelCount = 3;
+  const int deviceCount = 24;
+  std::shared_ptr<SceneData3D> data = createSceneData(modelCount, deviceCount);
+  OpenGlSceneBuilder builder(mMeshCacheDir);
+  const QList<std::shared_ptr<RecordingTriangleObject>> objects =
+      build(builder, data);
+
+  // The builder centers the data in place. The board is 100x80mm and 1.6mm
+  // thick, thus all coordinates are scaled by 1/100 and the devices are
+  // placed 0.067mm above the board surface.
+  const qreal scaleFactor = 0.01;
+  const qreal z = data->getThickness()->toMm() / 2 + 0.067;
+  for (int i = 0; i < modelCount; ++i) {
+    QList<const SceneData3D::DeviceData*> devices;
+    for (int k = i; k < deviceCount; k += modelCount) {
+      devices.append(&data->getDevices().at(k));
+    }
+    const StepMeshCache::Mesh mesh = createMesh(i);
+    for (const QVector<QVector3D>& vertices : mesh) {
+      std::shared_ptr<RecordingTriangleObject> obj =
+          findObject(objects, vertices);
+      ASSERT_TRUE(obj);
+      const QVector<QMatrix4x4> instances = obj->getInstances();
+      ASSERT_EQ(devices.count(), instances.count());
+      for (int k = 0; k < devices.count(); ++k) {
+        const QVector<QVector3D> expected =
+            bakeDevice(*devices.at(k), vertices, z, scaleFactor);
+        for (int v = 0; v < vertices.count(); ++v) {
+          const QVector3D actual = instances.at(k).map(vertices.at(v));
+          EXPECT_NEAR(expected.at(v).x(), actual.x(), 1e-5);
+          EXPECT_NEAR(expected.at(v).y(), actual.y(), 1e-5);
+          EXPECT_NEAR(expected.at(v).z(), actual.z(), 1e-5);
+        }
+      }
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,171 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/editor/graphics/graphicsscene.h>
+#include <librepcb/editor/graphics/graphicstilecache.h>
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsTileCacheTest : public ::testing::Test {
+protected:
+  static QGraphicsRectItem* addRect(GraphicsScene& scene, const QRectF& rect,
+                                    qreal zValue) noexcept {
+    QGraphicsRectItem* item = new QGraphicsRectItem(rect);
+    item->setPen(Qt::NoPen);
+    item->setBrush(Qt::red);
+    item->setZValue(zValue);
+    item->setFlag(QGraphicsItem::ItemIsSelectable, true);
+    scene.addItem(*item);
+    return item;
+  }
+
+  static QImage paint(GraphicsTileCache& cache, const GraphicsScene& scene) {
+    QImage image(512, 512, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    cache.paint(painter, scene, QTransform(), image.rect());
+    return image;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsTileCacheTest, testSupportedTransforms) {
+  EXPECT_TRUE(GraphicsTileCache::isSupportedTransform(QTransform()));
+  EXPECT_TRUE(GraphicsTileCache::isSupportedTransform(
+      QTransform(2.5, 0, 0, 2.5, -100, 42)));
+  EXPECT_FALSE(GraphicsTileCache::isSupportedTransform(
+      QTransform(2.5, 0, 0, 2.5, -100.5, 42)));
+  EXPECT_FALSE(GraphicsTileCache::isSupportedTransform(
+      QTransform(1, 0, 0, 2, 0, 0)));
+  EXPECT_FALSE(GraphicsTileCache::isSupportedTransform(
+      QTransform(-1, 0, 0, -1, 0, 0)));
+  EXPECT_FALSE(GraphicsTileCache::isSupportedTransform(
+      QTransform().rotate(45)));
+}
+
+TEST_F(GraphicsTileCacheTest, testPaintCacheableItems) {
+  GraphicsScene scene;
+  scene.setLiveZValue(10);
+  addRect(scene, QRectF(10, 10, 100, 100), 1);
+  addRect(scene, QRectF(300, 300, 100, 100), 10);  // Live item.
+
+  GraphicsTileCache cache;
+  const QImage image = paint(cache, scene);
+  EXPECT_EQ(QColor(Qt::red).rgba(), image.pixel(50, 50));
+  EXPECT_EQ(0, qAlpha(image.pixel(350, 350)));
+  EXPECT_EQ(4, cache.getTileCount());
+}
+
+TEST_F(GraphicsTileCacheTest, testNothingCacheableWithoutLiveZValue) {
+  GraphicsScene scene;
+  addRect(scene, QRectF(10, 10, 100, 100), 1);
+
+  GraphicsTileCache cache;
+  const QImage image = paint(cache, scene);
+  EXPECT_EQ(0, qAlpha(image.pixel(50, 50)));
+}
+
+TEST_F(GraphicsTileCacheTest, testInvalidateOnlyTouchedTiles) {
+  GraphicsScene scene;
+  scene.setLiveZValue(10);
+  QGraphicsRectItem* item = addRect(scene, QRectF(10, 10, 100, 100), 1);
+
+  GraphicsTileCache cache;
+  paint(cache, scene);
+  EXPECT_EQ(4, cache.getTileCount());
+
+  cache.invalidate({QRectF(20, 20, 10, 10)});
+  EXPECT_EQ(3, cache.getTileCount());
+
+  // Tiles are rendered again, with the updated content.
+  item->setBrush(Qt::blue);
+  const QImage image = paint(cache, scene);
+  EXPECT_EQ(QColor(Qt::blue).rgba(), image.pixel(50, 50));
+  EXPECT_EQ(4, cache.getTileCount());
+
+  cache.clear();
+  EXPECT_EQ(0, cache.getTileCount());
+}
+
+TEST_F(GraphicsTileCacheTest, testSelectedItemsAreLive) {
+  GraphicsScene scene;
+  scene.setLiveZValue(10);
+  QGraphicsRectItem* cached = addRect(scene, QRectF(10, 10, 100, 100), 1);
+  QGraphicsRectItem* live = addRect(scene, QRectF(300, 300, 100, 100), 20);
+  EXPECT_TRUE(scene.isCacheable(*cached));
+  EXPECT_FALSE(scene.isCacheable(*live));
+  // Note: The (empty) selection rect might be contained too.
+  QList<QGraphicsItem*> items = scene.getLiveItems(QRectF(0, 0, 512, 512));
+  EXPECT_TRUE(items.contains(live));
+  EXPECT_FALSE(items.contains(cached));
+
+  cached->setSelected(true);
+  EXPECT_FALSE(scene.isCacheable(*cached));
+  items = scene.getLiveItems(QRectF(0, 0, 512, 512));
+  EXPECT_TRUE(items.contains(cached));
+  EXPECT_LT(items.indexOf(cached), items.indexOf(live));  // Stacking order.
+}
+
+TEST_F(GraphicsTileCacheTest, testLiveItemsAreTracked) {
+  GraphicsScene scene;
+  scene.setLiveZValue(10);
+  QGraphicsRectItem* live = addRect(scene, QRectF(300, 300, 100, 100), 20);
+  EXPECT_TRUE(scene.getLiveItems(QRectF(0, 0, 512, 512)).contains(live));
+  EXPECT_FALSE(scene.getLiveItems(QRectF(0, 0, 100, 100)).contains(live));
+
+  scene.removeItem(*live);
+  EXPECT_FALSE(scene.getLiveItems(QRectF(0, 0, 512, 512)).contains(live));
+  delete live;
+
+  // Items added before the live Z value was set are tracked too.
+  GraphicsScene scene2;
+  live = addRect(scene2, QRectF(300, 300, 100, 100), 20);
+  scene2.setLiveZValue(10);
+  EXPECT_FALSE(scene2.isCacheable(*live));
+  EXPECT_TRUE(scene2.getLiveItems(QRectF(0, 0, 512, 512)).contains(live));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/editor/graphics/lodpainterpath.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class LodPainterPathTest : public ::testing::Test {
+protected:
+  static QPainterPath createCircle(qreal radius, int points) noexcept {
+    QPolygonF polygon;
+    for (int i = 0; i <= points; ++i) {
+      const qreal angle = (2 * M_PI * i) / points;
+      polygon.append(
+          QPointF(radius * std::cos(angle), radius * std::sin(angle)));
+    }
+    QPainterPath path;
+    path.addPolygon(polygon);
+    return path;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(LodPainterPathTest, testOriginalPathAtFullZoom) {
+  const LodPainterPath path(createCircle(100, 1000));
+  EXPECT_EQ(&path.getPath(), &path.getPath(1));
+  EXPECT_EQ(&path.getPath(), &path.getPath(5));
+}
+
+TEST_F(LodPainterPathTest, testSmallPathIsNotSimplified) {
+  const LodPainterPath path(createCircle(100, 20));
+  EXPECT_EQ(&path.getPath(), &path.getPath(0.01));
+}
+
+TEST_F(LodPainterPathTest, testSimplifiedPathAtLowZoom) {
+  const LodPainterPath path(createCircle(100, 1000));
+  const QPainterPath& simplified = path.getPath(0.1);
+  EXPECT_LT(simplified.elementCount(), 100);
+  EXPECT_GT(simplified.elementCount(), 4);
+
+  // The deviation must be below half a device pixel, i.e. 5 scene pixels.
+  const QRectF rect = simplified.boundingRect();
+  const QRectF expected = path.getBoundingRect();
+  EXPECT_NEAR(expected.left(), rect.left(), 5);
+  EXPECT_NEAR(expected.top(), rect.top(), 5);
+  EXPECT_NEAR(expected.right(), rect.right(), 5);
+  EXPECT_NEAR(expected.bottom(), rect.bottom(), 5);
+
+  // First and last point are kept to keep the path closed.
+  EXPECT_EQ(simplified.elementAt(0).x,
+            simplified.elementAt(simplified.elementCount() - 1).x);
+  EXPECT_EQ(simplified.elementAt(0).y,
+            simplified.elementAt(simplified.elementCount() - 1).y);
+}
+
+TEST_F(LodPainterPathTest, testSimplifiedPathIsCachedPerLevel) {
+  const LodPainterPath path(createCircle(100, 1000));
+  EXPECT_EQ(&path.getPath(0.1), &path.getPath(0.09));
+  EXPECT_NE(&path.getPath(0.1), &path.getPath(0.01));
+  EXPECT_LT(path.getPath(0.01).elementCount(),
+            path.getPath(0.1).elementCount());
+}
+
+TEST_F(LodPainterPathTest, testFarLevelsAreRebuiltAfterRelease) {
+  const LodPainterPath path(createCircle(100, 1000));
+  const QPainterPath expected = path.getPath(0.1);
+  path.getPath(0.0001);  // Releases the level of 0.1.
+  EXPECT_EQ(expected, path.getPath(0.1));
+}
+
+TEST_F(LodPainterPathTest, testIsTiny) {
+  EXPECT_TRUE(LodPainterPath::isTiny(QRectF(0, 0, 10, 10), 0.1));
+  EXPECT_FALSE(LodPainterPath::isTiny(QRectF(0, 0, 10, 20), 0.1));
+  EXPECT_FALSE(LodPainterPath::isTiny(QRectF(0, 0, 10, 10), 1));
+}
+
+TEST_F(LodPainterPathTest, testSetPathClearsCache) {
+  LodPainterPath path(createCircle(100, 1000));
+  const int count = path.getPath(0.1).elementCount();
+  path.setPath(createCircle(1000, 1000));
+  EXPECT_GT(path.getPath(0.1).elementCount(), count);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -0,0 +1,139 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/editor/graphics/shapecache.h>
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace editor {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ShapeCacheTest : public ::testing::Test {
+protected:
+  ShapeCacheTest() : mItem(QRectF(0, 0, 10, 10)), mBuildCount(0) {}
+
+  ShapeCache::Builder createBuilder() noexcept {
+    return [this]() {
+      ++mBuildCount;
+      QPainterPath path;
+      path.addRect(mItem.rect());
+      return path;
+    };
+  }
+
+  QGraphicsRectItem mItem;
+  int mBuildCount;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ShapeCacheTest, testShapeIsBuiltLazilyOnce) {
+  ShapeCache cache(mItem, createBuilder());
+  EXPECT_EQ(0, mBuildCount);
+  EXPECT_EQ(QRectF(0, 0, 10, 10), cache.getShape().boundingRect());
+  EXPECT_EQ(QRectF(0, 0, 10, 10), cache.getSceneShape().boundingRect());
+  EXPECT_EQ(QRectF(0, 0, 10, 10), cache.getSceneBoundingRect());
+  EXPECT_EQ(1, mBuildCount);
+}
+
+TEST_F(ShapeCacheTest, testInvalidate) {
+  ShapeCache cache(mItem, createBuilder());
+  cache.getSceneShape();
+  const quint64 revision = cache.getRevision();
+
+  mItem.setRect(QRectF(0, 0, 20, 20));
+  cache.invalidate();
+  EXPECT_EQ(revision + 1, cache.getRevision());
+  EXPECT_EQ(QRectF(0, 0, 20, 20), cache.getSceneBoundingRect());
+  EXPECT_EQ(2, mBuildCount);
+}
+
+TEST_F(ShapeCacheTest, testSceneShapeFollowsTransform) {
+  ShapeCache cache(mItem, createBuilder());
+  cache.getSceneShape();
+
+  mItem.setPos(100, 50);
+  EXPECT_EQ(QRectF(100, 50, 10, 10), cache.getSceneBoundingRect());
+  mItem.setRotation(90);
+  const QRectF rect = cache.getSceneBoundingRect();
+  EXPECT_NEAR(90, rect.left(), 1e-9);
+  EXPECT_NEAR(50, rect.top(), 1e-9);
+  EXPECT_NEAR(10, rect.width(), 1e-9);
+  EXPECT_NEAR(10, rect.height(), 1e-9);
+  EXPECT_EQ(QRectF(0, 0, 10, 10), cache.getShape().boundingRect());
+  EXPECT_EQ(1, mBuildCount);  // Local shape not rebuilt.
+}
+
+TEST_F(ShapeCacheTest, testIntersects) {
+  ShapeCache cache(mItem, createBuilder());
+  mItem.setPos(100, 100);
+  EXPECT_TRUE(cache.intersects(QRectF(105, 105, 1, 1)));  // Inside.
+  EXPECT_TRUE(cache.intersects(QRectF(90, 90, 50, 50)));  // Enclosing.
+  EXPECT_TRUE(cache.intersects(QRectF(108, 108, 10, 10)));  // Overlapping.
+  EXPECT_TRUE(cache.intersects(QRectF(105, 105, 0, 0)));  // Zero-sized.
+  EXPECT_FALSE(cache.intersects(QRectF(0, 0, 10, 10)));  // Far away.
+}
+
+TEST_F(ShapeCacheTest, testContains) {
+  ShapeCache cache(mItem, createBuilder());
+  mItem.setPos(100, 100);
+  EXPECT_TRUE(cache.contains(QPointF(105, 105)));
+  EXPECT_FALSE(cache.contains(QPointF(5, 5)));
+}
+
+TEST_F(ShapeCacheTest, testEmptyShapeNeverIntersects) {
+  ShapeCache cache(mItem, []() { return QPainterPath(); });
+  EXPECT_FALSE(cache.intersects(QRectF(-100, -100, 200, 200)));
+  EXPECT_FALSE(cache.contains(QPointF(0, 0)));
+}
+
+TEST_F(ShapeCacheTest, testCalcSceneBoundsIncludesChildren) {
+  QGraphicsItemGroup group;
+  QGraphicsRectItem* child = new QGraphicsRectItem(QRectF(0, 0, 10, 10));
+  child->setPen(Qt::NoPen);
+  child->setParentItem(&group);  // Not added with addToGroup()!
+  group.setPos(100, 100);
+  EXPECT_TRUE(group.sceneBoundingRect().isEmpty());
+  EXPECT_EQ(QRectF(100, 100, 10, 10), ShapeCache::calcSceneBounds(group));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace editor
+}  // namespace librepcb
@@ -22,9 +22,15 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 #include <librepcb/core/fileio/fileutils.h>
+#include <librepcb/core/fileio/transactionaldirectory.h>
+#include <librepcb/core/fileio/transactionalfilesystem.h>
+#include <librepcb/core/library/pkg/package.h>
+#include <librepcb/core/serialization/sexpression.h>
 #include <librepcb/core/utils/messagelogger.h>
 #include <librepcb/core/workspace/workspacelibrarydb.h>
+#include <librepcb/kicadimport/kicadlibraryconverter.h>
 #include <librepcb/kicadimport/kicadlibraryimport.h>
+#include <librepcb/kicadimport/kicadtypes.h>
 
 #include <QtCore>
 
@@ -52,6 +58,42 @@ protected:
   virtual ~KiCadLibraryImportTest() {
     QDir(mWsDir.toStr()).removeRecursively();
   }
+
+  /**
+   * @brief Read all package files of a library, keyed by "generated_by"
+   *
+   * Random UUIDs and creation timestamps are replaced by placeholders to
+   * make the content comparable between independent imports.
+   */
+  static QMap<QString, QString> readPackages(const FilePath& libDir) {
+    QMap<QString, QString> packages;
+    const QList<FilePath> files = FileUtils::getFilesInDirectory(
+        libDir.getPathTo("pkg"), {"package.lp"}, true);
+    for (const FilePath& fp : files) {
+      QString content = QString::fromUtf8(FileUtils::readFile(fp));
+      const QString generatedBy =
+          QRegularExpression("\\(generated_by \"([^\"]*)\"\\)")
+              .match(content)
+              .captured(1);
+      content.replace(QRegularExpression("\\(created [^)]*\\)"),
+                      "(created)");
+      QRegularExpression uuidRegex(
+          "[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}");
+      QStringList uuids;
+      QRegularExpressionMatchIterator it = uuidRegex.globalMatch(content);
+      while (it.hasNext()) {
+        const QString uuid = it.next().captured();
+        if (!uuids.contains(uuid)) {
+          uuids.append(uuid);
+        }
+      }
+      for (int i = 0; i < uuids.count(); ++i) {
+        content.replace(uuids.at(i), QString("uuid-%1").arg(i));
+      }
+      packages.insert(generatedBy, content);
+    }
+    return packages;
+  }
 };
 
 /*******************************************************************************
@@ -120,6 +162,70 @@ TEST_F(KiCadLibraryImportTest, testImport) {
   EXPECT_EQ(6, dstFiles.count());
 }
 
+TEST_F(KiCadLibraryImportTest, testParallelImportMatchesSerial) {
+  const FilePath src(TEST_DATA_DIR "/unittests/kicadimport");
+  const QList<FilePath> srcFiles =
+      FileUtils::getFilesInDirectory(src, {"*.kicad_mod"}, true);
+  ASSERT_GE(srcFiles.count(), 1);
+
+  // Create a library with enough footprints to keep all threads busy.
+  const FilePath tmpDir = FilePath::getRandomTempPath();
+  const FilePath kicadLibDir = tmpDir.getPathTo("Synthetic.pretty");
+  const FilePath dstParallel = tmpDir.getPathTo("parallel");
+  const FilePath dstSerial = tmpDir.getPathTo("serial");
+  const QByteArray srcContent = FileUtils::readFile(srcFiles.first());
+  QList<FilePath> footprintFiles;
+  for (int i = 0; i < 32; ++i) {
+    const FilePath fp =
+        kicadLibDir.getPathTo(QString("Footprint%1.kicad_mod").arg(i));
+    FileUtils::writeFile(fp, srcContent);
+    footprintFiles.append(fp);
+  }
+
+  // Import in parallel.
+  {
+    KiCadLibraryImport import(*mWsDb, dstParallel);
+    std::shared_ptr<MessageLogger> log = std::make_shared<MessageLogger>();
+    ASSERT_TRUE(import.startScan(kicadLibDir, FilePath(), log));
+    import.getResult();
+    ASSERT_TRUE(import.startParse(log));
+    import.getResult();
+    ASSERT_TRUE(import.startImport(log));
+    import.getResult();
+  }
+
+  // Convert serially as a reference.
+  {
+    KiCadLibraryConverterSettings settings;
+    KiCadLibraryConverter converter(*mWsDb, settings);
+    MessageLogger log;
+    for (const FilePath& fp : footprintFiles) {
+      std::unique_ptr<SExpression> root = SExpression::parse(
+          FileUtils::readFile(fp), fp, SExpression::Mode::Permissive);
+      const KiCadFootprint kiFpt = KiCadFootprint::parse(*root, log);
+      const QString generatedBy =
+          "KiCadImport::Synthetic::" % fp.getCompleteBasename();
+      std::unique_ptr<Package> pkg = converter.createPackage(
+          kicadLibDir, kiFpt, generatedBy, QMap<QString, FilePath>(), log);
+      TransactionalDirectory dir(TransactionalFileSystem::openRW(
+          dstSerial.getPathTo("pkg").getPathTo(pkg->getUuid().toStr())));
+      pkg->saveTo(dir);
+      dir.getFileSystem()->save();
+    }
+  }
+
+  const QMap<QString, QString> parallel = readPackages(dstParallel);
+  const QMap<QString, QString> serial = readPackages(dstSerial);
+  QDir(tmpDir.toStr()).removeRecursively();
+  EXPECT_EQ(footprintFiles.count(), serial.count());
+  EXPECT_EQ(serial.keys(), parallel.keys());
+  for (auto it = serial.begin(); it != serial.end(); ++it) {
+    EXPECT_EQ(it.value().toStdString(),
+              parallel.value(it.key()).toStdString())
+        << qPrintable(it.key());
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/